@@ -0,0 +1,171 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "common.hpp"
+#include "options.hpp"
+
+#include <spla.hpp>
+
+
+void unpack_rows(const spla::ref_ptr<spla::Matrix>& M, std::vector<std::vector<int>>& rows) {
+    spla::ref_ptr<spla::MemView> keys1, keys2, values;
+    M->read(keys1, keys2, values);
+
+    const auto  n_values = values->get_size() / sizeof(int);
+    const auto* Mi       = static_cast<const spla::uint*>(keys1->get_buffer());
+    const auto* Mj       = static_cast<const spla::uint*>(keys2->get_buffer());
+    const auto* Mx       = static_cast<const int*>(values->get_buffer());
+
+    for (std::size_t k = 0; k < n_values; ++k) {
+        rows[Mi[k]][Mj[k]] = Mx[k];
+    }
+}
+
+int main(int argc, const char* const* argv) {
+    std::shared_ptr<cxxopts::Options> options = make_options("ms_bfs", "ms_bfs (multi-source breadth first search) algorithm with spla library");
+    cxxopts::ParseResult              args;
+    int                               ret;
+
+    if (parse_options(argc, argv, options, args, ret)) {
+        std::cerr << "failed to parse options";
+        return ret;
+    }
+
+    spla::Timer     timer;
+    spla::Timer     timer_cpu;
+    spla::Timer     timer_gpu;
+    spla::Timer     timer_ref;
+    spla::MtxLoader loader;
+
+    timer.start();
+
+    if (!loader.load(args[OPT_MTXPATH].as<std::string>())) {
+        std::cerr << "failed to load graph";
+        return 1;
+    }
+
+    std::string acc_info;
+
+    spla::Library* library = spla::Library::get();
+    library->set_platform(args[OPT_PLATFORM].as<int>());
+    library->set_device(args[OPT_DEVICE].as<int>());
+    library->set_queues_count(1);
+    library->get_accelerator_info(acc_info);
+    std::cout << "env: " << acc_info << std::endl;
+
+    const spla::uint                N     = loader.get_n_rows();
+    const spla::uint                s     = args[OPT_SOURCE].as<int>();
+    const spla::uint                K     = std::min(spla::uint(args[OPT_N_SOURCES].as<int>()), N);
+    spla::ref_ptr<spla::Matrix>     L_cpu = spla::Matrix::make(K, N, spla::INT);
+    spla::ref_ptr<spla::Matrix>     L_acc = spla::Matrix::make(K, N, spla::INT);
+    spla::ref_ptr<spla::Matrix>     A     = spla::Matrix::make(N, N, spla::INT);
+    spla::ref_ptr<spla::Descriptor> desc  = spla::Descriptor::make();
+
+    desc->set_front_factor(args[OPT_FRONT_FACTOR].as<float>());
+
+    // sources are spread evenly over vertices starting from given one
+    std::vector<spla::uint> sources(K);
+    for (spla::uint i = 0; i < K; ++i) {
+        sources[i] = spla::uint((s + std::uint64_t(i) * (N / K)) % N);
+    }
+
+    const auto& Ai = loader.get_Ai();
+    const auto& Aj = loader.get_Aj();
+
+    for (std::size_t k = 0; k < loader.get_n_values(); ++k) {
+        A->set_int(Ai[k], Aj[k], 1);
+    }
+
+    const int n_iters = args[OPT_NITERS].as<int>();
+
+    if (args[OPT_RUN_CPU].as<bool>()) {
+        library->set_force_no_acceleration(true);
+
+        for (int i = 0; i < n_iters; ++i) {
+            L_cpu->clear();
+
+            timer_cpu.lap_begin();
+            spla::ms_bfs(L_cpu, A, sources, desc);
+            timer_cpu.lap_end();
+        }
+    }
+
+    if (args[OPT_RUN_GPU].as<bool>()) {
+        library->set_force_no_acceleration(false);
+
+        for (int i = 0; i < n_iters; ++i) {
+            L_acc->clear();
+
+            timer_gpu.lap_begin();
+            spla::ms_bfs(L_acc, A, sources, desc);
+            timer_gpu.lap_end();
+        }
+    }
+
+    if (args[OPT_RUN_REF].as<bool>()) {
+        library->set_force_no_acceleration(true);
+
+        // reference is single-source bfs run from each source in turn
+        std::vector<spla::ref_ptr<spla::Vector>> ref_v(K);
+
+        timer_ref.lap_begin();
+        for (spla::uint i = 0; i < K; ++i) {
+            ref_v[i] = spla::Vector::make(N, spla::INT);
+            spla::bfs(ref_v[i], A, sources[i], desc);
+        }
+        timer_ref.lap_end();
+
+        std::vector<std::vector<int>> rows(K, std::vector<int>(N, 0));
+
+        if (args[OPT_RUN_CPU].as<bool>()) {
+            unpack_rows(L_cpu, rows);
+            for (spla::uint i = 0; i < K; ++i) verify_exact("cpu", ref_v[i], rows[i]);
+        }
+        if (args[OPT_RUN_GPU].as<bool>()) {
+            for (auto& row : rows) std::fill(row.begin(), row.end(), 0);
+            unpack_rows(L_acc, rows);
+            for (spla::uint i = 0; i < K; ++i) verify_exact("acc", ref_v[i], rows[i]);
+        }
+    }
+
+    spla::Library::get()->finalize();
+
+    timer.stop();
+
+    std::cout << "total(ms): " << timer.get_elapsed_ms() << std::endl;
+    std::cout << "cpu(ms): ";
+    timer_cpu.print();
+    std::cout << std::endl;
+    std::cout << "gpu(ms): ";
+    timer_gpu.print();
+    std::cout << std::endl;
+    std::cout << "ref(ms): ";
+    timer_ref.print();
+    std::cout << std::endl;
+
+    return 0;
+}
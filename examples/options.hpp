@@ -34,6 +34,7 @@
 #define OPT_MTXPATH      "mtxpath"
 #define OPT_NITERS       "niters"
 #define OPT_SOURCE       "source"
+#define OPT_N_SOURCES    "n-sources"
 #define OPT_RUN_REF      "run-ref"
 #define OPT_RUN_CPU      "run-cpu"
 #define OPT_RUN_GPU      "run-gpu"
@@ -43,6 +44,8 @@
 #define OPT_FRONT_FACTOR "front-factor"
 #define OPT_ALPHA        "alpha"
 #define OPT_EPS          "eps"
+#define OPT_DELTA        "delta"
+#define OPT_PR_DELTA     "pr-delta"
 
 std::shared_ptr<cxxopts::Options> make_options(const std::string& name, const std::string& desc) {
     std::shared_ptr<cxxopts::Options> options = std::make_shared<cxxopts::Options>(name, desc);
@@ -50,6 +53,7 @@ std::shared_ptr<cxxopts::Options> make_options(const std::string& name, const st
     options->add_option("", cxxopts::Option(OPT_MTXPATH, "path to matrix file", cxxopts::value<std::string>()));
     options->add_option("", cxxopts::Option(OPT_NITERS, "number of iterations to run", cxxopts::value<int>()->default_value("4")));
     options->add_option("", cxxopts::Option(OPT_SOURCE, "source vertex to run", cxxopts::value<int>()->default_value("0")));
+    options->add_option("", cxxopts::Option(OPT_N_SOURCES, "number of sources for multi-source algorithms", cxxopts::value<int>()->default_value("64")));
     options->add_option("", cxxopts::Option(OPT_RUN_REF, "check validity running naive version", cxxopts::value<bool>()->default_value("true")));
     options->add_option("", cxxopts::Option(OPT_RUN_CPU, "run algo with cpu backend", cxxopts::value<bool>()->default_value("true")));
     options->add_option("", cxxopts::Option(OPT_RUN_GPU, "run algo with gpu (acc) backend", cxxopts::value<bool>()->default_value("true")));
@@ -62,6 +66,8 @@ std::shared_ptr<cxxopts::Options> make_options(const std::string& name, const st
     options->add_option("", cxxopts::Option(OPT_FRONT_FACTOR, "adaptive push-pull front sparsity factor", cxxopts::value<float>()->default_value("0.05")));
     options->add_option("", cxxopts::Option(OPT_ALPHA, "alpha parameter for page rank algorithm", cxxopts::value<float>()->default_value("0.85")));
     options->add_option("", cxxopts::Option(OPT_EPS, "eps error for page rank algorithm", cxxopts::value<float>()->default_value("1e-6")));
+    options->add_option("", cxxopts::Option(OPT_DELTA, "bucket width for delta-stepping sssp (0 auto, <0 to use plain sssp)", cxxopts::value<float>()->default_value("-1")));
+    options->add_option("", cxxopts::Option(OPT_PR_DELTA, "delta page rank mode (0 power iterations, 1 residual push, 2 gauss-seidel sweeps)", cxxopts::value<int>()->default_value("0")));
     return options;
 }
 
@@ -63,12 +63,14 @@ int main(int argc, const char* const* argv) {
     library->get_accelerator_info(acc_info);
     std::cout << "env: " << acc_info << std::endl;
 
-    float alpha = args[OPT_ALPHA].as<float>();
-    float eps   = args[OPT_EPS].as<float>();
+    float alpha    = args[OPT_ALPHA].as<float>();
+    float eps      = args[OPT_EPS].as<float>();
+    int   pr_delta = args[OPT_PR_DELTA].as<int>();
 
     const spla::uint                N     = loader.get_n_rows();
     spla::ref_ptr<spla::Vector>     v_cpu = spla::Vector::make(N, spla::FLOAT);
     spla::ref_ptr<spla::Vector>     v_acc = spla::Vector::make(N, spla::FLOAT);
+    spla::ref_ptr<spla::Vector>     v_dlt = spla::Vector::make(N, spla::FLOAT);
     spla::ref_ptr<spla::Matrix>     A     = spla::Matrix::make(N, N, spla::FLOAT);
     spla::ref_ptr<spla::Descriptor> desc  = spla::Descriptor::make();
 
@@ -96,7 +98,11 @@ int main(int argc, const char* const* argv) {
             v_cpu->clear();
 
             timer_cpu.lap_begin();
-            spla::pr(v_cpu, A, alpha, eps, desc);
+            if (pr_delta > 0) {
+                spla::pr_delta(v_cpu, A, alpha, eps, pr_delta == 2, desc);
+            } else {
+                spla::pr(v_cpu, A, alpha, eps, desc);
+            }
             timer_cpu.lap_end();
         }
     }
@@ -108,7 +114,11 @@ int main(int argc, const char* const* argv) {
             v_acc->clear();
 
             timer_gpu.lap_begin();
-            spla::pr(v_acc, A, alpha, eps, desc);
+            if (pr_delta > 0) {
+                spla::pr_delta(v_acc, A, alpha, eps, pr_delta == 2, desc);
+            } else {
+                spla::pr(v_acc, A, alpha, eps, desc);
+            }
             timer_gpu.lap_end();
         }
     }
@@ -129,6 +139,19 @@ int main(int argc, const char* const* argv) {
 
         if (args[OPT_RUN_CPU].as<bool>()) verify_exact("cpu", v_cpu, ref_v);
         if (args[OPT_RUN_GPU].as<bool>()) verify_exact("acc", v_acc, ref_v);
+
+        // both delta modes are checked in default run as well
+        if (pr_delta == 0) {
+            library->set_force_no_acceleration(true);
+
+            v_dlt->clear();
+            spla::pr_delta(v_dlt, A, alpha, eps, false, desc);
+            verify_exact("cpu delta push", v_dlt, ref_v);
+
+            v_dlt->clear();
+            spla::pr_delta(v_dlt, A, alpha, eps, true, desc);
+            verify_exact("cpu delta gauss-seidel", v_dlt, ref_v);
+        }
     }
 
     spla::Library::get()->finalize();
@@ -67,21 +67,25 @@ int main(int argc, const char* const* argv) {
     const spla::uint                s     = args[OPT_SOURCE].as<int>();
     spla::ref_ptr<spla::Vector>     v_cpu = spla::Vector::make(N, spla::FLOAT);
     spla::ref_ptr<spla::Vector>     v_acc = spla::Vector::make(N, spla::FLOAT);
+    spla::ref_ptr<spla::Vector>     v_dlt = spla::Vector::make(N, spla::FLOAT);
     spla::ref_ptr<spla::Matrix>     A     = spla::Matrix::make(N, N, spla::FLOAT);
     spla::ref_ptr<spla::Descriptor> desc  = spla::Descriptor::make();
 
     desc->set_traversal_mode(static_cast<spla::Descriptor::TraversalMode>(args[OPT_PUSH_PULL].as<int>() - 1));
     desc->set_front_factor(args[OPT_FRONT_FACTOR].as<float>());
 
-    const spla::uint w  = 1.0f;
-    const auto&      Ai = loader.get_Ai();
-    const auto&      Aj = loader.get_Aj();
+    const auto& Ai = loader.get_Ai();
+    const auto& Aj = loader.get_Aj();
+
+    // small integer weights, symmetric for undirected graphs and exact in float sums
+    auto w = [&](std::size_t k) { return float(1 + (Ai[k] + Aj[k]) % 4); };
 
     for (std::size_t k = 0; k < loader.get_n_values(); ++k) {
-        A->set_float(Ai[k], Aj[k], w);
+        A->set_float(Ai[k], Aj[k], w(k));
     }
 
-    const int n_iters = args[OPT_NITERS].as<int>();
+    const int   n_iters = args[OPT_NITERS].as<int>();
+    const float delta   = args[OPT_DELTA].as<float>();
 
     if (args[OPT_RUN_CPU].as<bool>()) {
         library->set_force_no_acceleration(true);
@@ -90,7 +94,8 @@ int main(int argc, const char* const* argv) {
             v_cpu->clear();
 
             timer_cpu.lap_begin();
-            spla::sssp(v_cpu, A, s, desc);
+            if (delta < 0.0f) spla::sssp(v_cpu, A, s, desc);
+            else spla::sssp_delta(v_cpu, A, s, delta, desc);
             timer_cpu.lap_end();
         }
     }
@@ -102,7 +107,8 @@ int main(int argc, const char* const* argv) {
             v_acc->clear();
 
             timer_gpu.lap_begin();
-            spla::sssp(v_acc, A, s, desc);
+            if (delta < 0.0f) spla::sssp(v_acc, A, s, desc);
+            else spla::sssp_delta(v_acc, A, s, delta, desc);
             timer_gpu.lap_end();
         }
     }
@@ -114,7 +120,7 @@ int main(int argc, const char* const* argv) {
 
         for (std::size_t k = 0; k < loader.get_n_values(); ++k) {
             ref_Ai[Ai[k]].push_back(Aj[k]);
-            ref_Ax[Ai[k]].push_back(w);
+            ref_Ax[Ai[k]].push_back(w(k));
         }
 
         timer_ref.lap_begin();
@@ -123,6 +129,13 @@ int main(int argc, const char* const* argv) {
 
         if (args[OPT_RUN_CPU].as<bool>()) verify_exact("cpu", v_cpu, ref_v);
         if (args[OPT_RUN_GPU].as<bool>()) verify_exact("acc", v_acc, ref_v);
+
+        // delta-stepping is checked in default run as well, width 2 splits weights into light and heavy
+        if (delta < 0.0f) {
+            library->set_force_no_acceleration(true);
+            spla::sssp_delta(v_dlt, A, s, 2.0f, desc);
+            verify_exact("cpu delta", v_dlt, ref_v);
+        }
     }
 
     spla::Library::get()->finalize();
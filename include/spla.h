@@ -106,28 +106,36 @@ typedef enum spla_FormatVector {
     SPLA_FORMAT_VECTOR_COUNT     = 5
 } spla_FormatVector;
 
+typedef enum spla_ScheduleType {
+    SPLA_SCHEDULE_TYPE_SINGLE_THREAD = 0,
+    SPLA_SCHEDULE_TYPE_THREAD_POOL   = 1,
+    SPLA_SCHEDULE_TYPE_GRAPH         = 2
+} spla_ScheduleType;
+
 #define SPLA_NULL NULL
 
 typedef int32_t  spla_bool;
 typedef uint32_t spla_uint;
 typedef size_t   spla_size_t;
 
-typedef struct spla_RefCnt_t*       spla_RefCnt;
-typedef struct spla_MemView_t*      spla_MemView;
-typedef struct spla_Object_t*       spla_Object;
-typedef struct spla_Type_t*         spla_Type;
-typedef struct spla_Descriptor_t*   spla_Descriptor;
-typedef struct spla_Matrix_t*       spla_Matrix;
-typedef struct spla_Vector_t*       spla_Vector;
-typedef struct spla_Array_t*        spla_Array;
-typedef struct spla_Scalar_t*       spla_Scalar;
-typedef struct spla_Schedule_t*     spla_Schedule;
-typedef struct spla_ScheduleTask_t* spla_ScheduleTask;
-typedef struct spla_OpUnary_t*      spla_OpUnary;
-typedef struct spla_OpBinary_t*     spla_OpBinary;
-typedef struct spla_OpSelect_t*     spla_OpSelect;
+typedef struct spla_RefCnt_t*         spla_RefCnt;
+typedef struct spla_MemView_t*        spla_MemView;
+typedef struct spla_Object_t*         spla_Object;
+typedef struct spla_Type_t*           spla_Type;
+typedef struct spla_Descriptor_t*     spla_Descriptor;
+typedef struct spla_Matrix_t*         spla_Matrix;
+typedef struct spla_Vector_t*         spla_Vector;
+typedef struct spla_Array_t*          spla_Array;
+typedef struct spla_Scalar_t*         spla_Scalar;
+typedef struct spla_Schedule_t*       spla_Schedule;
+typedef struct spla_ScheduleTask_t*   spla_ScheduleTask;
+typedef struct spla_ScheduleFuture_t* spla_ScheduleFuture;
+typedef struct spla_OpUnary_t*        spla_OpUnary;
+typedef struct spla_OpBinary_t*       spla_OpBinary;
+typedef struct spla_OpSelect_t*       spla_OpSelect;
 
 typedef void(spla_MessageCallback)(spla_Status, const char* message, const char* file, const char* function, int line, void* p_user_data);
+typedef void(spla_ScheduleCompleteCallback)(spla_Status status, void* p_user_data);
 
 //////////////////////////////////////////////////////////////////////////////////////
 
@@ -142,6 +150,8 @@ SPLA_API spla_Status spla_Library_set_queues_count(int count);
 SPLA_API spla_Status spla_Library_set_message_callback(spla_MessageCallback callback, void* p_user_data);
 SPLA_API spla_Status spla_Library_set_default_callback();
 SPLA_API spla_Status spla_Library_get_accelerator_info(char* buffer, int length);
+SPLA_API spla_Status spla_Library_set_cpu_threads(int count);
+SPLA_API spla_Status spla_Library_set_cpu_pinning(spla_bool value);
 
 //////////////////////////////////////////////////////////////////////////////////////
 
@@ -334,6 +344,10 @@ SPLA_API spla_Status spla_Vector_get_float(spla_Vector v, spla_uint row_id, floa
 SPLA_API spla_Status spla_Vector_build(spla_Vector v, spla_MemView keys, spla_MemView values);
 SPLA_API spla_Status spla_Vector_read(spla_Vector v, spla_MemView* keys, spla_MemView* values);
 SPLA_API spla_Status spla_Vector_clear(spla_Vector v);
+SPLA_API spla_Status spla_Vector_save_snapshot(spla_Vector v, const char* file_path);
+SPLA_API spla_Status spla_Vector_load_snapshot(spla_Vector* v, const char* file_path);
+SPLA_API spla_Status spla_Vector_get_n_rows(spla_Vector v, spla_uint* n_rows);
+SPLA_API spla_Status spla_Vector_get_type(spla_Vector v, spla_Type* type);
 
 //////////////////////////////////////////////////////////////////////////////////////
 
@@ -352,22 +366,42 @@ SPLA_API spla_Status spla_Matrix_get_float(spla_Matrix M, spla_uint row_id, spla
 SPLA_API spla_Status spla_Matrix_build(spla_Matrix M, spla_MemView keys1, spla_MemView keys2, spla_MemView values);
 SPLA_API spla_Status spla_Matrix_read(spla_Matrix M, spla_MemView* keys1, spla_MemView* keys2, spla_MemView* values);
 SPLA_API spla_Status spla_Matrix_clear(spla_Matrix M);
+SPLA_API spla_Status spla_Matrix_save_snapshot(spla_Matrix M, const char* file_path);
+SPLA_API spla_Status spla_Matrix_load_snapshot(spla_Matrix* M, const char* file_path);
+SPLA_API spla_Status spla_Matrix_get_n_rows(spla_Matrix M, spla_uint* n_rows);
+SPLA_API spla_Status spla_Matrix_get_n_cols(spla_Matrix M, spla_uint* n_cols);
+SPLA_API spla_Status spla_Matrix_get_type(spla_Matrix M, spla_Type* type);
 
 //////////////////////////////////////////////////////////////////////////////////////
 
 /* Implemented some common graph algorithms using spla library */
 
 SPLA_API spla_Status spla_Algorithm_bfs(spla_Vector v, spla_Matrix A, spla_uint s, spla_Descriptor descriptor);
+SPLA_API spla_Status spla_Algorithm_ms_bfs(spla_Matrix levels, spla_Matrix A, const spla_uint* sources, spla_uint n_sources, spla_Descriptor descriptor);
 SPLA_API spla_Status spla_Algorithm_sssp(spla_Vector v, spla_Matrix A, spla_uint s, spla_Descriptor descriptor);
+SPLA_API spla_Status spla_Algorithm_sssp_delta(spla_Vector v, spla_Matrix A, spla_uint s, float delta, spla_Descriptor descriptor);
 SPLA_API spla_Status spla_Algorithm_pr(spla_Vector* p, spla_Matrix A, float alpha, float eps, spla_Descriptor descriptor);
+SPLA_API spla_Status spla_Algorithm_pr_delta(spla_Vector p, spla_Matrix A, float alpha, float eps, spla_bool gauss_seidel, spla_Descriptor descriptor);
 SPLA_API spla_Status spla_Algorithm_tc(int* ntrins, spla_Matrix A, spla_Matrix B, spla_Descriptor descriptor);
+SPLA_API spla_Status spla_Algorithm_cc(spla_Vector v, spla_Matrix A, spla_Descriptor descriptor);
 
 //////////////////////////////////////////////////////////////////////////////////////
 
 /* Scheduling and operations execution */
 
+SPLA_API spla_Status spla_Schedule_make(spla_Schedule* schedule, spla_ScheduleType type, spla_uint workers_count);
+SPLA_API spla_Status spla_Schedule_step_task(spla_Schedule schedule, spla_ScheduleTask task);
+SPLA_API spla_Status spla_Schedule_submit(spla_Schedule schedule);
+SPLA_API spla_Status spla_Schedule_submit_async(spla_Schedule schedule, spla_ScheduleFuture* future);
+SPLA_API spla_Status spla_Schedule_get_task_status(spla_Schedule schedule, int step_id, int task_id);
+SPLA_API spla_Status spla_ScheduleFuture_wait(spla_ScheduleFuture future);
+SPLA_API spla_Status spla_ScheduleFuture_wait_for(spla_ScheduleFuture future, spla_uint timeout_ms, spla_bool* is_done);
+SPLA_API spla_Status spla_ScheduleFuture_is_done(spla_ScheduleFuture future, spla_bool* is_done);
+SPLA_API spla_Status spla_ScheduleFuture_on_complete(spla_ScheduleFuture future, spla_ScheduleCompleteCallback callback, void* p_user_data);
+
 SPLA_API spla_Status spla_Exec_mxm(spla_Matrix R, spla_Matrix A, spla_Matrix B, spla_OpBinary op_multiply, spla_OpBinary op_add, spla_Scalar init, spla_Descriptor desc, spla_ScheduleTask* task);
 SPLA_API spla_Status spla_Exec_mxmT_masked(spla_Matrix R, spla_Matrix mask, spla_Matrix A, spla_Matrix B, spla_OpBinary op_multiply, spla_OpBinary op_add, spla_OpSelect op_select, spla_Scalar init, spla_Descriptor desc, spla_ScheduleTask* task);
+SPLA_API spla_Status spla_Exec_mxmT_masked_reduce(spla_Scalar r, spla_Scalar s, spla_Matrix mask, spla_Matrix A, spla_Matrix B, spla_OpBinary op_multiply, spla_OpBinary op_add, spla_OpSelect op_select, spla_Descriptor desc, spla_ScheduleTask* task);
 SPLA_API spla_Status spla_Exec_kron(spla_Matrix R, spla_Matrix A, spla_Matrix B, spla_OpBinary op_multiply, spla_Descriptor desc, spla_ScheduleTask* task);
 SPLA_API spla_Status spla_Exec_mxv_masked(spla_Vector r, spla_Vector mask, spla_Matrix M, spla_Vector v, spla_OpBinary op_multiply, spla_OpBinary op_add, spla_OpSelect op_select, spla_Scalar init, spla_Descriptor desc, spla_ScheduleTask* task);
 SPLA_API spla_Status spla_Exec_vxm_masked(spla_Vector r, spla_Vector mask, spla_Vector v, spla_Matrix M, spla_OpBinary op_multiply, spla_OpBinary op_add, spla_OpSelect op_select, spla_Scalar init, spla_Descriptor desc, spla_ScheduleTask* task);
@@ -73,6 +73,27 @@ namespace spla {
             uint                                  s,
             const ref_ptr<Descriptor>&            descriptor = spla::Descriptor::make());
 
+    /**
+     * @brief Multi-source breadth-first search algorithm
+     *
+     * Searches from all sources at once. Frontier is a matrix of bit-packed words,
+     * where each source owns one bit of a word, so a single sparse matrix product
+     * with bitwise or advances 32 sources per row of the frontier.
+     *
+     * @param levels int matrix of size sources x vertices to store reached distances;
+     *               row i stores distances from sources[i], starting from 1 for source itself
+     * @param A int matrix filled with 1 where exist edge from i to j
+     * @param sources start vertices ids to search
+     * @param descriptor optional descriptor for algorithm
+     *
+     * @return ok on success
+     */
+    SPLA_API Status ms_bfs(
+            const ref_ptr<Matrix>&     levels,
+            const ref_ptr<Matrix>&     A,
+            const std::vector<uint>&   sources,
+            const ref_ptr<Descriptor>& descriptor = spla::Descriptor::make());
+
     /**
      * @brief Single-source shortest path algorithm
      *
@@ -89,6 +110,29 @@ namespace spla {
             uint                       s,
             const ref_ptr<Descriptor>& descriptor = ref_ptr<Descriptor>());
 
+    /**
+     * @brief Delta-stepping single-source shortest path algorithm
+     *
+     * Vertices are processed in buckets of distances of width delta. Edges not longer
+     * than delta are relaxed repeatedly while current bucket is not empty, longer edges
+     * are relaxed once per bucket, so fewer relaxations are redone than in sssp
+     * on weighted graphs of large diameter.
+     *
+     * @param v float vector to store reached distances
+     * @param A float matrix filled with >0.0f distances where exist edge from i to j otherwise 0.0f
+     * @param s start vertex id to search
+     * @param delta width of bucket; if not positive, twice the mean weight of edge is used
+     * @param descriptor optional descriptor for algorithm
+     *
+     * @return ok on success
+     */
+    SPLA_API Status sssp_delta(
+            const ref_ptr<Vector>&     v,
+            const ref_ptr<Matrix>&     A,
+            uint                       s,
+            float                      delta      = 0.0f,
+            const ref_ptr<Descriptor>& descriptor = ref_ptr<Descriptor>());
+
     /**
      * @brief Naive single-source shortest path algorithm (reference cpu implementation)
      *
@@ -124,6 +168,34 @@ namespace spla {
             float                      eps        = 1e-6,
             const ref_ptr<Descriptor>& descriptor = spla::Descriptor::make());
 
+    /**
+     * @brief Delta PageRank algorithm
+     *
+     * Instead of recomputing all ranks on each iteration, residuals of vertices
+     * are tracked and pushed along edges only from vertices with residual above
+     * eps / sqrt(N), so the total residual is below eps on exit. Large sets of
+     * active vertices are pushed with mxv over whole matrix, small ones with
+     * vxm over transposed matrix. With Gauss-Seidel sweeps residuals are pushed
+     * on host one vertex at a time in order of index, so pushed values are seen
+     * by vertices of larger index in the same sweep.
+     *
+     * @param p float vector to store result vertices weights
+     * @param A float graph matrix with weights A[i][j] = alpha / outdegree(i)
+     * @param alpha float alpha to control PageRank (default is 0.85)
+     * @param eps float tolerance to control precision of PageRank (default is 1e-6)
+     * @param gauss_seidel run asynchronous Gauss-Seidel sweeps instead of synchronous iterations
+     * @param descriptor optional descriptor for algorithm
+     *
+     * @return ok on success
+     */
+    SPLA_API Status pr_delta(
+            const ref_ptr<Vector>&     p,
+            const ref_ptr<Matrix>&     A,
+            float                      alpha        = 0.85,
+            float                      eps          = 1e-6,
+            bool                       gauss_seidel = false,
+            const ref_ptr<Descriptor>& descriptor   = spla::Descriptor::make());
+
     /**
      * @brief Naive PageRank algorithm (reference cpu implementation)
      *
@@ -147,9 +219,13 @@ namespace spla {
     /**
      * @brief Triangles counting algorithm
      *
+     * Vertices are relabeled by decreasing degree and triangles are counted
+     * by masked product of lower triangle L of relabeled graph with its transpose,
+     * which is reduced to the count without storing product itself.
+     *
      * @param ntrins Number of triangles counted
-     * @param A Lower trilingual int matrix with 1 where has edge in a graph
-     * @param B Buffer int matrix to store result
+     * @param A Lower trilingual int matrix with 1 where has edge in a graph; edges in both directions are also accepted
+     * @param B Buffer int matrix, not used since product is not stored; kept for compatibility
      * @param descriptor optional descriptor for algorithm
      *
      * @return ok on success
@@ -174,6 +250,39 @@ namespace spla {
             std::vector<std::vector<spla::uint>>& Ai,
             const ref_ptr<Descriptor>&            descriptor = spla::Descriptor::make());
 
+    /**
+     * @brief Connected components algorithm
+     *
+     * FastSV style: each iteration computes for each vertex minimum grandparent
+     * label of its neighbours with mxv over (second, min), hooks trees to it and
+     * shortcuts them with min element-wise add; hooking of parents by label is
+     * done on host. Converges in O(log n) iterations.
+     *
+     * @param v int vector to store label of component of each vertex, which is the smallest vertex id in it
+     * @param A int matrix of undirected graph with non-zero values where exist edge between i and j
+     * @param descriptor optional descriptor for algorithm
+     *
+     * @return ok on success
+     */
+    SPLA_API Status cc(
+            const ref_ptr<Vector>&     v,
+            const ref_ptr<Matrix>&     A,
+            const ref_ptr<Descriptor>& descriptor = ref_ptr<Descriptor>());
+
+    /**
+     * @brief Naive connected components algorithm (reference cpu implementation)
+     *
+     * @param v int vector to store label of component of each vertex, which is the smallest vertex id in it
+     * @param A uint matrix column indices of undirected graph
+     * @param descriptor optional descriptor for algorithm
+     *
+     * @return ok on success
+     */
+    SPLA_API Status cc_naive(
+            std::vector<int>&                     v,
+            std::vector<std::vector<spla::uint>>& A,
+            const ref_ptr<Descriptor>&            descriptor = spla::Descriptor::make());
+
     /**
      * @}
      */
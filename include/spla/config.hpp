@@ -141,6 +141,35 @@ namespace spla {
         Count = 5
     };
 
+    /**
+     * @class FormatPolicy
+     * @brief Policy of keeping storage formats of matrices and vectors in memory
+     *
+     * Object may hold the same data in several formats at once, which
+     * speeds up repeated calls of different operations, but multiplies memory usage.
+     */
+    enum class FormatPolicy : uint {
+        /** Keep all converted formats alive (default) */
+        KeepAll = 0,
+        /** Keep only the most recently requested format of an object */
+        KeepOne = 1,
+        /** Evict least recently used formats when memory budget exceeded */
+        Budgeted = 2
+    };
+
+    /**
+     * @class ScheduleType
+     * @brief Types of schedules for execution of tasks
+     */
+    enum class ScheduleType : uint {
+        /** Tasks are executed one by one in calling thread */
+        SingleThread = 0,
+        /** Tasks of a single step are executed concurrently by a pool of worker threads */
+        ThreadPool = 1,
+        /** Tasks are executed out of order as soon as objects they use are ready */
+        Graph = 2
+    };
+
     /**
      * @class MessageCallback
      * @brief Callback function called on library message event
@@ -167,6 +196,16 @@ namespace spla {
      */
     using ScheduleCallback = std::function<void()>;
 
+    /**
+     * @class ScheduleCompleteCallback
+     * @brief Callback function called on completion of asynchronously submitted schedule
+     *
+     * Callback accepts status of schedule execution. It is called from the thread
+     * executed schedule, or from the calling thread if schedule is already completed
+     * at the moment of callback registration.
+     */
+    using ScheduleCompleteCallback = std::function<void(Status status)>;
+
     /**
      * @}
      */
@@ -49,19 +49,34 @@ namespace spla {
             PushPull
         };
 
+        enum class Accumulator {
+            Auto,
+            Dense,
+            Hash,
+            Heap
+        };
+
         ~Descriptor() override = default;
 
         void set_traversal_mode(TraversalMode value) { mode = value; }
         void set_front_factor(float value) { front_factor = value; }
+        void set_front_alpha(float value) { front_alpha = value; }
+        void set_front_beta(float value) { front_beta = value; }
         void set_early_exit(bool value) { early_exit = value; }
         void set_struct_only(bool value) { struct_only = value; }
+        void set_threads_count(int value) { threads_count = value; }
+        void set_accumulator(Accumulator value) { accumulator = value; }
 
-        bool  get_push_only() const { return mode == TraversalMode::Push; }
-        bool  get_pull_only() const { return mode == TraversalMode::Pull; }
-        bool  get_push_pull() const { return mode == TraversalMode::PushPull; }
-        float get_front_factor() const { return front_factor; }
-        bool  get_early_exit() const { return early_exit; }
-        bool  get_struct_only() const { return struct_only; }
+        bool        get_push_only() const { return mode == TraversalMode::Push; }
+        bool        get_pull_only() const { return mode == TraversalMode::Pull; }
+        bool        get_push_pull() const { return mode == TraversalMode::PushPull; }
+        float       get_front_factor() const { return front_factor; }
+        float       get_front_alpha() const { return front_alpha; }
+        float       get_front_beta() const { return front_beta; }
+        bool        get_early_exit() const { return early_exit; }
+        bool        get_struct_only() const { return struct_only; }
+        int         get_threads_count() const { return threads_count; }
+        Accumulator get_accumulator() const { return accumulator; }
 
         void               set_label(std::string label) override;
         const std::string& get_label() const override;
@@ -76,10 +91,14 @@ namespace spla {
     private:
         std::string m_label;
 
-        TraversalMode mode         = TraversalMode::PushPull;
-        float         front_factor = 0.1f;
-        bool          early_exit   = false;
-        bool          struct_only  = false;
+        TraversalMode mode          = TraversalMode::PushPull;
+        float         front_factor  = 0.1f;
+        float         front_alpha   = 14.0f;
+        float         front_beta    = 24.0f;
+        bool          early_exit    = false;
+        bool          struct_only   = false;
+        int           threads_count = 0;
+        Accumulator   accumulator   = Accumulator::Auto;
     };
 
     /**
@@ -39,6 +39,18 @@
 
 namespace spla {
 
+    /**
+     * @brief Execute prepared task immediately
+     *
+     * Task can be executed many times. Algorithm selected on first execution
+     * and its scratch buffers are reused by next executions.
+     *
+     * @param task Task made by one of `exec_*` functions with `task_hnd`
+     *
+     * @return Status on task execution
+     */
+    SPLA_API Status exec_task(const ref_ptr<ScheduleTask>& task);
+
     /**
      * @brief Execute (schedule) callback function
      *
@@ -113,6 +125,38 @@ namespace spla {
             ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
             ref_ptr<ScheduleTask>* task_hnd = nullptr);
 
+    /**
+     * @brief Execute (schedule) sparse masked matrix matrix-transposed product reduced to scalar
+     *
+     * @note Operation equivalent semantic is `r = s + sum(AB^t .mask)`
+     * @note Product is not stored, so memory is not spent for entries of mask
+     * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     *
+     * @param r Scalar to store result of the operation
+     * @param s Scalar init value of the sum
+     * @param mask Mask to filter product result
+     * @param A Left matrix for product
+     * @param B Right matrix for product
+     * @param op_multiply Element-wise binary operator for matrices elements product
+     * @param op_add Element-wise binary operator for matrices elements products sum and for final sum
+     * @param op_select Selection op to filter mask
+     * @param desc Scheduled task descriptor; default is null
+     * @param task_hnd Optional task hnd; pass not-null pointer to store task
+     *
+     * @return Status on task execution or status on hnd creation
+     */
+    SPLA_API Status exec_mxmT_masked_reduce(
+            ref_ptr<Scalar>        r,
+            ref_ptr<Scalar>        s,
+            ref_ptr<Matrix>        mask,
+            ref_ptr<Matrix>        A,
+            ref_ptr<Matrix>        B,
+            ref_ptr<OpBinary>      op_multiply,
+            ref_ptr<OpBinary>      op_add,
+            ref_ptr<OpSelect>      op_select,
+            ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
+            ref_ptr<ScheduleTask>* task_hnd = nullptr);
+
     /**
      * @brief Execute (schedule) sparse masked matrix kronecker product
      *
@@ -30,7 +30,10 @@
 
 #include "config.hpp"
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -131,6 +134,67 @@ namespace spla {
         SPLA_API Status set_force_no_acceleration(bool value);
         SPLA_API bool   is_set_force_no_acceleration();
 
+        /**
+         * @brief Set policy of keeping storage formats of objects in memory
+         *
+         * @param policy Policy to set; `KeepAll` by default
+         *
+         * @return Function call status
+         */
+        SPLA_API Status       set_format_policy(FormatPolicy policy);
+        SPLA_API FormatPolicy get_format_policy();
+
+        /**
+         * @brief Set global memory budget for storage formats of all objects
+         *
+         * Budget is taken into account only with `Budgeted` format policy.
+         * When exceeded, least recently used redundant formats of accessed objects are evicted.
+         *
+         * @param bytes Budget in bytes; 0 means no limit
+         *
+         * @return Function call status
+         */
+        SPLA_API Status      set_memory_budget(std::size_t bytes);
+        SPLA_API std::size_t get_memory_budget();
+
+        /**
+         * @return Total memory in bytes held by storage formats of all objects;
+         *         tracked only while `KeepOne` or `Budgeted` policy is set
+         */
+        SPLA_API std::size_t get_memory_usage();
+
+        /**
+         * @brief Set number of threads of library cpu thread pool
+         *
+         * Pool is shared by all parallel cpu kernels. By default it is sized by
+         * `SPLA_CPU_THREADS` environment variable or to all hardware threads.
+         * Task with descriptor threads count above pool size runs extra threads ids in turn.
+         *
+         * @warning Must be called when no computations are running
+         *
+         * @param count Number of threads; 0 means all hardware threads
+         *
+         * @return Function call status
+         */
+        SPLA_API Status set_cpu_threads(int count);
+        SPLA_API int    get_cpu_threads();
+
+        /**
+         * @brief Set option to pin threads of cpu thread pool to cores
+         *
+         * Pinned threads are distributed over NUMA nodes in contiguous ranges of ids,
+         * and memory of dense vectors is placed on nodes of threads which process it.
+         * Disabled by default; `SPLA_CPU_PIN=1` environment variable enables it.
+         *
+         * @warning Must be called when no computations are running
+         *
+         * @param value True to pin threads
+         *
+         * @return Function call status
+         */
+        SPLA_API Status set_cpu_pinning(bool value);
+        SPLA_API bool   is_set_cpu_pinning();
+
         /**
          * @brief Get acc info in a form of a string
          * @param[out] info String to store info
@@ -173,6 +237,24 @@ namespace spla {
          */
         class Logger* get_logger();
 
+        /**
+         * @warning Internal usage only!
+         * @return Library storage formats residency state
+         */
+        class StorageResidency* get_storage_residency();
+
+        /**
+         * @warning Internal usage only!
+         * @return Library cpu thread pool, created on first request
+         */
+        class CpuThreadPool* get_cpu_pool();
+
+        /**
+         * @warning Internal usage only!
+         * @return Library executor of asynchronously submitted schedules, created on first request
+         */
+        class ScheduleAsyncExecutor* get_async_executor();
+
         /**
          * @warning Internal usage only!
          * @return Library time profiler
@@ -191,6 +273,9 @@ namespace spla {
          */
         SPLA_API static Library* get();
 
+    private:
+        void release_async_executor();
+
     private:
         std::unordered_map<std::string, std::string> m_env;
         std::unique_ptr<class Accelerator>           m_accelerator;
@@ -198,6 +283,14 @@ namespace spla {
         std::unique_ptr<class Dispatcher>            m_dispatcher;
         std::unique_ptr<class Logger>                m_logger;
         std::unique_ptr<class TimeProfiler>          m_time_profiler;
+        std::shared_ptr<class StorageResidency>      m_storage_residency;
+        std::unique_ptr<class CpuThreadPool>         m_cpu_pool;
+        std::atomic<class CpuThreadPool*>            m_cpu_pool_cached{nullptr};
+        std::mutex                                   m_cpu_pool_mutex;
+        std::unique_ptr<class ScheduleAsyncExecutor> m_async_executor;
+        std::mutex                                   m_async_executor_mutex;
+        int                                          m_cpu_threads  = 0;
+        std::atomic_bool                             m_cpu_pin{false};
         bool                                         m_force_no_acc = false;
     };
 
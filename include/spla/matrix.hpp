@@ -63,6 +63,9 @@ namespace spla {
         SPLA_API virtual Status        build(const ref_ptr<MemView>& keys1, const ref_ptr<MemView>& keys2, const ref_ptr<MemView>& values) = 0;
         SPLA_API virtual Status        read(ref_ptr<MemView>& keys1, ref_ptr<MemView>& keys2, ref_ptr<MemView>& values)                    = 0;
         SPLA_API virtual Status        clear()                                                                                             = 0;
+        SPLA_API virtual Status        set_memory_budget(std::size_t bytes)                                                                = 0;
+        SPLA_API virtual std::size_t   get_memory_usage()                                                                                  = 0;
+        SPLA_API virtual Status        save_snapshot(const std::string& file_path)                                                         = 0;
 
         /**
          * @brief Make new matrix instance with specified dim and values type
@@ -74,6 +77,18 @@ namespace spla {
          * @return New matrix instance or null if failed to create
          */
         SPLA_API static ref_ptr<Matrix> make(uint n_rows, uint n_cols, const ref_ptr<Type>& type);
+
+        /**
+         * @brief Load matrix from binary snapshot file saved by `save_snapshot`
+         *
+         * Snapshot stores type, dims and csr data of the matrix as is,
+         * so loading is limited by disk bandwidth rather than parsing.
+         *
+         * @param file_path Path to snapshot file
+         *
+         * @return New matrix instance or null if failed to load
+         */
+        SPLA_API static ref_ptr<Matrix> load_snapshot(const std::string& file_path);
     };
 
     /**
@@ -45,6 +45,14 @@ namespace spla {
     /**
      * @class ScheduleTask
      * @brief Represent single smallest evaluation tasks which can scheduled
+     *
+     * First `get_n_outputs()` objects returned by `get_args()` are written by the task,
+     * remaining objects are only read. Task without arguments is treated as having
+     * unknown side effects, so schedules never reorder it with other tasks.
+     *
+     * Task made by `exec_*` function with `task_hnd` is a prepared task. It can be executed
+     * many times by `exec_task` or schedules, and its arguments can be rebound between
+     * executions by `set_arg`. Selected algorithm and its scratch buffers are kept with the task.
      */
     class ScheduleTask : public Object {
     public:
@@ -53,8 +61,63 @@ namespace spla {
         SPLA_API virtual std::string                  get_key()             = 0;
         SPLA_API virtual std::string                  get_key_full()        = 0;
         SPLA_API virtual std::vector<ref_ptr<Object>> get_args()            = 0;
-        SPLA_API virtual ref_ptr<Descriptor>          get_desc()            = 0;
-        SPLA_API virtual ref_ptr<Descriptor>          get_desc_or_default() = 0;
+        SPLA_API virtual int                          get_n_outputs()       = 0;
+
+        /**
+         * @brief Rebinds argument of prepared task
+         *
+         * @param index Index of argument, same as in `get_args`
+         * @param arg New argument; must be of the same kind as previous one
+         *
+         * @return Ok on success, `InvalidArgument` if no such argument or argument kind is wrong
+         */
+        SPLA_API virtual Status              set_arg(int index, ref_ptr<Object> arg) = 0;
+        SPLA_API virtual ref_ptr<Descriptor> get_desc()                              = 0;
+        SPLA_API virtual ref_ptr<Descriptor> get_desc_or_default()                   = 0;
+    };
+
+    /**
+     * @class ScheduleFuture
+     * @brief Handle to wait for result of asynchronously submitted schedule
+     */
+    class ScheduleFuture : public Object {
+    public:
+        SPLA_API ~ScheduleFuture() override = default;
+
+        /**
+         * @brief Blocks until schedule execution is completed
+         *
+         * @return Status of schedule execution
+         */
+        SPLA_API virtual Status wait() = 0;
+
+        /**
+         * @brief Blocks until schedule execution is completed or timeout expired
+         *
+         * @param timeout_ms Time to wait in milliseconds
+         *
+         * @return True if schedule execution is completed
+         */
+        SPLA_API virtual bool wait_for(uint timeout_ms) = 0;
+
+        /**
+         * @return True if schedule execution is completed
+         */
+        SPLA_API virtual bool is_done() = 0;
+
+        /**
+         * @return Status of completed schedule execution or `InvalidState` if it is still running
+         */
+        SPLA_API virtual Status get_status() = 0;
+
+        /**
+         * @brief Registers callback called once schedule execution is completed
+         *
+         * @param callback Callback accepting status of schedule execution
+         *
+         * @return Ok on success
+         */
+        SPLA_API virtual Status on_complete(ScheduleCompleteCallback callback) = 0;
     };
 
     /**
@@ -67,6 +130,26 @@ namespace spla {
         SPLA_API virtual Status step_task(ref_ptr<ScheduleTask> task)                = 0;
         SPLA_API virtual Status step_tasks(std::vector<ref_ptr<ScheduleTask>> tasks) = 0;
         SPLA_API virtual Status submit()                                             = 0;
+
+        /**
+         * @brief Submits schedule for execution in a background thread and returns immediately
+         *
+         * Schedule submitted several times is executed by submits in order of calls.
+         * Objects used by tasks of schedule must not be accessed until execution is completed.
+         *
+         * @return Handle to wait for schedule execution status
+         */
+        SPLA_API virtual ref_ptr<ScheduleFuture> submit_async() = 0;
+
+        /**
+         * @brief Status of a task after last submit of schedule
+         *
+         * @param step_id Index of step in schedule
+         * @param task_id Index of task in step
+         *
+         * @return Status of task execution or `NoValue` if task was not executed
+         */
+        SPLA_API virtual Status get_task_status(int step_id, int task_id) = 0;
     };
 
     /**
@@ -76,6 +159,26 @@ namespace spla {
      */
     SPLA_API ref_ptr<Schedule> make_schedule();
 
+    /**
+     * @brief Makes new schedule of specified type
+     *
+     * Thread pool schedule runs all tasks of a step concurrently and waits
+     * for all of them before the next step. If some tasks fail, schedule stops
+     * after the step and returns status of the first failed task.
+     * Tasks of a step must not write objects used by other tasks of this step.
+     *
+     * Graph schedule ignores steps boundaries and builds dependencies between tasks
+     * from objects they read and write (see `ScheduleTask::get_args`). Independent tasks
+     * are executed out of order, but result is the same as of sequential execution.
+     * If some task fails, its dependent tasks are not executed.
+     *
+     * @param type Type of schedule
+     * @param workers_count Number of threads to execute tasks; 0 means all hardware threads
+     *
+     * @return New created schedule
+     */
+    SPLA_API ref_ptr<Schedule> make_schedule(ScheduleType type, uint workers_count = 0);
+
     /**
      * @}
      */
@@ -64,6 +64,9 @@ namespace spla {
         SPLA_API virtual Status        build(const ref_ptr<MemView>& keys, const ref_ptr<MemView>& values) = 0;
         SPLA_API virtual Status        read(ref_ptr<MemView>& keys, ref_ptr<MemView>& values)              = 0;
         SPLA_API virtual Status        clear()                                                             = 0;
+        SPLA_API virtual Status        set_memory_budget(std::size_t bytes)                                = 0;
+        SPLA_API virtual std::size_t   get_memory_usage()                                                  = 0;
+        SPLA_API virtual Status        save_snapshot(const std::string& file_path)                         = 0;
 
         /**
          * @brief Make new vector instance with specified dim and values type
@@ -74,6 +77,18 @@ namespace spla {
          * @return New vector instance or null if failed to create
          */
         SPLA_API static ref_ptr<Vector> make(uint n_rows, const ref_ptr<Type>& type);
+
+        /**
+         * @brief Load vector from binary snapshot file saved by `save_snapshot`
+         *
+         * Snapshot stores type, dims and coo data of the vector as is,
+         * so loading is limited by disk bandwidth rather than parsing.
+         *
+         * @param file_path Path to snapshot file
+         *
+         * @return New vector instance or null if failed to load
+         */
+        SPLA_API static ref_ptr<Vector> load_snapshot(const std::string& file_path);
     };
 
     /**
@@ -287,5 +287,8 @@ __all__ = [
     "Matrix",
     "Vector",
     "Scalar",
+    "Schedule",
+    "ScheduleFuture",
+    "ScheduleType",
     "VERSIONS"
 ]
@@ -31,7 +31,8 @@ __all__ = [
     "check",
     "is_docs",
     "FormatMatrix",
-    "FormatVector"
+    "FormatVector",
+    "ScheduleType"
 ]
 
 import os
@@ -147,6 +148,22 @@ class FormatVector(enum.Enum):
     COUNT = 5
 
 
+class ScheduleType(enum.Enum):
+    """
+    Mapping for spla supported schedule types enumeration.
+
+    | Name            | Description                                                        |
+    |:----------------|:-------------------------------------------------------------------|
+    |`SINGLE_THREAD`  | Tasks are executed one by one in calling thread                    |
+    |`THREAD_POOL`    | Tasks of a single step are executed concurrently by a thread pool  |
+    |`GRAPH`          | Tasks are executed out of order following data dependencies        |
+    """
+
+    SINGLE_THREAD = 0
+    THREAD_POOL = 1
+    GRAPH = 2
+
+
 _status_mapping = {
     1: SplaError,
     2: SplaNoAcceleration,
@@ -205,6 +222,10 @@ def load_library(lib_path):
     _spla.spla_Library_set_default_callback.argtypes = []
     _spla.spla_Library_get_accelerator_info.restype = _status_t
     _spla.spla_Library_get_accelerator_info.argtypes = [ctypes.c_char_p, _int]
+    _spla.spla_Library_set_cpu_threads.restype = _status_t
+    _spla.spla_Library_set_cpu_threads.argtypes = [_int]
+    _spla.spla_Library_set_cpu_pinning.restype = _status_t
+    _spla.spla_Library_set_cpu_pinning.argtypes = [ctypes.c_int]
 
     _spla.spla_Type_BOOL.restype = _object_t
     _spla.spla_Type_BOOL.argtypes = []
@@ -494,6 +515,10 @@ def load_library(lib_path):
     _spla.spla_Vector_build.restype = _status_t
     _spla.spla_Vector_read.restype = _status_t
     _spla.spla_Vector_clear.restype = _status_t
+    _spla.spla_Vector_save_snapshot.restype = _status_t
+    _spla.spla_Vector_load_snapshot.restype = _status_t
+    _spla.spla_Vector_get_n_rows.restype = _status_t
+    _spla.spla_Vector_get_type.restype = _status_t
 
     _spla.spla_Vector_make.argtypes = [_p_object_t, _uint, _object_t]
     _spla.spla_Vector_set_format.argtypes = [_object_t, ctypes.c_int]
@@ -508,6 +533,10 @@ def load_library(lib_path):
     _spla.spla_Vector_build.argtypes = [_object_t, _object_t, _object_t]
     _spla.spla_Vector_read.argtypes = [_object_t, _p_object_t, _p_object_t]
     _spla.spla_Vector_clear.argtypes = [_object_t]
+    _spla.spla_Vector_save_snapshot.argtypes = [_object_t, ctypes.c_char_p]
+    _spla.spla_Vector_load_snapshot.argtypes = [_p_object_t, ctypes.c_char_p]
+    _spla.spla_Vector_get_n_rows.argtypes = [_object_t, _p_uint]
+    _spla.spla_Vector_get_type.argtypes = [_object_t, _p_object_t]
 
     _spla.spla_Matrix_make.restype = _status_t
     _spla.spla_Matrix_set_format.restype = _status_t
@@ -522,6 +551,11 @@ def load_library(lib_path):
     _spla.spla_Matrix_build.restype = _status_t
     _spla.spla_Matrix_read.restype = _status_t
     _spla.spla_Matrix_clear.restype = _status_t
+    _spla.spla_Matrix_save_snapshot.restype = _status_t
+    _spla.spla_Matrix_load_snapshot.restype = _status_t
+    _spla.spla_Matrix_get_n_rows.restype = _status_t
+    _spla.spla_Matrix_get_n_cols.restype = _status_t
+    _spla.spla_Matrix_get_type.restype = _status_t
 
     _spla.spla_Matrix_make.argtypes = [_p_object_t, _uint, _uint, _object_t]
     _spla.spla_Matrix_set_format.argtypes = [_object_t, ctypes.c_int]
@@ -536,19 +570,53 @@ def load_library(lib_path):
     _spla.spla_Matrix_build.argtypes = [_object_t, _object_t, _object_t, _object_t]
     _spla.spla_Matrix_read.argtypes = [_object_t, _p_object_t, _p_object_t, _p_object_t]
     _spla.spla_Matrix_clear.argtypes = [_object_t]
+    _spla.spla_Matrix_save_snapshot.argtypes = [_object_t, ctypes.c_char_p]
+    _spla.spla_Matrix_load_snapshot.argtypes = [_p_object_t, ctypes.c_char_p]
+    _spla.spla_Matrix_get_n_rows.argtypes = [_object_t, _p_uint]
+    _spla.spla_Matrix_get_n_cols.argtypes = [_object_t, _p_uint]
+    _spla.spla_Matrix_get_type.argtypes = [_object_t, _p_object_t]
 
     _spla.spla_Algorithm_bfs.restype = _status_t
+    _spla.spla_Algorithm_ms_bfs.restype = _status_t
     _spla.spla_Algorithm_sssp.restype = _status_t
+    _spla.spla_Algorithm_sssp_delta.restype = _status_t
     _spla.spla_Algorithm_pr.restype = _status_t
+    _spla.spla_Algorithm_pr_delta.restype = _status_t
     _spla.spla_Algorithm_tc.restype = _status_t
+    _spla.spla_Algorithm_cc.restype = _status_t
 
     _spla.spla_Algorithm_bfs.argtypes = [_object_t, _object_t, _uint, _object_t]
+    _spla.spla_Algorithm_ms_bfs.argtypes = [_object_t, _object_t, _p_uint, _uint, _object_t]
     _spla.spla_Algorithm_sssp.argtypes = [_object_t, _object_t, _uint, _object_t]
+    _spla.spla_Algorithm_sssp_delta.argtypes = [_object_t, _object_t, _uint, _float, _object_t]
     _spla.spla_Algorithm_pr.argtypes = [_p_object_t, _object_t, _float, _float, _object_t]
+    _spla.spla_Algorithm_pr_delta.argtypes = [_object_t, _object_t, _float, _float, _int, _object_t]
     _spla.spla_Algorithm_tc.argtypes = [_p_int, _object_t, _object_t, _object_t]
+    _spla.spla_Algorithm_cc.argtypes = [_object_t, _object_t, _object_t]
+
+    _spla.spla_Schedule_make.restype = _status_t
+    _spla.spla_Schedule_step_task.restype = _status_t
+    _spla.spla_Schedule_submit.restype = _status_t
+    _spla.spla_Schedule_submit_async.restype = _status_t
+    _spla.spla_Schedule_get_task_status.restype = _status_t
+    _spla.spla_ScheduleFuture_wait.restype = _status_t
+    _spla.spla_ScheduleFuture_wait_for.restype = _status_t
+    _spla.spla_ScheduleFuture_is_done.restype = _status_t
+    _spla.spla_ScheduleFuture_on_complete.restype = _status_t
+
+    _spla.spla_Schedule_make.argtypes = [_p_object_t, _enum_t, _uint]
+    _spla.spla_Schedule_step_task.argtypes = [_object_t, _object_t]
+    _spla.spla_Schedule_submit.argtypes = [_object_t]
+    _spla.spla_Schedule_submit_async.argtypes = [_object_t, _p_object_t]
+    _spla.spla_Schedule_get_task_status.argtypes = [_object_t, _int, _int]
+    _spla.spla_ScheduleFuture_wait.argtypes = [_object_t]
+    _spla.spla_ScheduleFuture_wait_for.argtypes = [_object_t, _uint, _p_int]
+    _spla.spla_ScheduleFuture_is_done.argtypes = [_object_t, _p_int]
+    _spla.spla_ScheduleFuture_on_complete.argtypes = [_object_t, ctypes.c_void_p, ctypes.c_void_p]
 
     _spla.spla_Exec_mxm.restype = _status_t
     _spla.spla_Exec_mxmT_masked.restype = _status_t
+    _spla.spla_Exec_mxmT_masked_reduce.restype = _status_t
     _spla.spla_Exec_kron.restype = _status_t
     _spla.spla_Exec_mxv_masked.restype = _status_t
     _spla.spla_Exec_vxm_masked.restype = _status_t
@@ -572,6 +640,8 @@ def load_library(lib_path):
         [_object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _p_object_t]
     _spla.spla_Exec_mxmT_masked.argtypes = \
         [_object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _p_object_t]
+    _spla.spla_Exec_mxmT_masked_reduce.argtypes = \
+        [_object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _object_t, _p_object_t]
     _spla.spla_Exec_kron.argtypes = \
         [_object_t, _object_t, _object_t, _object_t, _object_t, _p_object_t]
     _spla.spla_Exec_mxv_masked.argtypes = \
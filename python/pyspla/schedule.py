@@ -25,3 +25,205 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 """
+
+__all__ = [
+    "Schedule",
+    "ScheduleFuture"
+]
+
+import ctypes
+import threading
+import contextlib
+
+from .bridge import backend, check, ScheduleType, _status_mapping
+from .object import Object
+
+_complete_callback_t = ctypes.CFUNCTYPE(None, ctypes.c_uint, ctypes.c_void_p)
+_pending_callbacks = dict()
+_recording = threading.local()
+
+
+class ScheduleFuture(Object):
+    """
+    Handle to wait for result of asynchronously submitted schedule.
+
+    Future allows host application to keep doing other work, while
+    schedule is executed by the library in a background thread.
+    """
+
+    def __init__(self, label=None, hnd=None):
+        """
+        Creates a new future from existing hnd.
+
+        :param label: optional: str. default: None.
+            Future name for debugging.
+
+        :param hnd: optional: ctypes.c_void_p. default: None.
+            Future native void* handle to a C counterpart.
+        """
+
+        super().__init__(label, hnd)
+
+    def wait(self):
+        """
+        Blocks until schedule execution is completed.
+        Raises exception if some task of schedule failed.
+        """
+
+        check(backend().spla_ScheduleFuture_wait(self.hnd))
+
+    def wait_for(self, timeout_ms):
+        """
+        Blocks until schedule execution is completed or timeout expired.
+
+        :param timeout_ms: int.
+            Time to wait in milliseconds.
+
+        :return: True if schedule execution is completed.
+        """
+
+        is_done = ctypes.c_int(0)
+        check(backend().spla_ScheduleFuture_wait_for(self.hnd, ctypes.c_uint(timeout_ms), ctypes.byref(is_done)))
+        return bool(is_done.value)
+
+    def is_done(self):
+        """
+        :return: True if schedule execution is completed.
+        """
+
+        is_done = ctypes.c_int(0)
+        check(backend().spla_ScheduleFuture_is_done(self.hnd, ctypes.byref(is_done)))
+        return bool(is_done.value)
+
+    def on_complete(self, callback):
+        """
+        Registers callback called once schedule execution is completed.
+
+        Callback is called from the thread executed schedule, or immediately
+        if schedule is already completed. Callback must not wait this future.
+
+        :param callback: callable.
+            Function accepting None on success or exception describing failure.
+        """
+
+        def wrapped_callback(status, p_user_data):
+            _pending_callbacks.pop(id(native_callback), None)
+            callback(_status_mapping[status]() if status != 0 else None)
+
+        # keep native callback alive until it is called
+        native_callback = _complete_callback_t(wrapped_callback)
+        _pending_callbacks[id(native_callback)] = native_callback
+
+        check(backend().spla_ScheduleFuture_on_complete(
+            self.hnd, ctypes.cast(native_callback, ctypes.c_void_p), ctypes.c_void_p(0)))
+
+
+class Schedule(Object):
+    """
+    Sequence of operations recorded for deferred execution.
+
+    Operations called on matrices and vectors inside `record` block are not executed
+    immediately, but appended to the schedule. Recorded schedule can be submitted
+    synchronously with `submit` or asynchronously with `submit_async`.
+
+    >>> s = Schedule(ScheduleType.GRAPH)
+    >>> u = Vector.from_lists([0, 1], [10, 20], 4, INT)
+    >>> with s.record():
+    ...     r = u.eadd(INT.PLUS, u)
+    >>> s.submit_async().wait()
+    >>> print(r)
+    '
+     0|20
+     1|40
+     2| .
+     3| .
+    '
+    """
+
+    def __init__(self, schedule_type=ScheduleType.SINGLE_THREAD, workers_count=0, label=None, hnd=None):
+        """
+        Creates a new schedule from existing hnd or making new one.
+
+        :param schedule_type: optional: ScheduleType. default: ScheduleType.SINGLE_THREAD.
+            Type of schedule to make.
+
+        :param workers_count: optional: int. default: 0.
+            Number of threads to execute tasks; 0 means all hardware threads.
+
+        :param label: optional: str. default: None.
+            Schedule name for debugging.
+
+        :param hnd: optional: ctypes.c_void_p. default: None.
+            Schedule native void* handle to a C counterpart.
+        """
+
+        if not hnd:
+            hnd = ctypes.c_void_p(0)
+            check(backend().spla_Schedule_make(ctypes.byref(hnd), schedule_type.value, ctypes.c_uint(workers_count)))
+
+        super().__init__(label, hnd)
+
+    @contextlib.contextmanager
+    def record(self):
+        """
+        Context in which operations are recorded into this schedule instead of immediate execution.
+        Results of recorded operations are available only after schedule is executed.
+        """
+
+        stack = _recording_stack()
+        stack.append((self, []))
+        try:
+            yield self
+        finally:
+            schedule, tasks = stack.pop()
+            schedule._step_tasks(tasks)
+
+    def submit(self):
+        """
+        Executes schedule and blocks until it is completed.
+        Raises exception if some task of schedule failed.
+        """
+
+        check(backend().spla_Schedule_submit(self.hnd))
+
+    def submit_async(self):
+        """
+        Submits schedule for execution in a background thread and returns immediately.
+        Objects used by the schedule must not be accessed until execution is completed.
+
+        :return: ScheduleFuture to wait for result.
+        """
+
+        hnd = ctypes.c_void_p(0)
+        check(backend().spla_Schedule_submit_async(self.hnd, ctypes.byref(hnd)))
+        return ScheduleFuture(hnd=hnd)
+
+    def _step_tasks(self, tasks):
+        for task in tasks:
+            if task.value:
+                check(backend().spla_Schedule_step_task(self.hnd, task))
+                check(backend().spla_RefCnt_unref(task))
+        tasks.clear()
+
+
+def _recording_stack():
+    if not hasattr(_recording, "stack"):
+        _recording.stack = []
+    return _recording.stack
+
+
+def _get_task_ptr():
+    """
+    Returns pointer to receive task of operation being called.
+    Null pointer means immediate execution of operation.
+    """
+
+    stack = _recording_stack()
+    if not stack:
+        return ctypes.POINTER(ctypes.c_void_p)()
+
+    schedule, tasks = stack[-1]
+    schedule._step_tasks(tasks)
+    task = ctypes.c_void_p(0)
+    tasks.append(task)
+    return ctypes.pointer(task)
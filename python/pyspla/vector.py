@@ -34,6 +34,7 @@ from .object import Object
 from .memview import MemView
 from .scalar import Scalar
 from .descriptor import Descriptor
+from .schedule import _get_task_ptr
 from .op import OpUnary, OpBinary, OpSelect
 import random as rnd
 
@@ -256,6 +257,39 @@ class Vector(Object):
 
         check(backend().spla_Vector_clear(self.hnd))
 
+    def save_snapshot(self, file_path: str):
+        """
+        Saves vector content into binary snapshot file.
+        Snapshot stores type, shape and data of the vector as is, so it can be loaded without parsing.
+
+        :param file_path: str.
+            Path to the file to create.
+        """
+
+        check(backend().spla_Vector_save_snapshot(self.hnd, file_path.encode("utf-8")))
+
+    @classmethod
+    def load_snapshot(cls, file_path: str):
+        """
+        Loads vector from binary snapshot file created by `save_snapshot`.
+
+        :param file_path: str.
+            Path to the snapshot file.
+
+        :return: Loaded vector.
+        """
+
+        hnd = ctypes.c_void_p(0)
+        check(backend().spla_Vector_load_snapshot(ctypes.byref(hnd), file_path.encode("utf-8")))
+
+        n_rows = ctypes.c_uint(0)
+        c_type = ctypes.c_void_p(0)
+        check(backend().spla_Vector_get_n_rows(hnd, ctypes.byref(n_rows)))
+        check(backend().spla_Vector_get_type(hnd, ctypes.byref(c_type)))
+
+        dtype = {t._hnd: t for t in (INT, UINT, FLOAT)}[c_type.value]
+        return Vector(shape=n_rows.value, dtype=dtype, hnd=hnd)
+
     def to_lists(self):
         """
         Read vector data as a python lists of keys and values.
@@ -775,4 +809,4 @@ class Vector(Object):
         return desc.hnd if desc else ctypes.c_void_p(0)
 
     def _get_task(self, task):
-        return ctypes.POINTER(ctypes.c_void_p)()
+        return _get_task_ptr()
@@ -27,16 +27,22 @@
 
 #include <spla/algorithm.hpp>
 #include <spla/exec.hpp>
+#include <spla/memview.hpp>
 #include <spla/op.hpp>
 #include <spla/schedule.hpp>
 #include <spla/timer.hpp>
 
 #include <algorithm>
+#include <bitset>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <numeric>
 #include <queue>
+#include <tuple>
 
 namespace spla {
 
@@ -53,6 +59,7 @@ namespace spla {
 
         ref_ptr<Vector> frontier_prev  = Vector::make(N, INT);
         ref_ptr<Vector> frontier_new   = Vector::make(N, INT);
+        ref_ptr<Vector> degree         = Vector::make(N, INT);
         ref_ptr<Scalar> frontier_size  = Scalar::make_int(1);
         ref_ptr<Scalar> depth          = Scalar::make_int(1);
         ref_ptr<Scalar> zero           = Scalar::make_int(0);
@@ -66,16 +73,65 @@ namespace spla {
 
         frontier_prev->set_int(s, 1);
 
-        bool  push         = descriptor->get_push_only();
-        bool  pull         = descriptor->get_pull_only();
-        bool  push_pull    = descriptor->get_push_pull();
-        float front_factor = descriptor->get_front_factor();
+        // tasks are prepared once, frontiers are rebound on each iteration
+        ref_ptr<ScheduleTask> task_assign, task_push, task_pull, task_count;
+        exec_v_assign_masked(v, frontier_prev, depth, SECOND_INT, NQZERO_INT, ref_ptr<Descriptor>(), &task_assign);
+        exec_vxm_masked(frontier_new, v, frontier_prev, A, BAND_INT, BOR_INT, EQZERO_INT, zero, desc, &task_push);
+        exec_mxv_masked(frontier_new, v, A, frontier_prev, BAND_INT, BOR_INT, EQZERO_INT, zero, desc, &task_pull);
+        exec_v_count_mf(frontier_size, frontier_new, ref_ptr<Descriptor>(), &task_count);
+
+        bool  push      = descriptor->get_push_only();
+        bool  pull      = descriptor->get_pull_only();
+        bool  push_pull = descriptor->get_push_pull();
+        float alpha     = descriptor->get_front_alpha();
+        float beta      = descriptor->get_front_beta();
 
         if (!(push || pull || push_pull)) push = true;
 
+        // direction is switched by edges of frontier against edges left to check (Beamer et al.),
+        // front edges are zero at start, so step from single source is always push
+        std::int64_t edges_to_check = 0;
+        std::int64_t front_edges    = 0;
+        bool         pulling        = false;
+
+        // edge counts are summed on host in 64 bits, graph may have more than 2^31 edges
+        std::vector<int> degrees;
+
+        auto sum_front_degrees = [&](const ref_ptr<Vector>& front) {
+            ref_ptr<MemView> keys, values;
+            front->read(keys, values);
+
+            const auto   n_values = values->get_size() / sizeof(int);
+            const auto*  Fi       = static_cast<const uint*>(keys->get_buffer());
+            const auto*  Fx       = static_cast<const int*>(values->get_buffer());
+            std::int64_t sum      = 0;
+
+            for (std::size_t k = 0; k < n_values; k++) {
+                if (Fx[k] != 0) sum += degrees[Fi[k]];
+            }
+            return sum;
+        };
+
+        if (push_pull) {
+            exec_mxv_masked(degree, frontier_new, A, frontier_new, BONE_INT, PLUS_INT, ALWAYS_INT, zero);
+
+            ref_ptr<MemView> keys, values;
+            degree->read(keys, values);
+
+            const auto  n_values = values->get_size() / sizeof(int);
+            const auto* Di       = static_cast<const uint*>(keys->get_buffer());
+            const auto* Dx       = static_cast<const int*>(values->get_buffer());
+
+            degrees.resize(N, 0);
+            for (std::size_t k = 0; k < n_values; k++) {
+                degrees[Di[k]] = Dx[k];
+                edges_to_check += Dx[k];
+            }
+        }
+
 #ifndef SPLA_RELEASE
         std::string mode;
-        if (push_pull) mode = "(push_pull " + std::to_string(front_factor * 100.0f) + "%)";
+        if (push_pull) mode = "(push_pull alpha " + std::to_string(alpha) + " beta " + std::to_string(beta) + ")";
         if (pull) mode = "(pull)";
         if (push) mode = "(push)";
 
@@ -88,18 +144,35 @@ namespace spla {
             tight.start();
 #endif
             depth->set_int(current_level);
-            exec_v_assign_masked(v, frontier_prev, depth, SECOND_INT, NQZERO_INT);
+            exec_task(task_assign);
 
-            float front_density  = float(frontier_size->as_int()) / float(N);
-            bool  is_push_better = (front_density <= front_factor);
+            const int front_size = frontier_size->as_int();
 
-            if (push || (push_pull && is_push_better)) {
-                exec_vxm_masked(frontier_new, v, frontier_prev, A, BAND_INT, BOR_INT, EQZERO_INT, zero, desc);
+            // edges of frontier are checked in this step whatever the direction is
+            if (push_pull) {
+                if (!pulling && double(front_edges) > double(edges_to_check) / alpha) pulling = true;
+                edges_to_check -= front_edges;
+            }
+
+            if (push || (push_pull && !pulling)) {
+                exec_task(task_push);
             } else {
-                exec_mxv_masked(frontier_new, v, A, frontier_prev, BAND_INT, BOR_INT, EQZERO_INT, zero, desc);
+                exec_task(task_pull);
+            }
+
+            // out edges of new frontier are counted after pull steps too, so count left is exact on switch back
+            if (push_pull) {
+                front_edges = sum_front_degrees(frontier_new);
             }
 
-            exec_v_count_mf(frontier_size, frontier_new);
+            exec_task(task_count);
+
+            // back to push once frontier is shrinking and small enough, next step is forced to be push
+            if (pulling && frontier_size->as_int() < front_size && float(frontier_size->as_int()) <= float(N) / beta) {
+                pulling = false;
+                edges_to_check -= front_edges;
+                front_edges = 0;
+            }
 
 #ifndef SPLA_RELEASE
             tight.stop();
@@ -114,6 +187,13 @@ namespace spla {
             current_level += 1;
 
             std::swap(frontier_prev, frontier_new);
+
+            task_assign->set_arg(1, frontier_prev.as<Object>());
+            task_push->set_arg(0, frontier_new.as<Object>());
+            task_push->set_arg(2, frontier_prev.as<Object>());
+            task_pull->set_arg(0, frontier_new.as<Object>());
+            task_pull->set_arg(3, frontier_prev.as<Object>());
+            task_count->set_arg(1, frontier_new.as<Object>());
         }
 
         return Status::Ok;
@@ -151,6 +231,167 @@ namespace spla {
         return Status::Ok;
     }
 
+    Status ms_bfs(const ref_ptr<Matrix>&     levels,
+                  const ref_ptr<Matrix>&     A,
+                  const std::vector<uint>&   sources,
+                  const ref_ptr<Descriptor>& descriptor) {
+        assert(levels);
+        assert(A);
+
+        if (levels->get_n_rows() != sources.size()) return Status::InvalidArgument;
+        if (levels->get_n_cols() != A->get_n_rows()) return Status::InvalidArgument;
+        for (uint s : sources) {
+            if (s >= A->get_n_rows()) return Status::InvalidArgument;
+        }
+
+        // each source owns single bit of frontier word, row w of frontier packs sources [w * 32, w * 32 + 32)
+        constexpr uint BITS = 32;
+        const auto     K    = levels->get_n_rows();
+        const auto     N    = levels->get_n_cols();
+        const auto     W    = (K + BITS - 1) / BITS;
+
+        ref_ptr<Matrix> frontier      = Matrix::make(W, N, INT);
+        ref_ptr<Matrix> frontier_new  = Matrix::make(W, N, INT);
+        ref_ptr<Matrix> visited_prev  = Matrix::make(W, N, INT);
+        ref_ptr<Matrix> visited_new   = Matrix::make(W, N, INT);
+        ref_ptr<Scalar> zero          = Scalar::make_int(0);
+        int             current_level = 1;
+
+        // frontier words of each level, unpacked into levels at the end
+        struct Reached {
+            uint j;
+            int  bits;
+            int  level;
+        };
+
+        std::vector<std::vector<Reached>> reached(W);
+        std::vector<uint>                 Fi, Fj;
+        std::vector<int>                  Fx;
+
+        auto build = [](const ref_ptr<Matrix>& M, std::vector<uint>& Mi, std::vector<uint>& Mj, std::vector<int>& Mx) {
+            return M->build(MemView::make(Mi.data(), Mi.size() * sizeof(uint)),
+                            MemView::make(Mj.data(), Mj.size() * sizeof(uint)),
+                            MemView::make(Mx.data(), Mx.size() * sizeof(int)));
+        };
+
+        std::vector<std::tuple<uint, uint, int>> words;
+        for (uint i = 0; i < K; i++) {
+            words.emplace_back(i / BITS, sources[i], int(1u << (i % BITS)));
+        }
+        std::sort(words.begin(), words.end());
+        for (const auto& [w, j, bits] : words) {
+            if (!Fi.empty() && Fi.back() == w && Fj.back() == j) {
+                Fx.back() |= bits;
+                continue;
+            }
+            Fi.push_back(w);
+            Fj.push_back(j);
+            Fx.push_back(bits);
+        }
+        for (std::size_t k = 0; k < Fx.size(); k++) {
+            reached[Fi[k]].push_back({Fj[k], Fx[k], current_level});
+        }
+
+        build(frontier, Fi, Fj, Fx);
+        build(visited_prev, Fi, Fj, Fx);
+
+        // tasks are prepared once, visited sets are rebound on each iteration
+        ref_ptr<ScheduleTask> task_push, task_visit, task_new;
+        exec_mxm(frontier_new, frontier, A, FIRST_INT, BOR_INT, zero, descriptor, &task_push);
+        exec_m_eadd(visited_new, visited_prev, frontier_new, BOR_INT, ref_ptr<Descriptor>(), &task_visit);
+        exec_m_eadd(frontier, visited_new, visited_prev, BXOR_INT, ref_ptr<Descriptor>(), &task_new);
+
+#ifndef SPLA_RELEASE
+        std::cout << "start ms bfs from " << K << " sources" << std::endl;
+
+        Timer tight;
+#endif
+        while (!Fx.empty()) {
+#ifndef SPLA_RELEASE
+            tight.start();
+#endif
+            current_level += 1;
+
+            exec_task(task_push);
+            exec_task(task_visit);
+            exec_task(task_new);
+
+            // keep only words with newly visited bits, words are already ordered by row and column
+            ref_ptr<MemView> keys1, keys2, values;
+            frontier->read(keys1, keys2, values);
+
+            const auto  n_words = values->get_size() / sizeof(int);
+            const auto* Ri      = static_cast<const uint*>(keys1->get_buffer());
+            const auto* Rj      = static_cast<const uint*>(keys2->get_buffer());
+            const auto* Rx      = static_cast<const int*>(values->get_buffer());
+
+            Fi.clear();
+            Fj.clear();
+            Fx.clear();
+
+            for (std::size_t k = 0; k < n_words; k++) {
+                if (Rx[k] == 0) continue;
+                Fi.push_back(Ri[k]);
+                Fj.push_back(Rj[k]);
+                Fx.push_back(Rx[k]);
+                reached[Ri[k]].push_back({Rj[k], Rx[k], current_level});
+            }
+
+            build(frontier, Fi, Fj, Fx);
+
+#ifndef SPLA_RELEASE
+            tight.stop();
+            std::cout << " - iter " << current_level - 1
+                      << " front words " << Fx.size() << " "
+                      << tight.get_elapsed_ms() << " ms" << std::endl;
+#endif
+
+            std::swap(visited_prev, visited_new);
+
+            task_visit->set_arg(0, visited_new.as<Object>());
+            task_visit->set_arg(1, visited_prev.as<Object>());
+            task_new->set_arg(1, visited_new.as<Object>());
+            task_new->set_arg(2, visited_prev.as<Object>());
+        }
+
+        // unpack words of each row of frontier into dense rows of its sources to keep columns sorted
+        std::size_t total = 0;
+        for (const auto& list : reached) {
+            for (const Reached& entry : list) total += std::bitset<BITS>(std::uint32_t(entry.bits)).count();
+        }
+
+        std::vector<uint> Li(total), Lj(total);
+        std::vector<int>  Lx(total);
+        std::vector<int>  rows(std::size_t(std::min(BITS, K)) * N, 0);
+        std::size_t       k = 0;
+
+        for (uint w = 0; w < W; w++) {
+            const uint n_bits = std::min(BITS, K - w * BITS);
+
+            for (const Reached& entry : reached[w]) {
+                auto bits = static_cast<std::uint32_t>(entry.bits);
+                for (uint bit = 0; bits; bit++, bits >>= 1u) {
+                    if (bits & 1u) rows[std::size_t(bit) * N + entry.j] = entry.level;
+                }
+            }
+
+            for (uint bit = 0; bit < n_bits; bit++) {
+                int* row = rows.data() + std::size_t(bit) * N;
+
+                for (uint j = 0; j < N; j++) {
+                    if (row[j] == 0) continue;
+                    Li[k]  = w * BITS + bit;
+                    Lj[k]  = j;
+                    Lx[k]  = row[j];
+                    row[j] = 0;
+                    k += 1;
+                }
+            }
+        }
+
+        return build(levels, Li, Lj, Lx);
+    }
+
 #pragma endregion Bfs
 
 #pragma region Sssp
@@ -180,6 +421,12 @@ namespace spla {
         v->set_float(s, 0.0f);
         feedback->set_float(s, 0.0f);
 
+        ref_ptr<ScheduleTask> task_push, task_pull, task_fdb, task_count;
+        exec_vxm_masked(frontier, dummy_mask, feedback, A, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init, ref_ptr<Descriptor>(), &task_push);
+        exec_mxv_masked(frontier, dummy_mask, A, feedback, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init, ref_ptr<Descriptor>(), &task_pull);
+        exec_v_eadd_fdb(v, frontier, feedback, MIN_FLOAT, ref_ptr<Descriptor>(), &task_fdb);
+        exec_v_count_mf(feedback_size, feedback, ref_ptr<Descriptor>(), &task_count);
+
         bool  push         = descriptor->get_push_only();
         bool  pull         = descriptor->get_pull_only();
         bool  push_pull    = descriptor->get_push_pull();
@@ -205,13 +452,13 @@ namespace spla {
             bool  is_push_better = (front_density <= front_factor);
 
             if (push || (push_pull && is_push_better)) {
-                exec_vxm_masked(frontier, dummy_mask, feedback, A, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init);
+                exec_task(task_push);
             } else {
-                exec_mxv_masked(frontier, dummy_mask, A, feedback, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init);
+                exec_task(task_pull);
             }
 
-            exec_v_eadd_fdb(v, frontier, feedback, MIN_FLOAT);
-            exec_v_count_mf(feedback_size, feedback);
+            exec_task(task_fdb);
+            exec_task(task_count);
 
 #ifndef SPLA_RELEASE
             tight.stop();
@@ -228,6 +475,205 @@ namespace spla {
         return Status::Ok;
     }
 
+    Status sssp_delta(const ref_ptr<Vector>&     v,
+                      const ref_ptr<Matrix>&     A,
+                      uint                       s,
+                      float                      delta,
+                      const ref_ptr<Descriptor>& descriptor) {
+        assert(v);
+        assert(A);
+
+        const auto N   = v->get_n_rows();
+        const auto inf = std::numeric_limits<float>::max();
+
+        // edges are split once by weight, light ones may put target into current bucket
+        ref_ptr<MemView> keys1, keys2, values;
+        A->read(keys1, keys2, values);
+
+        const auto  n_edges = values->get_size() / sizeof(float);
+        const auto* Ri      = static_cast<const uint*>(keys1->get_buffer());
+        const auto* Rj      = static_cast<const uint*>(keys2->get_buffer());
+        const auto* Rx      = static_cast<const float*>(values->get_buffer());
+
+        // twice the mean weight was the best width on grids with uniform random weights
+        if (delta <= 0.0f) {
+            double total_weight = 0.0;
+            for (std::size_t k = 0; k < n_edges; k++) total_weight += Rx[k];
+            delta = total_weight > 0.0 ? float(2.0 * total_weight / double(n_edges)) : 1.0f;
+        }
+
+        std::size_t n_light = 0;
+        float       max_w   = 0.0f;
+        for (std::size_t k = 0; k < n_edges; k++) {
+            n_light += Rx[k] <= delta;
+            max_w = std::max(max_w, Rx[k]);
+        }
+
+        const bool has_light = n_light > 0;
+        const bool has_heavy = n_light < n_edges;
+
+        // no copy of matrix if all edges fall into one class, as for unit weights
+        ref_ptr<Matrix> A_light = A;
+        ref_ptr<Matrix> A_heavy = A;
+
+        if (has_light && has_heavy) {
+            std::vector<uint>  Li, Lj, Hi, Hj;
+            std::vector<float> Lx, Hx;
+
+            Li.reserve(n_light);
+            Lj.reserve(n_light);
+            Lx.reserve(n_light);
+            Hi.reserve(n_edges - n_light);
+            Hj.reserve(n_edges - n_light);
+            Hx.reserve(n_edges - n_light);
+
+            for (std::size_t k = 0; k < n_edges; k++) {
+                if (Rx[k] <= delta) {
+                    Li.push_back(Ri[k]);
+                    Lj.push_back(Rj[k]);
+                    Lx.push_back(Rx[k]);
+                } else {
+                    Hi.push_back(Ri[k]);
+                    Hj.push_back(Rj[k]);
+                    Hx.push_back(Rx[k]);
+                }
+            }
+
+            A_light = Matrix::make(N, N, FLOAT);
+            A_heavy = Matrix::make(N, N, FLOAT);
+            A_light->build(MemView::make(Li.data(), Li.size() * sizeof(uint)),
+                           MemView::make(Lj.data(), Lj.size() * sizeof(uint)),
+                           MemView::make(Lx.data(), Lx.size() * sizeof(float)));
+            A_heavy->build(MemView::make(Hi.data(), Hi.size() * sizeof(uint)),
+                           MemView::make(Hj.data(), Hj.size() * sizeof(uint)),
+                           MemView::make(Hx.data(), Hx.size() * sizeof(float)));
+        }
+
+        ref_ptr<Vector> dummy_mask = Vector::make(N, FLOAT);
+        ref_ptr<Vector> frontier   = Vector::make(N, FLOAT);
+        ref_ptr<Vector> relaxed    = Vector::make(N, FLOAT);
+        ref_ptr<Vector> feedback   = Vector::make(N, FLOAT);
+        ref_ptr<Scalar> inf_init   = Scalar::make_float(inf);
+
+        v->set_fill_value(inf_init);
+        relaxed->set_fill_value(inf_init);
+        feedback->set_fill_value(inf_init);
+
+        v->set_float(s, 0.0f);
+
+        // frontier is rebuilt in place for each phase, so tasks are prepared once and never rebound
+        ref_ptr<ScheduleTask> task_light, task_heavy, task_fdb;
+        exec_vxm_masked(relaxed, dummy_mask, frontier, A_light, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init, ref_ptr<Descriptor>(), &task_light);
+        exec_vxm_masked(relaxed, dummy_mask, frontier, A_heavy, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init, ref_ptr<Descriptor>(), &task_heavy);
+        exec_v_eadd_fdb(v, relaxed, feedback, MIN_FLOAT, ref_ptr<Descriptor>(), &task_fdb);
+
+        // buckets are kept on host as lists of improved vertices, entries become stale once vertex improves again;
+        // relaxation from bucket b reaches at most b + ceil(max_w / delta), so buckets are reused cyclically
+        using Entry = std::pair<uint, float>;
+
+        const auto n_buckets = std::size_t(std::ceil(max_w / delta)) + 1;
+
+        std::vector<float>              dist(N, inf);
+        std::vector<uint>               settled_in(has_heavy ? N : 0, 0);
+        std::vector<std::vector<Entry>> buckets(n_buckets);
+        std::vector<Entry>              current;
+        std::vector<uint>               settled, Fi;
+        std::vector<float>              Fx;
+        std::size_t                     bucket  = 0;
+        std::size_t                     pending = 1;
+
+        dist[s] = 0.0f;
+        buckets[0].emplace_back(s, 0.0f);
+
+        auto relax = [&](const ref_ptr<ScheduleTask>& task_relax) {
+            frontier->build(MemView::make(Fi.data(), Fi.size() * sizeof(uint)),
+                            MemView::make(Fx.data(), Fx.size() * sizeof(float)));
+            exec_task(task_relax);
+            exec_task(task_fdb);
+
+            ref_ptr<MemView> fdb_keys, fdb_values;
+            feedback->read(fdb_keys, fdb_values);
+
+            const auto  n_improved = fdb_values->get_size() / sizeof(float);
+            const auto* Ii         = static_cast<const uint*>(fdb_keys->get_buffer());
+            const auto* Ix         = static_cast<const float*>(fdb_values->get_buffer());
+
+            // clamped to the window of live buckets against rounding of division
+            for (std::size_t k = 0; k < n_improved; k++) {
+                const auto target = std::clamp(std::size_t(Ix[k] / delta), bucket, bucket + n_buckets - 1);
+                buckets[target % n_buckets].emplace_back(Ii[k], Ix[k]);
+                dist[Ii[k]] = Ix[k];
+                pending += 1;
+            }
+        };
+
+#ifndef SPLA_RELEASE
+        std::cout << "start delta-stepping sssp from " << s << " (delta " << delta << ")" << std::endl;
+
+        Timer tight;
+#endif
+        for (; pending > 0; bucket++) {
+            auto& entries = buckets[bucket % n_buckets];
+            if (entries.empty()) continue;
+#ifndef SPLA_RELEASE
+            tight.start();
+            int phases = 0;
+#endif
+            settled.clear();
+
+            // light phases until bucket is empty, improved vertices of the same bucket get back into it
+            while (!entries.empty()) {
+                current.clear();
+                std::swap(current, entries);
+                pending -= current.size();
+                std::sort(current.begin(), current.end());
+
+                Fi.clear();
+                Fx.clear();
+
+                for (const auto& [i, d] : current) {
+                    if (dist[i] != d) continue;
+                    Fi.push_back(i);
+                    Fx.push_back(d);
+
+                    if (has_heavy && settled_in[i] != bucket + 1) {
+                        settled_in[i] = uint(bucket + 1);
+                        settled.push_back(i);
+                    }
+                }
+
+                if (has_light && !Fi.empty()) relax(task_light);
+#ifndef SPLA_RELEASE
+                phases += 1;
+#endif
+            }
+
+            // heavy edges are relaxed once from final distances of the whole bucket
+            if (has_heavy && !settled.empty()) {
+                std::sort(settled.begin(), settled.end());
+
+                Fi.clear();
+                Fx.clear();
+
+                for (const uint i : settled) {
+                    Fi.push_back(i);
+                    Fx.push_back(dist[i]);
+                }
+
+                relax(task_heavy);
+            }
+
+#ifndef SPLA_RELEASE
+            tight.stop();
+            std::cout << " - bucket " << bucket
+                      << " settled " << settled.size() << " phases " << phases << " "
+                      << tight.get_elapsed_ms() << " ms" << std::endl;
+#endif
+        }
+
+        return Status::Ok;
+    }
+
     Status sssp_naive(std::vector<float>&              v,
                       std::vector<std::vector<uint>>&  Ai,
                       std::vector<std::vector<float>>& Ax,
@@ -296,6 +742,19 @@ namespace spla {
         addition->fill_with(Scalar::make_float((1.0f - alpha) / float(N)));
         p_prev->fill_with(Scalar::make_float(1.0f / float(N)));
 
+        ref_ptr<ScheduleTask> task_mxv, task_add, task_error, task_reduce;
+        exec_mxv_masked(p_tmp, dummy_mask, A, p_prev, MULT_FLOAT, PLUS_FLOAT, ALWAYS_FLOAT, zero, ref_ptr<Descriptor>(), &task_mxv);
+        exec_v_eadd(p, p_tmp, addition, PLUS_FLOAT, ref_ptr<Descriptor>(), &task_add);
+        exec_v_eadd(errors, p, p_prev, MINUS_POW2_FLOAT, ref_ptr<Descriptor>(), &task_error);
+        exec_v_reduce(error2, zero, errors, PLUS_FLOAT, ref_ptr<Descriptor>(), &task_reduce);
+
+        // element-wise add, error and reduce steps are fused by schedule into one pass
+        ref_ptr<Schedule> schedule = make_schedule();
+        schedule->step_task(task_mxv);
+        schedule->step_task(task_add);
+        schedule->step_task(task_error);
+        schedule->step_task(task_reduce);
+
         float error = eps + 0.1f;
 #ifndef SPLA_RELEASE
         int iter = 0;
@@ -309,17 +768,18 @@ namespace spla {
             tight.start();
 #endif
             // p = A*p + (1-alpha)/N
-            exec_mxv_masked(p_tmp, dummy_mask, A, p_prev, MULT_FLOAT, PLUS_FLOAT, ALWAYS_FLOAT, zero);
-            exec_v_eadd(p, p_tmp, addition, PLUS_FLOAT);
-
             // error = sqrt((p[01]-prev[0])^2 + ... + p[N-1]-prev[N-1])^2)
-            exec_v_eadd(errors, p, p_prev, MINUS_POW2_FLOAT);
-            exec_v_reduce(error2, zero, errors, PLUS_FLOAT);
+            schedule->submit();
 
             error = std::sqrt(error2->as_float());
 
             std::swap(p, p_prev);
 
+            task_mxv->set_arg(3, p_prev.as<Object>());
+            task_add->set_arg(0, p.as<Object>());
+            task_error->set_arg(1, p.as<Object>());
+            task_error->set_arg(2, p_prev.as<Object>());
+
 #ifndef SPLA_RELEASE
             tight.stop();
             std::cout << " - iter " << iter++
@@ -334,6 +794,204 @@ namespace spla {
         return Status::Ok;
     }
 
+    Status pr_delta(const ref_ptr<Vector>&     p,
+                    const ref_ptr<Matrix>&     A,
+                    float                      alpha,
+                    float                      eps,
+                    bool                       gauss_seidel,
+                    const ref_ptr<Descriptor>& descriptor) {
+        assert(p);
+        assert(A);
+
+        const auto N = p->get_n_rows();
+
+        // p = A*p + c is solved from p = 1/N as in pr: residual r = A*p + c - p of vertex is added to its rank and pushed
+        // along edges, vertex is active while its residual is above tol, so norm of residuals is below eps at exit
+        const float c   = (1.0f - alpha) / float(N);
+        const float x0  = 1.0f / float(N);
+        const float tol = eps / std::sqrt(float(N));
+
+        std::vector<float> x(N, x0);
+        std::vector<float> r(N, c - x0);
+        std::vector<uint>  active;
+
+#ifndef SPLA_RELEASE
+        int iter = 0;
+
+        std::cout << "start pr delta alpha=" << alpha << " eps " << eps << (gauss_seidel ? " (gauss-seidel)" : "") << std::endl;
+
+        Timer tight;
+#endif
+        if (gauss_seidel) {
+            // columns of A on host, residual of vertex j is pushed to rows i with A[i][j] != 0
+            ref_ptr<MemView> keys1, keys2, values;
+            A->read(keys1, keys2, values);
+
+            const auto  n_edges = values->get_size() / sizeof(float);
+            const auto* Ri      = static_cast<const uint*>(keys1->get_buffer());
+            const auto* Rj      = static_cast<const uint*>(keys2->get_buffer());
+            const auto* Rx      = static_cast<const float*>(values->get_buffer());
+
+            std::vector<std::size_t> Cp(N + 1, 0);
+            std::vector<uint>        Ci(n_edges);
+            std::vector<float>       Cx(n_edges);
+
+            for (std::size_t k = 0; k < n_edges; k++) Cp[Rj[k] + 1] += 1;
+            std::partial_sum(Cp.begin(), Cp.end(), Cp.begin());
+
+            std::vector<std::size_t> Cpos(Cp.begin(), Cp.end() - 1);
+            for (std::size_t k = 0; k < n_edges; k++) {
+                const std::size_t pos = Cpos[Rj[k]]++;
+                Ci[pos]               = Ri[k];
+                Cx[pos]               = Rx[k];
+            }
+
+            for (uint j = 0; j < N; j++) {
+                for (std::size_t k = Cp[j]; k < Cp[j + 1]; k++) r[Ci[k]] += Cx[k] * x0;
+            }
+            for (uint i = 0; i < N; i++) {
+                if (std::fabs(r[i]) > tol) active.push_back(i);
+            }
+
+            // vertex activated ahead of the cursor is pushed in the same sweep, behind it in the next one
+            std::vector<char> queued(N, 0);
+            for (const uint i : active) queued[i] = 1;
+
+            std::priority_queue<uint, std::vector<uint>, std::greater<>> sweep;
+
+            while (!active.empty()) {
+#ifndef SPLA_RELEASE
+                tight.start();
+                const std::size_t n_active = active.size();
+                std::size_t       n_pushed = 0;
+#endif
+                sweep = std::priority_queue<uint, std::vector<uint>, std::greater<>>(std::greater<>(), std::move(active));
+                active.clear();
+
+                while (!sweep.empty()) {
+                    const uint j = sweep.top();
+                    sweep.pop();
+
+                    const float rj = r[j];
+                    queued[j]      = 0;
+                    x[j] += rj;
+                    r[j] = 0.0f;
+
+                    for (std::size_t k = Cp[j]; k < Cp[j + 1]; k++) {
+                        const uint i = Ci[k];
+                        r[i] += Cx[k] * rj;
+
+                        if (!queued[i] && std::fabs(r[i]) > tol) {
+                            queued[i] = 1;
+                            if (i > j) {
+                                sweep.push(i);
+                            } else {
+                                active.push_back(i);
+                            }
+                        }
+                    }
+#ifndef SPLA_RELEASE
+                    n_pushed += 1;
+#endif
+                }
+
+#ifndef SPLA_RELEASE
+                tight.stop();
+                std::cout << " - sweep " << iter++
+                          << " active " << n_active << " pushed " << n_pushed << " "
+                          << tight.get_elapsed_ms() << " ms" << std::endl;
+#endif
+            }
+        } else {
+            ref_ptr<Vector> dummy_mask = Vector::make(N, FLOAT);
+            ref_ptr<Vector> frontier   = Vector::make(N, FLOAT);
+            ref_ptr<Vector> pushed     = Vector::make(N, FLOAT);
+            ref_ptr<Scalar> zero       = Scalar::make_float(0.0f);
+            ref_ptr<Matrix> AT;
+
+            // transposed matrix for push is made only once active set becomes sparse
+            ref_ptr<ScheduleTask> task_pull, task_push;
+            exec_mxv_masked(pushed, dummy_mask, A, frontier, MULT_FLOAT, PLUS_FLOAT, ALWAYS_FLOAT, zero, ref_ptr<Descriptor>(), &task_pull);
+
+            const float front_factor = descriptor ? descriptor->get_front_factor() : 0.1f;
+
+            std::vector<uint>  Fi;
+            std::vector<float> Fx;
+
+            // r += A * f for frontier f given by Fi and Fx, vertices with residual above tol become active
+            auto push = [&](bool is_push) {
+                if (is_push && !task_push) {
+                    AT = Matrix::make(N, N, FLOAT);
+                    exec_m_transpose(AT, A, IDENTITY_FLOAT);
+                    exec_vxm_masked(pushed, dummy_mask, frontier, AT, MULT_FLOAT, PLUS_FLOAT, ALWAYS_FLOAT, zero, ref_ptr<Descriptor>(), &task_push);
+                }
+
+                frontier->build(MemView::make(Fi.data(), Fi.size() * sizeof(uint)),
+                                MemView::make(Fx.data(), Fx.size() * sizeof(float)));
+                exec_task(is_push ? task_push : task_pull);
+
+                ref_ptr<MemView> pushed_keys, pushed_values;
+                pushed->read(pushed_keys, pushed_values);
+
+                const auto  n_pushed = pushed_values->get_size() / sizeof(float);
+                const auto* Pi       = static_cast<const uint*>(pushed_keys->get_buffer());
+                const auto* Px       = static_cast<const float*>(pushed_values->get_buffer());
+
+                for (std::size_t k = 0; k < n_pushed; k++) {
+                    const uint i = Pi[k];
+                    r[i] += Px[k];
+                    if (std::fabs(r[i]) > tol) active.push_back(i);
+                }
+            };
+
+            Fi.resize(N);
+            Fx.assign(N, x0);
+            std::iota(Fi.begin(), Fi.end(), 0u);
+            push(false);
+
+            // vertices not reached by first product may have residual above tol as well
+            active.clear();
+            for (uint i = 0; i < N; i++) {
+                if (std::fabs(r[i]) > tol) active.push_back(i);
+            }
+
+            while (!active.empty()) {
+#ifndef SPLA_RELEASE
+                tight.start();
+                const std::size_t n_active = active.size();
+#endif
+                const bool is_push = float(active.size()) <= front_factor * float(N);
+
+                std::swap(Fi, active);
+                active.clear();
+
+                Fx.resize(Fi.size());
+                for (std::size_t k = 0; k < Fi.size(); k++) {
+                    const uint i = Fi[k];
+                    Fx[k]        = r[i];
+                    x[i] += r[i];
+                    r[i] = 0.0f;
+                }
+
+                // vertices not reached by push keep residual below tol
+                push(is_push);
+
+#ifndef SPLA_RELEASE
+                tight.stop();
+                std::cout << " - iter " << iter++
+                          << " active " << n_active << (is_push ? " push " : " pull ")
+                          << tight.get_elapsed_ms() << " ms" << std::endl;
+#endif
+            }
+        }
+
+        std::vector<uint> keys(N);
+        std::iota(keys.begin(), keys.end(), 0u);
+
+        return p->build(MemView::make(keys.data(), keys.size() * sizeof(uint)),
+                        MemView::make(x.data(), x.size() * sizeof(float)));
+    }
+
     Status pr_naive(std::vector<float>&              p,
                     std::vector<std::vector<uint>>&  Ai,
                     std::vector<std::vector<float>>& Ax,
@@ -378,16 +1036,21 @@ namespace spla {
 #pragma region Tc
 
     Status tc(
-            int&                       ntrins,
-            const ref_ptr<Matrix>&     A,
-            const ref_ptr<Matrix>&     B,
-            const ref_ptr<Descriptor>& descriptor) {
+            int&                                    ntrins,
+            const ref_ptr<Matrix>&                  A,
+            [[maybe_unused]] const ref_ptr<Matrix>& B,
+            const ref_ptr<Descriptor>&              descriptor) {
         assert(A);
-        assert(B);
+
+        const auto N = A->get_n_rows();
 
         ref_ptr<Scalar> zero   = Scalar::make_int(0);
         ref_ptr<Scalar> result = Scalar::make(INT);
 
+        ref_ptr<Descriptor> desc = Descriptor::make();
+        desc->set_struct_only(true);
+        if (descriptor) desc->set_threads_count(descriptor->get_threads_count());
+
 #ifndef SPLA_RELEASE
         std::cout << "start tc" << std::endl;
 
@@ -395,8 +1058,68 @@ namespace spla {
         tight.start();
 #endif
 
-        spla::exec_mxmT_masked(B, A, A, A, MULT_INT, PLUS_INT, GTZERO_INT, zero);
-        spla::exec_m_reduce(result, zero, B, PLUS_INT);
+        ref_ptr<MemView> keys1, keys2, values;
+        A->read(keys1, keys2, values);
+
+        const auto  n_values = values->get_size() / sizeof(int);
+        const auto* Ri       = static_cast<const uint*>(keys1->get_buffer());
+        const auto* Rj       = static_cast<const uint*>(keys2->get_buffer());
+        const auto* Rx       = static_cast<const int*>(values->get_buffer());
+
+        // vertices are relabeled by decreasing degree, so row of L keeps only neighbors
+        // of higher degree and hubs get short rows instead of the longest ones
+        std::vector<uint> degree(N, 0);
+        for (std::size_t k = 0; k < n_values; k++) {
+            if (Rx[k] == 0 || Ri[k] == Rj[k]) continue;
+            degree[Ri[k]] += 1;
+            degree[Rj[k]] += 1;
+        }
+
+        std::vector<uint> order(N), rank(N);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint a, uint b) { return degree[a] > degree[b]; });
+        for (uint k = 0; k < N; k++) rank[order[k]] = k;
+
+        // each edge is stored once in row of its end with larger rank, as for lower triangle
+        std::vector<uint> Lp(N + 1, 0);
+        for (std::size_t k = 0; k < n_values; k++) {
+            if (Rx[k] == 0 || Ri[k] == Rj[k]) continue;
+            Lp[std::max(rank[Ri[k]], rank[Rj[k]]) + 1] += 1;
+        }
+        for (uint i = 0; i < N; i++) Lp[i + 1] += Lp[i];
+
+        std::vector<uint> Lj(Lp[N]), pos(Lp.begin(), Lp.end() - 1);
+        for (std::size_t k = 0; k < n_values; k++) {
+            if (Rx[k] == 0 || Ri[k] == Rj[k]) continue;
+            const uint a = rank[Ri[k]];
+            const uint b = rank[Rj[k]];
+            Lj[pos[std::max(a, b)]++] = std::min(a, b);
+        }
+
+        // rows are sorted and deduplicated, so both directions of an edge may be passed in A
+        std::vector<uint> Li;
+        std::size_t       n_edges = 0;
+        Li.reserve(Lj.size());
+        for (uint i = 0; i < N; i++) {
+            std::sort(Lj.begin() + Lp[i], Lj.begin() + Lp[i + 1]);
+            for (uint k = Lp[i]; k < Lp[i + 1]; k++) {
+                if (k > Lp[i] && Lj[k] == Lj[k - 1]) continue;
+                Lj[n_edges++] = Lj[k];
+                Li.push_back(i);
+            }
+        }
+        Lj.resize(n_edges);
+
+        std::vector<int> Lx(n_edges, 1);
+        ref_ptr<Matrix>  L = Matrix::make(N, N, INT);
+        L->build(MemView::make(Li.data(), Li.size() * sizeof(uint)),
+                 MemView::make(Lj.data(), Lj.size() * sizeof(uint)),
+                 MemView::make(Lx.data(), Lx.size() * sizeof(int)));
+
+        // each triangle is counted once at its edge between two vertices of larger rank
+        // fails if number of triangles does not fit into int
+        const Status status = spla::exec_mxmT_masked_reduce(result, zero, L, L, L, MULT_INT, PLUS_INT, GTZERO_INT, desc);
+        if (status != Status::Ok) return status;
 
         ntrins = result->as_int();
 
@@ -449,4 +1172,132 @@ namespace spla {
 
 #pragma endregion Pr
 
+#pragma region Cc
+
+    Status cc(const ref_ptr<Vector>&     v,
+              const ref_ptr<Matrix>&     A,
+              const ref_ptr<Descriptor>& descriptor) {
+        assert(v);
+        assert(A);
+
+        const auto N = v->get_n_rows();
+
+        // labels are vertex ids, so N stands for missing neighbour in min products and is never read back
+        ref_ptr<Scalar> none       = Scalar::make_int(int(N));
+        ref_ptr<Vector> dummy_mask = Vector::make(N, INT);
+        ref_ptr<Vector> gf_vec     = Vector::make(N, INT);
+        ref_ptr<Vector> mngf       = Vector::make(N, INT);
+        ref_ptr<Vector> hooked     = Vector::make(N, INT);
+
+        gf_vec->set_fill_value(none);
+        mngf->set_fill_value(none);
+        hooked->set_fill_value(none);
+
+        // mngf[i] = min gf[j] over neighbours j of i, hooked = min(f, mngf, gf) = min(mngf, gf) since gf <= f
+        ref_ptr<ScheduleTask> task_mngf, task_hooked;
+        exec_mxv_masked(mngf, dummy_mask, A, gf_vec, SECOND_INT, MIN_INT, ALWAYS_INT, none, ref_ptr<Descriptor>(), &task_mngf);
+        exec_v_eadd(hooked, mngf, gf_vec, MIN_INT, ref_ptr<Descriptor>(), &task_hooked);
+
+        ref_ptr<Schedule> schedule = make_schedule();
+        schedule->step_task(task_mngf);
+        schedule->step_task(task_hooked);
+
+        std::vector<uint> keys(N);
+        std::vector<int>  f(N), f_prev(N), gf(N);
+
+        std::iota(keys.begin(), keys.end(), 0u);
+        std::iota(f.begin(), f.end(), 0);
+        gf = f;
+
+        bool changed = true;
+#ifndef SPLA_RELEASE
+        int iter = 0;
+
+        std::cout << "start cc" << std::endl;
+
+        Timer tight;
+#endif
+        while (changed) {
+#ifndef SPLA_RELEASE
+            tight.start();
+#endif
+            gf_vec->build(MemView::make(keys.data(), keys.size() * sizeof(uint)),
+                          MemView::make(gf.data(), gf.size() * sizeof(int)));
+            schedule->submit();
+
+            ref_ptr<MemView> mngf_keys, mngf_values, hooked_keys, hooked_values;
+            mngf->read(mngf_keys, mngf_values);
+            hooked->read(hooked_keys, hooked_values);
+
+            const auto  n_mngf   = mngf_values->get_size() / sizeof(int);
+            const auto  n_hooked = hooked_values->get_size() / sizeof(int);
+            const auto* Mi       = static_cast<const uint*>(mngf_keys->get_buffer());
+            const auto* Mx       = static_cast<const int*>(mngf_values->get_buffer());
+            const auto* Hi       = static_cast<const uint*>(hooked_keys->get_buffer());
+            const auto* Hx       = static_cast<const int*>(hooked_values->get_buffer());
+
+            f_prev = f;
+
+            // aggressive hooking and shortcutting
+            for (std::size_t k = 0; k < n_hooked; k++) f[Hi[k]] = Hx[k];
+
+            // stochastic hooking f[f[i]] = min(f[f[i]], mngf[i]) scatters by labels, which has no op, so it is done on host
+            for (std::size_t k = 0; k < n_mngf; k++) {
+                const int p = f_prev[Mi[k]];
+                f[p]        = std::min(f[p], Mx[k]);
+            }
+
+            // grandparents, labels are stable once they stop changing
+            changed = false;
+            for (uint i = 0; i < N; i++) {
+                const int g = f[f[i]];
+                changed |= g != gf[i];
+                gf[i] = g;
+            }
+
+#ifndef SPLA_RELEASE
+            tight.stop();
+            std::cout << " - iter " << iter++ << " " << tight.get_elapsed_ms() << " ms" << std::endl;
+#endif
+        }
+
+        return v->build(MemView::make(keys.data(), keys.size() * sizeof(uint)),
+                        MemView::make(f.data(), f.size() * sizeof(int)));
+    }
+
+    Status cc_naive(std::vector<int>&                     v,
+                    std::vector<std::vector<spla::uint>>& A,
+                    const ref_ptr<Descriptor>&            descriptor) {
+
+        const auto N = v.size();
+
+        std::queue<uint>  front;
+        std::vector<bool> visited(N, false);
+
+        for (uint s = 0; s < N; s++) {
+            if (visited[s]) continue;
+
+            front.push(s);
+            visited[s] = true;
+            v[s]       = int(s);
+
+            while (!front.empty()) {
+                auto i = front.front();
+                front.pop();
+
+                for (auto j : A[i]) {
+                    if (!visited[j]) {
+                        visited[j] = true;
+                        v[j]       = int(s);
+                        front.push(j);
+                    }
+                }
+            }
+        }
+
+        return Status::Ok;
+    }
+
+#pragma endregion Cc
+
 }// namespace spla
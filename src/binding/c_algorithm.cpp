@@ -30,9 +30,16 @@
 spla_Status spla_Algorithm_bfs(spla_Vector v, spla_Matrix A, spla_uint s, spla_Descriptor descriptor) {
     return to_c_status(spla::bfs(as_ref<spla::Vector>(v), as_ref<spla::Matrix>(A), s, as_ref<spla::Descriptor>(descriptor)));
 }
+spla_Status spla_Algorithm_ms_bfs(spla_Matrix levels, spla_Matrix A, const spla_uint* sources, spla_uint n_sources, spla_Descriptor descriptor) {
+    std::vector<spla::uint> sources_vec(sources, sources + n_sources);
+    return to_c_status(spla::ms_bfs(as_ref<spla::Matrix>(levels), as_ref<spla::Matrix>(A), sources_vec, as_ref<spla::Descriptor>(descriptor)));
+}
 spla_Status spla_Algorithm_sssp(spla_Vector v, spla_Matrix A, spla_uint s, spla_Descriptor descriptor) {
     return to_c_status(spla::sssp(as_ref<spla::Vector>(v), as_ref<spla::Matrix>(A), s, as_ref<spla::Descriptor>(descriptor)));
 }
+spla_Status spla_Algorithm_sssp_delta(spla_Vector v, spla_Matrix A, spla_uint s, float delta, spla_Descriptor descriptor) {
+    return to_c_status(spla::sssp_delta(as_ref<spla::Vector>(v), as_ref<spla::Matrix>(A), s, delta, as_ref<spla::Descriptor>(descriptor)));
+}
 spla_Status spla_Algorithm_pr(spla_Vector* p, spla_Matrix A, float alpha, float eps, spla_Descriptor descriptor) {
     spla::ref_ptr<spla::Vector> p_inout;
     p_inout.reset(as_ptr<spla::Vector>(*p));
@@ -46,6 +53,12 @@ spla_Status spla_Algorithm_pr(spla_Vector* p, spla_Matrix A, float alpha, float
 
     return to_c_status(status);
 }
+spla_Status spla_Algorithm_pr_delta(spla_Vector p, spla_Matrix A, float alpha, float eps, spla_bool gauss_seidel, spla_Descriptor descriptor) {
+    return to_c_status(spla::pr_delta(as_ref<spla::Vector>(p), as_ref<spla::Matrix>(A), alpha, eps, gauss_seidel, as_ref<spla::Descriptor>(descriptor)));
+}
 spla_Status spla_Algorithm_tc(int* ntrins, spla_Matrix A, spla_Matrix B, spla_Descriptor descriptor) {
     return to_c_status(spla::tc(*ntrins, as_ref<spla::Matrix>(A), as_ref<spla::Matrix>(B), as_ref<spla::Descriptor>(descriptor)));
+}
+spla_Status spla_Algorithm_cc(spla_Vector v, spla_Matrix A, spla_Descriptor descriptor) {
+    return to_c_status(spla::cc(as_ref<spla::Vector>(v), as_ref<spla::Matrix>(A), as_ref<spla::Descriptor>(descriptor)));
 }
\ No newline at end of file
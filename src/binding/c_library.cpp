@@ -81,3 +81,11 @@ spla_Status spla_Library_get_accelerator_info(char* buffer, int length) {
 
     return to_c_status(status);
 }
+
+spla_Status spla_Library_set_cpu_threads(int count) {
+    return to_c_status(spla::Library::get()->set_cpu_threads(count));
+}
+
+spla_Status spla_Library_set_cpu_pinning(spla_bool value) {
+    return to_c_status(spla::Library::get()->set_cpu_pinning(value != 0));
+}
@@ -77,4 +77,27 @@ spla_Status spla_Matrix_read(spla_Matrix M, spla_MemView* keys1, spla_MemView* k
 }
 spla_Status spla_Matrix_clear(spla_Matrix M) {
     return to_c_status(as_ptr<spla::Matrix>(M)->clear());
-}
\ No newline at end of file
+}
+spla_Status spla_Matrix_save_snapshot(spla_Matrix M, const char* file_path) {
+    return to_c_status(as_ptr<spla::Matrix>(M)->save_snapshot(file_path));
+}
+spla_Status spla_Matrix_load_snapshot(spla_Matrix* M, const char* file_path) {
+    auto loaded = spla::Matrix::load_snapshot(file_path);
+    if (!loaded) {
+        return SPLA_STATUS_ERROR;
+    }
+    *M = as_ptr<spla_Matrix_t>(loaded.release());
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_Matrix_get_n_rows(spla_Matrix M, spla_uint* n_rows) {
+    *n_rows = as_ptr<spla::Matrix>(M)->get_n_rows();
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_Matrix_get_n_cols(spla_Matrix M, spla_uint* n_cols) {
+    *n_cols = as_ptr<spla::Matrix>(M)->get_n_cols();
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_Matrix_get_type(spla_Matrix M, spla_Type* type) {
+    *type = as_ptr<spla_Type_t>(as_ptr<spla::Matrix>(M)->get_type().get());
+    return SPLA_STATUS_OK;
+}
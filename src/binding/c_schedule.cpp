@@ -0,0 +1,71 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "c_config.hpp"
+
+static spla::ScheduleType from_c_schedule_type(spla_ScheduleType type) {
+    return static_cast<spla::ScheduleType>(type);
+}
+
+spla_Status spla_Schedule_make(spla_Schedule* schedule, spla_ScheduleType type, spla_uint workers_count) {
+    auto sched = spla::make_schedule(from_c_schedule_type(type), workers_count);
+    *schedule  = as_ptr<spla_Schedule_t>(sched.release());
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_Schedule_step_task(spla_Schedule schedule, spla_ScheduleTask task) {
+    return to_c_status(as_ptr<spla::Schedule>(schedule)->step_task(as_ref<spla::ScheduleTask>(task)));
+}
+spla_Status spla_Schedule_submit(spla_Schedule schedule) {
+    return to_c_status(as_ptr<spla::Schedule>(schedule)->submit());
+}
+spla_Status spla_Schedule_submit_async(spla_Schedule schedule, spla_ScheduleFuture* future) {
+    auto fut = as_ptr<spla::Schedule>(schedule)->submit_async();
+    *future  = as_ptr<spla_ScheduleFuture_t>(fut.release());
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_Schedule_get_task_status(spla_Schedule schedule, int step_id, int task_id) {
+    return to_c_status(as_ptr<spla::Schedule>(schedule)->get_task_status(step_id, task_id));
+}
+
+spla_Status spla_ScheduleFuture_wait(spla_ScheduleFuture future) {
+    return to_c_status(as_ptr<spla::ScheduleFuture>(future)->wait());
+}
+spla_Status spla_ScheduleFuture_wait_for(spla_ScheduleFuture future, spla_uint timeout_ms, spla_bool* is_done) {
+    *is_done = as_ptr<spla::ScheduleFuture>(future)->wait_for(timeout_ms);
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_ScheduleFuture_is_done(spla_ScheduleFuture future, spla_bool* is_done) {
+    *is_done = as_ptr<spla::ScheduleFuture>(future)->is_done();
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_ScheduleFuture_on_complete(spla_ScheduleFuture future, spla_ScheduleCompleteCallback callback, void* p_user_data) {
+    if (!callback) return SPLA_STATUS_INVALID_ARGUMENT;
+    auto wrapped_callback = [=](spla::Status status) {
+        callback(to_c_status(status), p_user_data);
+    };
+    return to_c_status(as_ptr<spla::ScheduleFuture>(future)->on_complete(wrapped_callback));
+}
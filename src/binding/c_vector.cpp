@@ -75,4 +75,23 @@ spla_Status spla_Vector_read(spla_Vector v, spla_MemView* keys, spla_MemView* va
 }
 spla_Status spla_Vector_clear(spla_Vector v) {
     return to_c_status(as_ptr<spla::Vector>(v)->clear());
-}
\ No newline at end of file
+}
+spla_Status spla_Vector_save_snapshot(spla_Vector v, const char* file_path) {
+    return to_c_status(as_ptr<spla::Vector>(v)->save_snapshot(file_path));
+}
+spla_Status spla_Vector_load_snapshot(spla_Vector* v, const char* file_path) {
+    auto loaded = spla::Vector::load_snapshot(file_path);
+    if (!loaded) {
+        return SPLA_STATUS_ERROR;
+    }
+    *v = as_ptr<spla_Vector_t>(loaded.release());
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_Vector_get_n_rows(spla_Vector v, spla_uint* n_rows) {
+    *n_rows = as_ptr<spla::Vector>(v)->get_n_rows();
+    return SPLA_STATUS_OK;
+}
+spla_Status spla_Vector_get_type(spla_Vector v, spla_Type* type) {
+    *type = as_ptr<spla_Type_t>(as_ptr<spla::Vector>(v)->get_type().get());
+    return SPLA_STATUS_OK;
+}
@@ -31,6 +31,9 @@
 #include <core/logger.hpp>
 #include <core/registry.hpp>
 
+#include <schedule/schedule_tasks.hpp>
+#include <storage/storage_residency.hpp>
+
 #include <cstdlib>
 
 #if defined(SPLA_BUILD_OPENCL)
@@ -39,26 +42,42 @@
 
 namespace spla {
 
+    // layout of task dispatch cache: registry version, acc usage flag, acc algo flag, algo id
+    static constexpr std::uint64_t DISPATCH_CACHE_USE_ACC = 1ull << 31u;
+    static constexpr std::uint64_t DISPATCH_CACHE_IS_ACC  = 1ull << 30u;
+    static constexpr std::uint64_t DISPATCH_CACHE_ID_MASK = DISPATCH_CACHE_IS_ACC - 1;
+
     Status Dispatcher::dispatch(const DispatchContext& ctx) {
         Library*     g_lib        = Library::get();
         Registry*    g_reg        = g_lib->get_registry();
         Accelerator* g_acc        = g_lib->get_accelerator();
         bool         force_no_acc = g_lib->is_set_force_no_acceleration();
+        bool         use_acc      = g_acc && !force_no_acc;
 
-        std::shared_ptr<RegistryAlgo> algo;
-        std::string                   key = ctx.task->get_key();
+        auto*         task_base = dynamic_cast<ScheduleTaskBase*>(ctx.task.get());
+        std::uint64_t tag       = (std::uint64_t(g_reg->get_version()) << 32u) | (use_acc ? DISPATCH_CACHE_USE_ACC : 0);
+        int           algo_id   = -1;
+        bool          is_acc    = false;
 
-        if (g_acc && !force_no_acc) {
-            std::string key_acc = key + g_acc->get_suffix();
-            algo                = g_reg->find(key_acc);
+        // re-dispatch of the same task does no string work while library setup is not changed
+        std::uint64_t cached = task_base ? task_base->dispatch_cache.load(std::memory_order_relaxed) : 0;
+        if (cached && (cached & ~(DISPATCH_CACHE_IS_ACC | DISPATCH_CACHE_ID_MASK)) == tag) {
+            algo_id = int(cached & DISPATCH_CACHE_ID_MASK);
+            is_acc  = (cached & DISPATCH_CACHE_IS_ACC) != 0;
+        } else {
+            algo_id = resolve(ctx, g_reg, use_acc ? g_acc : nullptr, is_acc);
+            if (task_base && algo_id >= 0) {
+                task_base->dispatch_cache.store(tag | (is_acc ? DISPATCH_CACHE_IS_ACC : 0) | std::uint64_t(algo_id), std::memory_order_relaxed);
+            }
         }
 
-        if (!algo) {
-            std::string key_cpu = key + CPU_SUFFIX;
-            algo                = g_reg->find(key_cpu);
-        }
+        RegistryAlgo*                algo = algo_id >= 0 ? g_reg->get(algo_id) : nullptr;
+        std::unique_lock<std::mutex> acc_lock(m_acc_mutex, std::defer_lock);
+        if (is_acc) acc_lock.lock();
 
         if (algo) {
+            StorageResidencyTaskScope residency_scope(g_lib->get_storage_residency());
+
             try {
                 return algo->execute(ctx);
             }
@@ -80,8 +99,24 @@ namespace spla {
             }
         }
 
-        LOG_MSG(Status::NotImplemented, "failed to find suitable algo for key " << key);
+        LOG_MSG(Status::NotImplemented, "failed to find suitable algo for key " << ctx.task->get_key());
         return Status::NotImplemented;
     }
 
+    int Dispatcher::resolve(const DispatchContext& ctx, Registry* g_reg, Accelerator* g_acc, bool& is_acc) {
+        std::string key = ctx.task->get_key();
+        int         id  = -1;
+
+        if (g_acc) {
+            id     = g_reg->find_id(key + g_acc->get_suffix());
+            is_acc = id >= 0;
+        }
+
+        if (id < 0) {
+            id = g_reg->find_id(key + CPU_SUFFIX);
+        }
+
+        return id;
+    }
+
 }// namespace spla
\ No newline at end of file
@@ -32,6 +32,8 @@
 
 #include <core/registry.hpp>
 
+#include <mutex>
+
 namespace spla {
 
     /**
@@ -59,6 +61,12 @@ namespace spla {
     public:
         virtual ~Dispatcher() = default;
         virtual Status dispatch(const DispatchContext& ctx);
+
+    private:
+        int resolve(const DispatchContext& ctx, class Registry* g_reg, class Accelerator* g_acc, bool& is_acc);
+
+    private:
+        std::mutex m_acc_mutex;// accelerator queues are not safe for concurrent tasks
     };
 
     /**
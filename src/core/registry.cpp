@@ -30,16 +30,36 @@
 namespace spla {
 
     void Registry::add(const std::string& key, std::shared_ptr<RegistryAlgo> algo) {
-        m_registry[key] = std::move(algo);
+        auto entry = m_ids.find(key);
+        if (entry != m_ids.end()) {
+            m_algos[entry->second] = std::move(algo);
+        } else {
+            m_ids[key] = static_cast<int>(m_algos.size());
+            m_algos.push_back(std::move(algo));
+        }
+        m_version += 1;
     }
 
     bool Registry::has(const std::string& key) {
-        return m_registry.find(key) != m_registry.end();
+        return m_ids.find(key) != m_ids.end();
     }
 
     std::shared_ptr<RegistryAlgo> Registry::find(const std::string& key) {
-        auto entry = m_registry.find(key);
-        return entry != m_registry.end() ? entry->second : std::shared_ptr<RegistryAlgo>();
+        auto entry = m_ids.find(key);
+        return entry != m_ids.end() ? m_algos[entry->second] : std::shared_ptr<RegistryAlgo>();
+    }
+
+    int Registry::find_id(const std::string& key) {
+        auto entry = m_ids.find(key);
+        return entry != m_ids.end() ? entry->second : -1;
+    }
+
+    RegistryAlgo* Registry::get(int id) {
+        return m_algos[id].get();
+    }
+
+    std::uint32_t Registry::get_version() {
+        return m_version;
     }
 
 }// namespace spla
@@ -33,7 +33,10 @@
 
 #include <robin_hood.hpp>
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace spla {
 
@@ -74,6 +77,10 @@ namespace spla {
     /**
      * @class Registry
      * @brief Registry with key-algo mapping of stored algo implementations
+     *
+     * Each key gets compact integer id on registration, and algos are stored in a flat array
+     * indexed by id. Id of a key can be resolved once and cached by a caller, then algo lookup
+     * needs no string work. Cached ids are valid while registry version is not changed.
      */
     class Registry {
     public:
@@ -81,9 +88,14 @@ namespace spla {
         virtual void                          add(const std::string& key, std::shared_ptr<RegistryAlgo> algo);
         virtual bool                          has(const std::string& key);
         virtual std::shared_ptr<RegistryAlgo> find(const std::string& key);
+        virtual int                           find_id(const std::string& key);
+        virtual RegistryAlgo*                 get(int id);
+        virtual std::uint32_t                 get_version();
 
     private:
-        robin_hood::unordered_flat_map<std::string, std::shared_ptr<RegistryAlgo>> m_registry;
+        robin_hood::unordered_flat_map<std::string, int> m_ids;
+        std::vector<std::shared_ptr<RegistryAlgo>>       m_algos;
+        std::uint32_t                                    m_version = 1;
     };
 
     /**
@@ -32,9 +32,16 @@
 
 #include <array>
 #include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
 
 namespace spla {
 
+    class StorageResidency;
+
     /**
      * @addtogroup internal
      * @{
@@ -54,6 +61,12 @@ namespace spla {
         /** @return Number of value in decoration */
         [[nodiscard]] virtual uint get_n_values() const { return values; }
 
+        /** @return Estimated number of bytes of memory held by decoration */
+        [[nodiscard]] virtual std::size_t get_memory_usage() const { return 0; }
+
+        /** @brief Frees memory held by decoration data, keeping its settings */
+        virtual void release() {}
+
     public:
         uint values = 0;
     };
@@ -82,6 +95,35 @@ namespace spla {
         [[nodiscard]] bool is_valid(F format) const { return is_valid_i(static_cast<int>(format)); }
         void               validate(F format) { m_is_valid.set(static_cast<int>(format), true); }
         void               invalidate() { m_is_valid.reset(); }
+        void               invalidate_i(int index) { m_is_valid.reset(index); }
+
+        /** Marks format as used now by task with `epoch` id for least recently used eviction */
+        void touch_i(int index, std::uint64_t epoch) {
+            m_last_used[index]  = ++m_tick;
+            m_last_epoch[index] = epoch;
+        }
+        [[nodiscard]] std::uint64_t get_last_used_i(int index) const { return m_last_used[index]; }
+        [[nodiscard]] std::uint64_t get_last_epoch_i(int index) const { return m_last_epoch[index]; }
+
+        [[nodiscard]] std::size_t get_memory_usage() const {
+            std::size_t bytes = 0;
+            for (const auto& decoration : m_decorations) {
+                if (decoration) bytes += decoration->get_memory_usage();
+            }
+            return bytes;
+        }
+
+        void                      set_memory_budget(std::size_t bytes) { m_memory_budget = bytes; }
+        [[nodiscard]] std::size_t get_memory_budget() const { return m_memory_budget; }
+        void                      set_memory_accounted(std::size_t bytes) { m_memory_accounted = bytes; }
+        [[nodiscard]] std::size_t get_memory_accounted() const { return m_memory_accounted; }
+
+        /** Residency tracking, where memory of this storage is accounted */
+        void                                                   set_residency(std::shared_ptr<StorageResidency> residency) { m_residency = std::move(residency); }
+        [[nodiscard]] const std::shared_ptr<StorageResidency>& get_residency() const { return m_residency; }
+
+        /** Guards conversions of storage, when object is shared by concurrently executed tasks */
+        std::mutex& get_mutex() { return m_mutex; }
 
         void set_fill_value(T value) { m_fill_value = value; }
         T    get_fill_value() const { return m_fill_value; }
@@ -97,9 +139,16 @@ namespace spla {
     private:
         std::array<ref_ptr<TDecoration<T>>, capacity> m_decorations;
         std::bitset<capacity>                         m_is_valid;
-        uint                                          m_n_rows     = 0;
-        uint                                          m_n_cols     = 0;
-        T                                             m_fill_value = T();
+        std::array<std::uint64_t, capacity>           m_last_used{};
+        std::array<std::uint64_t, capacity>           m_last_epoch{};
+        std::uint64_t                                 m_tick             = 0;
+        std::size_t                                   m_memory_budget    = 0;
+        std::size_t                                   m_memory_accounted = 0;
+        std::shared_ptr<StorageResidency>             m_residency;
+        uint                                          m_n_rows           = 0;
+        uint                                          m_n_cols           = 0;
+        T                                             m_fill_value       = T();
+        std::mutex                                    m_mutex;
     };
 
     /**
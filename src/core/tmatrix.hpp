@@ -37,6 +37,8 @@
 #include <core/top.hpp>
 #include <core/ttype.hpp>
 
+#include <cpu/cpu_format_snapshot.hpp>
+
 #include <storage/storage_manager.hpp>
 #include <storage/storage_manager_matrix.hpp>
 
@@ -57,7 +59,7 @@ namespace spla {
     class TMatrix final : public Matrix {
     public:
         TMatrix(uint n_rows, uint n_cols);
-        ~TMatrix() override = default;
+        ~TMatrix() override;
 
         uint               get_n_rows() override;
         uint               get_n_cols() override;
@@ -76,6 +78,9 @@ namespace spla {
         Status             build(const ref_ptr<MemView>& keys1, const ref_ptr<MemView>& keys2, const ref_ptr<MemView>& values) override;
         Status             read(ref_ptr<MemView>& keys1, ref_ptr<MemView>& keys2, ref_ptr<MemView>& values) override;
         Status             clear() override;
+        Status             set_memory_budget(std::size_t bytes) override;
+        std::size_t        get_memory_usage() override;
+        Status             save_snapshot(const std::string& file_path) override;
 
         template<typename Decorator>
         Decorator* get() { return m_storage.template get<Decorator>(); }
@@ -88,10 +93,12 @@ namespace spla {
         T    get_fill_value() const { return m_storage.get_fill_value(); }
 
         static StorageManagerMatrix<T>* get_storage_manager();
+        static ref_ptr<Matrix>          make_from_snapshot(const MappedFile& file, const CpuSnapshotHeader& header);
 
     private:
         typename StorageManagerMatrix<T>::Storage m_storage;
         std::string                               m_label;
+        typename CpuLil<T>::Reduce                m_reduce = [](T, T a) { return a; };
     };
 
     template<typename T>
@@ -99,6 +106,11 @@ namespace spla {
         m_storage.set_dims(n_rows, n_cols);
     }
 
+    template<typename T>
+    TMatrix<T>::~TMatrix() {
+        StorageManagerMatrix<T>::release_usage(m_storage);
+    }
+
     template<typename T>
     uint TMatrix<T>::get_n_rows() {
         return m_storage.get_n_rows();
@@ -146,6 +158,7 @@ namespace spla {
         auto reduce = resolve_duplicates.template cast_safe<TOpBinary<T, T, T>>();
 
         if (reduce) {
+            m_reduce = reduce->function;
             validate_ctor(FormatMatrix::CpuLil);
             get<CpuLil<T>>()->reduce = reduce->function;
             validate_ctor(FormatMatrix::CpuDok);
@@ -249,6 +262,12 @@ namespace spla {
         keys2->read(0, key_size * elements_count, coo.Aj.data());
         values->read(0, value_size * elements_count, coo.Ax.data());
 
+        // unordered input is sorted, duplicates are reduced as on insertion of elements,
+        // op is kept on matrix since lil with it may be released by residency policy
+        if (!cpu_coo_is_sorted(coo)) {
+            cpu_coo_sort_reduce(coo, m_reduce);
+        }
+
         return Status::Ok;
     }
     template<typename T>
@@ -274,6 +293,44 @@ namespace spla {
         return Status::Ok;
     }
 
+    template<typename T>
+    Status TMatrix<T>::set_memory_budget(std::size_t bytes) {
+        m_storage.set_memory_budget(bytes);
+        return Status::Ok;
+    }
+
+    template<typename T>
+    std::size_t TMatrix<T>::get_memory_usage() {
+        return m_storage.get_memory_usage();
+    }
+
+    template<typename T>
+    Status TMatrix<T>::save_snapshot(const std::string& file_path) {
+        validate_rw(FormatMatrix::CpuCsr);
+        const CpuCsr<T>& data = *get<CpuCsr<T>>();
+
+        if (!cpu_csr_save_snapshot<T>(file_path, get_type()->get_code(), m_storage.get_n_rows(), m_storage.get_n_cols(), m_storage.get_fill_value(), data)) {
+            LOG_MSG(Status::Error, "failed to save snapshot to " << file_path);
+            return Status::Error;
+        }
+
+        return Status::Ok;
+    }
+
+    template<typename T>
+    ref_ptr<Matrix> TMatrix<T>::make_from_snapshot(const MappedFile& file, const CpuSnapshotHeader& header) {
+        ref_ptr<TMatrix<T>> object(new TMatrix<T>(uint(header.n_rows), uint(header.n_cols)));
+
+        object->validate_wd(FormatMatrix::CpuCsr);
+        object->m_storage.set_fill_value(cpu_snapshot_fill_value<T>(header));
+
+        if (!cpu_csr_load_snapshot<T>(file, header, *object->template get<CpuCsr<T>>())) {
+            return ref_ptr<Matrix>();
+        }
+
+        return object.template as<Matrix>();
+    }
+
     template<typename T>
     void TMatrix<T>::validate_rw(FormatMatrix format) {
         StorageManagerMatrix<T>* manager = get_storage_manager();
@@ -305,12 +362,11 @@ namespace spla {
 
     template<typename T>
     StorageManagerMatrix<T>* TMatrix<T>::get_storage_manager() {
-        static std::unique_ptr<StorageManagerMatrix<T>> storage_manager;
-
-        if (!storage_manager) {
-            storage_manager = std::make_unique<StorageManagerMatrix<T>>();
-            register_formats_matrix(*storage_manager);
-        }
+        static std::unique_ptr<StorageManagerMatrix<T>> storage_manager = []() {
+            auto manager = std::make_unique<StorageManagerMatrix<T>>();
+            register_formats_matrix(*manager);
+            return manager;
+        }();
 
         return storage_manager.get();
     }
@@ -37,6 +37,8 @@
 #include <core/top.hpp>
 #include <core/ttype.hpp>
 
+#include <cpu/cpu_format_snapshot.hpp>
+
 #include <storage/storage_manager.hpp>
 #include <storage/storage_manager_vector.hpp>
 
@@ -60,7 +62,7 @@ namespace spla {
     class TVector final : public Vector {
     public:
         explicit TVector(uint n_rows);
-        ~TVector() override = default;
+        ~TVector() override;
 
         uint               get_n_rows() override;
         ref_ptr<Type>      get_type() override;
@@ -80,6 +82,9 @@ namespace spla {
         Status             build(const ref_ptr<MemView>& keys, const ref_ptr<MemView>& values) override;
         Status             read(ref_ptr<MemView>& keys, ref_ptr<MemView>& values) override;
         Status             clear() override;
+        Status             set_memory_budget(std::size_t bytes) override;
+        std::size_t        get_memory_usage() override;
+        Status             save_snapshot(const std::string& file_path) override;
 
         template<typename Decorator>
         Decorator* get() { return m_storage.template get<Decorator>(); }
@@ -92,10 +97,12 @@ namespace spla {
         T    get_fill_value() const { return m_storage.get_fill_value(); }
 
         static StorageManagerVector<T>* get_storage_manager();
+        static ref_ptr<Vector>          make_from_snapshot(const MappedFile& file, const CpuSnapshotHeader& header);
 
     private:
         typename StorageManagerVector<T>::Storage m_storage;
         std::string                               m_label;
+        typename CpuDokVec<T>::Reduce             m_reduce = [](T, T a) { return a; };
     };
 
     template<typename T>
@@ -103,6 +110,11 @@ namespace spla {
         m_storage.set_dims(n_rows, 1);
     }
 
+    template<typename T>
+    TVector<T>::~TVector() {
+        StorageManagerVector<T>::release_usage(m_storage);
+    }
+
     template<typename T>
     uint TVector<T>::get_n_rows() {
         return m_storage.get_n_rows();
@@ -146,6 +158,7 @@ namespace spla {
         auto reduce = resolve_duplicates.template cast_safe<TOpBinary<T, T, T>>();
 
         if (reduce) {
+            m_reduce = reduce->function;
             validate_ctor(FormatVector::CpuDok);
             auto* vec   = get<CpuDokVec<T>>();
             vec->reduce = reduce->function;
@@ -295,6 +308,12 @@ namespace spla {
         keys->read(0, key_size * elements_count, coo.Ai.data());
         values->read(0, value_size * elements_count, coo.Ax.data());
 
+        // unordered input is sorted, duplicates are reduced as on insertion of elements,
+        // op is kept on vector since dok with it may be released by residency policy
+        if (!cpu_coo_vec_is_sorted(coo)) {
+            cpu_coo_vec_sort_reduce(coo, m_reduce);
+        }
+
         return Status::Ok;
     }
     template<typename T>
@@ -319,6 +338,44 @@ namespace spla {
         return Status::Ok;
     }
 
+    template<typename T>
+    Status TVector<T>::set_memory_budget(std::size_t bytes) {
+        m_storage.set_memory_budget(bytes);
+        return Status::Ok;
+    }
+
+    template<typename T>
+    std::size_t TVector<T>::get_memory_usage() {
+        return m_storage.get_memory_usage();
+    }
+
+    template<typename T>
+    Status TVector<T>::save_snapshot(const std::string& file_path) {
+        validate_rw(FormatVector::CpuCoo);
+        const CpuCooVec<T>& data = *get<CpuCooVec<T>>();
+
+        if (!cpu_coo_vec_save_snapshot<T>(file_path, get_type()->get_code(), m_storage.get_n_rows(), m_storage.get_fill_value(), data)) {
+            LOG_MSG(Status::Error, "failed to save snapshot to " << file_path);
+            return Status::Error;
+        }
+
+        return Status::Ok;
+    }
+
+    template<typename T>
+    ref_ptr<Vector> TVector<T>::make_from_snapshot(const MappedFile& file, const CpuSnapshotHeader& header) {
+        ref_ptr<TVector<T>> object(new TVector<T>(uint(header.n_rows)));
+
+        object->validate_wd(FormatVector::CpuCoo);
+        object->m_storage.set_fill_value(cpu_snapshot_fill_value<T>(header));
+
+        if (!cpu_coo_vec_load_snapshot<T>(file, header, *object->template get<CpuCooVec<T>>())) {
+            return ref_ptr<Vector>();
+        }
+
+        return object.template as<Vector>();
+    }
+
     template<typename T>
     void TVector<T>::validate_rw(FormatVector format) {
         StorageManagerVector<T>* manager = get_storage_manager();
@@ -350,12 +407,11 @@ namespace spla {
 
     template<typename T>
     StorageManagerVector<T>* TVector<T>::get_storage_manager() {
-        static std::unique_ptr<StorageManagerVector<T>> storage_manager;
-
-        if (!storage_manager) {
-            storage_manager = std::make_unique<StorageManagerVector<T>>();
-            register_formats_vector(*storage_manager);
-        }
+        static std::unique_ptr<StorageManagerVector<T>> storage_manager = []() {
+            auto manager = std::make_unique<StorageManagerVector<T>>();
+            register_formats_vector(*manager);
+            return manager;
+        }();
 
         return storage_manager.get();
     }
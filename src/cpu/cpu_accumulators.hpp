@@ -0,0 +1,488 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_ACCUMULATORS_HPP
+#define SPLA_CPU_ACCUMULATORS_HPP
+
+#include <cpu/cpu_formats.hpp>
+
+#include <spla/descriptor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class CpuLilRows
+     * @brief Read-only row access to CpuLil matrix for generic row kernels
+     *
+     * @tparam T Type of elements
+     */
+    template<typename T>
+    struct CpuLilRows {
+        using Pos = const typename CpuLil<T>::Entry*;
+
+        explicit CpuLilRows(const CpuLil<T>& lil) : Ar(lil.Ar) {}
+
+        Pos  begin(uint i) const { return Ar[i].data(); }
+        Pos  end(uint i) const { return Ar[i].data() + Ar[i].size(); }
+        uint size(uint i) const { return uint(Ar[i].size()); }
+        uint col(Pos p) const { return p->first; }
+        T    val(Pos p) const { return p->second; }
+
+        const std::vector<typename CpuLil<T>::Row>& Ar;
+    };
+
+    /**
+     * @class CpuCsrRows
+     * @brief Read-only row access to CpuCsr matrix for generic row kernels
+     *
+     * @tparam T Type of elements
+     */
+    template<typename T>
+    struct CpuCsrRows {
+        using Pos = uint;
+
+        explicit CpuCsrRows(const CpuCsr<T>& csr) : Ap(csr.Ap.data()), Aj(csr.Aj.data()), Ax(csr.Ax.data()) {}
+
+        Pos  begin(uint i) const { return Ap[i]; }
+        Pos  end(uint i) const { return Ap[i + 1]; }
+        uint size(uint i) const { return Ap[i + 1] - Ap[i]; }
+        uint col(Pos p) const { return Aj[p]; }
+        T    val(Pos p) const { return Ax[p]; }
+
+        const uint* Ap;
+        const uint* Aj;
+        const T*    Ax;
+    };
+
+    /**
+     * @class CpuAccDense
+     * @brief Dense accumulator of row products with list of touched columns
+     *
+     * Best for rows touching a noticeable part of all columns. Requires
+     * memory proportional to the number of columns of the result.
+     *
+     * @tparam T Type of elements
+     */
+    template<typename T>
+    struct CpuAccDense {
+        std::vector<T>    values;
+        std::vector<uint> marks;
+        std::vector<uint> touched;
+        uint              stamp = 0;
+
+        void next_row(uint n_cols) {
+            if (marks.size() != n_cols) {
+                values.resize(n_cols);
+                marks.assign(n_cols, 0);
+                stamp = 0;
+            }
+            if (++stamp == 0) {
+                std::fill(marks.begin(), marks.end(), 0);
+                stamp = 1;
+            }
+            touched.clear();
+        }
+
+        template<typename RowsA, typename RowsB>
+        uint count(const RowsA& A, const RowsB& B, uint row, uint n_cols) {
+            next_row(n_cols);
+
+            uint count = 0;
+            for (auto pa = A.begin(row); pa != A.end(row); ++pa) {
+                const uint i = A.col(pa);
+
+                for (auto pb = B.begin(i); pb != B.end(i); ++pb) {
+                    const uint j = B.col(pb);
+
+                    if (marks[j] != stamp) {
+                        marks[j] = stamp;
+                        count += 1;
+                    }
+                }
+            }
+
+            return count;
+        }
+
+        template<typename RowsA, typename RowsB, typename FuncMult, typename FuncAdd, typename Out>
+        void compute(const RowsA& A, const RowsB& B, uint row, uint n_cols, T init,
+                     FuncMult& func_multiply, FuncAdd& func_add, Out&& out) {
+            next_row(n_cols);
+
+            for (auto pa = A.begin(row); pa != A.end(row); ++pa) {
+                const uint i       = A.col(pa);
+                const T    value_A = A.val(pa);
+
+                for (auto pb = B.begin(i); pb != B.end(i); ++pb) {
+                    const uint j = B.col(pb);
+                    const T    x = func_multiply(value_A, B.val(pb));
+
+                    if (marks[j] != stamp) {
+                        marks[j]  = stamp;
+                        values[j] = func_add(init, x);
+                        touched.push_back(j);
+                    } else {
+                        values[j] = func_add(values[j], x);
+                    }
+                }
+            }
+
+            // wide rows are cheaper to collect by scan of marks than by sort of touched columns
+            if (std::uint64_t(touched.size()) * SCAN_RATIO >= n_cols) {
+                for (uint j = 0; j < n_cols; j++) {
+                    if (marks[j] == stamp && values[j] != init) {
+                        out(j, values[j]);
+                    }
+                }
+                return;
+            }
+
+            std::sort(touched.begin(), touched.end());
+
+            for (const uint j : touched) {
+                if (values[j] != init) {
+                    out(j, values[j]);
+                }
+            }
+        }
+
+        /** Collect row by scan of marks if it touches at least 1/SCAN_RATIO of columns */
+        static constexpr std::uint64_t SCAN_RATIO = 16;
+    };
+
+    /**
+     * @class CpuAccHash
+     * @brief Open addressing hash accumulator of row products
+     *
+     * Table is sized by the row flops estimate, so memory traffic does not
+     * depend on the number of columns. Best for wide and sparse results.
+     *
+     * @tparam T Type of elements
+     */
+    template<typename T>
+    struct CpuAccHash {
+        static constexpr uint EMPTY = 0xffffffffu;
+
+        std::vector<uint>               keys;
+        std::vector<T>                  values;
+        std::vector<uint>               slots;
+        std::vector<std::pair<uint, T>> entries;
+        uint                            mask  = 0;
+        uint                            shift = 0;
+
+        void next_row(std::uint64_t max_size) {
+            uint log_capacity = 4;
+            while ((std::uint64_t(1) << log_capacity) < 2 * max_size) {
+                log_capacity += 1;
+            }
+
+            const uint capacity = 1u << log_capacity;
+
+            if (keys.size() < capacity) {
+                keys.assign(capacity, EMPTY);
+                values.resize(capacity);
+            }
+
+            mask  = capacity - 1;
+            shift = 64 - log_capacity;
+            slots.clear();
+        }
+
+        uint find(uint j) {
+            uint slot = uint((std::uint64_t(j) * 0x9e3779b97f4a7c15ull) >> shift) & mask;
+            while (keys[slot] != EMPTY && keys[slot] != j) {
+                slot = (slot + 1) & mask;
+            }
+            return slot;
+        }
+
+        void clear_slots() {
+            for (const uint slot : slots) {
+                keys[slot] = EMPTY;
+            }
+        }
+
+        template<typename RowsA, typename RowsB>
+        uint count(const RowsA& A, const RowsB& B, uint row, std::uint64_t max_size) {
+            next_row(max_size);
+
+            for (auto pa = A.begin(row); pa != A.end(row); ++pa) {
+                const uint i = A.col(pa);
+
+                for (auto pb = B.begin(i); pb != B.end(i); ++pb) {
+                    const uint j    = B.col(pb);
+                    const uint slot = find(j);
+
+                    if (keys[slot] == EMPTY) {
+                        keys[slot] = j;
+                        slots.push_back(slot);
+                    }
+                }
+            }
+
+            const uint count = uint(slots.size());
+            clear_slots();
+            return count;
+        }
+
+        template<typename RowsA, typename RowsB, typename FuncMult, typename FuncAdd, typename Out>
+        void compute(const RowsA& A, const RowsB& B, uint row, std::uint64_t max_size, T init,
+                     FuncMult& func_multiply, FuncAdd& func_add, Out&& out) {
+            next_row(max_size);
+
+            for (auto pa = A.begin(row); pa != A.end(row); ++pa) {
+                const uint i       = A.col(pa);
+                const T    value_A = A.val(pa);
+
+                for (auto pb = B.begin(i); pb != B.end(i); ++pb) {
+                    const uint j    = B.col(pb);
+                    const T    x    = func_multiply(value_A, B.val(pb));
+                    const uint slot = find(j);
+
+                    if (keys[slot] == EMPTY) {
+                        keys[slot]   = j;
+                        values[slot] = func_add(init, x);
+                        slots.push_back(slot);
+                    } else {
+                        values[slot] = func_add(values[slot], x);
+                    }
+                }
+            }
+
+            entries.clear();
+            for (const uint slot : slots) {
+                if (values[slot] != init) {
+                    entries.emplace_back(keys[slot], values[slot]);
+                }
+            }
+            clear_slots();
+
+            std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+            for (const auto& entry : entries) {
+                out(entry.first, entry.second);
+            }
+        }
+    };
+
+    /**
+     * @class CpuAccHeap
+     * @brief K-way merge of rows of B selected by a row of A using binary heap
+     *
+     * Produces columns in sorted order without scatter and sort steps.
+     * Best for rows of A with few entries. Ties are merged in order of
+     * entries of A, so result is the same as for other accumulators.
+     *
+     * @tparam T Type of elements
+     * @tparam RowsB Type of row access to B
+     */
+    template<typename T, typename RowsB>
+    struct CpuAccHeap {
+        struct Cursor {
+            uint                col;
+            uint                k;
+            typename RowsB::Pos pos;
+            typename RowsB::Pos end;
+            T                   value_A;
+        };
+
+        static bool greater(const Cursor& a, const Cursor& b) {
+            return a.col > b.col || (a.col == b.col && a.k > b.k);
+        }
+
+        std::vector<Cursor> heap;
+
+        template<typename RowsA>
+        void init_heap(const RowsA& A, const RowsB& B, uint row) {
+            heap.clear();
+
+            uint k = 0;
+            for (auto pa = A.begin(row); pa != A.end(row); ++pa, ++k) {
+                const uint i = A.col(pa);
+
+                if (B.begin(i) != B.end(i)) {
+                    heap.push_back(Cursor{B.col(B.begin(i)), k, B.begin(i), B.end(i), A.val(pa)});
+                }
+            }
+
+            std::make_heap(heap.begin(), heap.end(), greater);
+        }
+
+        void advance(const RowsB& B) {
+            Cursor& cursor = heap.back();
+            ++cursor.pos;
+
+            if (cursor.pos != cursor.end) {
+                cursor.col = B.col(cursor.pos);
+                std::push_heap(heap.begin(), heap.end(), greater);
+            } else {
+                heap.pop_back();
+            }
+        }
+
+        template<typename RowsA>
+        uint count(const RowsA& A, const RowsB& B, uint row) {
+            init_heap(A, B, row);
+
+            uint count    = 0;
+            uint last_col = 0;
+
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), greater);
+
+                const uint j = heap.back().col;
+                if (count == 0 || j != last_col) {
+                    last_col = j;
+                    count += 1;
+                }
+
+                advance(B);
+            }
+
+            return count;
+        }
+
+        template<typename RowsA, typename FuncMult, typename FuncAdd, typename Out>
+        void compute(const RowsA& A, const RowsB& B, uint row, T init,
+                     FuncMult& func_multiply, FuncAdd& func_add, Out&& out) {
+            init_heap(A, B, row);
+
+            bool has_col = false;
+            uint col     = 0;
+            T    value   = init;
+
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), greater);
+
+                const Cursor& cursor = heap.back();
+                const T       x      = func_multiply(cursor.value_A, B.val(cursor.pos));
+
+                if (has_col && cursor.col == col) {
+                    value = func_add(value, x);
+                } else {
+                    if (has_col && value != init) {
+                        out(col, value);
+                    }
+                    has_col = true;
+                    col     = cursor.col;
+                    value   = func_add(init, x);
+                }
+
+                advance(B);
+            }
+
+            if (has_col && value != init) {
+                out(col, value);
+            }
+        }
+    };
+
+    /**
+     * @class CpuRowProduct
+     * @brief Computes rows of A x B with accumulator selected per row
+     *
+     * Each thread owns its own instance. Accumulator for a row is selected
+     * from upper bound of its products count unless forced by descriptor.
+     *
+     * @tparam T Type of elements
+     * @tparam RowsA Type of row access to A
+     * @tparam RowsB Type of row access to B
+     */
+    template<typename T, typename RowsA, typename RowsB>
+    struct CpuRowProduct {
+        using Accumulator = Descriptor::Accumulator;
+
+        /** Max entries in row of A to merge rows of B with heap */
+        static constexpr uint HEAP_MAX_WAYS = 4;
+        /** Use dense accumulator if products of row cover at least 1/DENSE_RATIO of columns */
+        static constexpr std::uint64_t DENSE_RATIO = 16;
+
+        CpuRowProduct(const RowsA& A, const RowsB& B, uint n_cols, Accumulator forced)
+            : A(A), B(B), n_cols(n_cols), forced(forced) {}
+
+        Accumulator select(uint row, std::uint64_t row_flops) const {
+            if (forced != Accumulator::Auto) return forced;
+            if (A.size(row) <= HEAP_MAX_WAYS) return Accumulator::Heap;
+            if (row_flops * DENSE_RATIO >= n_cols) return Accumulator::Dense;
+            return Accumulator::Hash;
+        }
+
+        uint count(uint row, std::uint64_t row_flops) {
+            if (row_flops == 0) return 0;
+
+            switch (select(row, row_flops)) {
+                case Accumulator::Heap:
+                    return heap.count(A, B, row);
+                case Accumulator::Hash:
+                    return hash.count(A, B, row, std::min(row_flops, std::uint64_t(n_cols)));
+                default:
+                    return dense.count(A, B, row, n_cols);
+            }
+        }
+
+        template<typename FuncMult, typename FuncAdd, typename Out>
+        void compute(uint row, std::uint64_t row_flops, T init, FuncMult& func_multiply, FuncAdd& func_add, Out&& out) {
+            if (row_flops == 0) return;
+
+            switch (select(row, row_flops)) {
+                case Accumulator::Heap:
+                    heap.compute(A, B, row, init, func_multiply, func_add, out);
+                    break;
+                case Accumulator::Hash:
+                    hash.compute(A, B, row, std::min(row_flops, std::uint64_t(n_cols)), init, func_multiply, func_add, out);
+                    break;
+                default:
+                    dense.compute(A, B, row, n_cols, init, func_multiply, func_add, out);
+                    break;
+            }
+        }
+
+        const RowsA&         A;
+        const RowsB&         B;
+        uint                 n_cols;
+        Accumulator          forced;
+        CpuAccDense<T>       dense;
+        CpuAccHash<T>        hash;
+        CpuAccHeap<T, RowsB> heap;
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_ACCUMULATORS_HPP
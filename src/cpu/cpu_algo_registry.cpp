@@ -42,12 +42,14 @@
 #include <cpu/cpu_m_transpose.hpp>
 #include <cpu/cpu_mxm.hpp>
 #include <cpu/cpu_mxmT_masked.hpp>
+#include <cpu/cpu_mxmT_masked_reduce.hpp>
 #include <cpu/cpu_mxv.hpp>
 #include <cpu/cpu_v_assign.hpp>
 #include <cpu/cpu_v_count_mf.hpp>
 #include <cpu/cpu_v_eadd.hpp>
 #include <cpu/cpu_v_eadd_fdb.hpp>
 #include <cpu/cpu_v_emult.hpp>
+#include <cpu/cpu_v_fused.hpp>
 #include <cpu/cpu_v_map.hpp>
 #include <cpu/cpu_v_reduce.hpp>
 #include <cpu/cpu_vxm.hpp>
@@ -73,6 +75,11 @@ namespace spla {
         g_registry->add(MAKE_KEY_CPU_0("v_reduce", UINT), std::make_shared<Algo_v_reduce_cpu<T_UINT>>());
         g_registry->add(MAKE_KEY_CPU_0("v_reduce", FLOAT), std::make_shared<Algo_v_reduce_cpu<T_FLOAT>>());
 
+        // algorthm v_fused
+        g_registry->add(MAKE_KEY_CPU_0("v_fused", INT), std::make_shared<Algo_v_fused_cpu<T_INT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_fused", UINT), std::make_shared<Algo_v_fused_cpu<T_UINT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_fused", FLOAT), std::make_shared<Algo_v_fused_cpu<T_FLOAT>>());
+
         // algorthm v_eadd
         g_registry->add(MAKE_KEY_CPU_0("v_eadd", INT), std::make_shared<Algo_v_eadd_cpu<T_INT>>());
         g_registry->add(MAKE_KEY_CPU_0("v_eadd", UINT), std::make_shared<Algo_v_eadd_cpu<T_UINT>>());
@@ -153,6 +160,11 @@ namespace spla {
         g_registry->add(MAKE_KEY_CPU_0("mxmT_masked", UINT), std::make_shared<Algo_mxmT_masked_cpu<T_UINT>>());
         g_registry->add(MAKE_KEY_CPU_0("mxmT_masked", FLOAT), std::make_shared<Algo_mxmT_masked_cpu<T_FLOAT>>());
 
+        // algorthm mxmT_masked_reduce
+        g_registry->add(MAKE_KEY_CPU_0("mxmT_masked_reduce", INT), std::make_shared<Algo_mxmT_masked_reduce_cpu<T_INT>>());
+        g_registry->add(MAKE_KEY_CPU_0("mxmT_masked_reduce", UINT), std::make_shared<Algo_mxmT_masked_reduce_cpu<T_UINT>>());
+        g_registry->add(MAKE_KEY_CPU_0("mxmT_masked_reduce", FLOAT), std::make_shared<Algo_mxmT_masked_reduce_cpu<T_FLOAT>>());
+
         // algorthm mxm
         g_registry->add(MAKE_KEY_CPU_0("mxm", INT), std::make_shared<Algo_mxm_cpu<T_INT>>());
         g_registry->add(MAKE_KEY_CPU_0("mxm", UINT), std::make_shared<Algo_mxm_cpu<T_UINT>>());
@@ -0,0 +1,119 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_BITMAP_HPP
+#define SPLA_CPU_BITMAP_HPP
+
+#include <spla/config.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#ifdef SPLA_MSVC
+    #include <intrin.h>
+#endif
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    static inline uint cpu_popcount64(std::uint64_t x) {
+#ifdef SPLA_MSVC
+        return uint(__popcnt64(x));
+#else
+        return uint(__builtin_popcountll(x));
+#endif
+    }
+
+    static inline uint cpu_ctz64(std::uint64_t x) {
+#ifdef SPLA_MSVC
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return uint(index);
+#else
+        return uint(__builtin_ctzll(x));
+#endif
+    }
+
+    /**
+     * @class CpuBitmap
+     * @brief Dense set of indices stored as one bit per index
+     */
+    struct CpuBitmap {
+        static constexpr uint BITS = 64;
+
+        std::vector<std::uint64_t> words;
+
+        static uint words_count(uint n) { return (n + BITS - 1) / BITS; }
+
+        void resize(uint n) { words.assign(words_count(n), 0); }
+        void clear() { std::fill(words.begin(), words.end(), 0); }
+
+        bool test(uint i) const { return (words[i / BITS] >> (i % BITS)) & 1u; }
+        void set(uint i) { words[i / BITS] |= std::uint64_t(1) << (i % BITS); }
+
+        /** Sets bit and returns true if it was not set before */
+        bool test_and_set(uint i) {
+            const std::uint64_t bit  = std::uint64_t(1) << (i % BITS);
+            std::uint64_t&      word = words[i / BITS];
+            const bool          was  = word & bit;
+            word |= bit;
+            return !was;
+        }
+
+        uint count(uint word_begin, uint word_end) const {
+            uint count = 0;
+            for (uint w = word_begin; w < word_end; w++) {
+                count += cpu_popcount64(words[w]);
+            }
+            return count;
+        }
+
+        /** Calls func(i) for set indices in words range in ascending order */
+        template<typename Func>
+        void for_each(uint word_begin, uint word_end, Func&& func) const {
+            for (uint w = word_begin; w < word_end; w++) {
+                std::uint64_t word = words[w];
+                while (word) {
+                    func(w * BITS + cpu_ctz64(word));
+                    word &= word - 1;
+                }
+            }
+        }
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_BITMAP_HPP
@@ -29,6 +29,11 @@
 #define SPLA_CPU_FORMAT_COO_HPP
 
 #include <cpu/cpu_formats.hpp>
+#include <cpu/cpu_sort.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace spla {
 
@@ -54,6 +59,65 @@ namespace spla {
         in.values = 0;
     }
 
+    /**
+     * @brief Checks that entries are ordered by rows then columns without duplicates
+     */
+    template<typename T>
+    bool cpu_coo_is_sorted(const CpuCoo<T>& in) {
+        for (uint k = 1; k < in.values; k++) {
+            if (in.Ai[k - 1] > in.Ai[k] || (in.Ai[k - 1] == in.Ai[k] && in.Aj[k - 1] >= in.Aj[k])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Sorts entries by rows then columns and reduces duplicates
+     *
+     * Sort is stable, so duplicates are reduced in the order of insertion.
+     *
+     * @param in Entries to sort and reduce in place
+     * @param reduce Function called as reduce(accum, added) for duplicated entries
+     */
+    template<typename T, typename Reduce>
+    void cpu_coo_sort_reduce(CpuCoo<T>& in, Reduce&& reduce) {
+        using Entry = std::pair<std::uint64_t, T>;
+
+        uint max_i = 0, max_j = 0;
+        for (uint k = 0; k < in.values; k++) {
+            max_i = std::max(max_i, in.Ai[k]);
+            max_j = std::max(max_j, in.Aj[k]);
+        }
+
+        const uint j_bits    = cpu_bits_count(max_j);
+        const uint n_threads = cpu_threads_count(ref_ptr<Descriptor>());
+
+        std::vector<Entry> entries(in.values);
+        std::vector<Entry> tmp;
+
+        for (uint k = 0; k < in.values; k++) {
+            entries[k] = Entry((std::uint64_t(in.Ai[k]) << j_bits) | in.Aj[k], in.Ax[k]);
+        }
+
+        auto key_of = [](const Entry& entry) { return entry.first; };
+
+        cpu_radix_sort(entries, tmp, cpu_bits_count(max_i) + j_bits, n_threads, key_of);
+        cpu_reduce_sorted(entries, tmp, n_threads, key_of, [&](Entry& accum, const Entry& entry) {
+            accum.second = reduce(accum.second, entry.second);
+        });
+
+        const std::uint64_t j_mask = (std::uint64_t(1) << j_bits) - 1;
+
+        cpu_coo_resize(uint(tmp.size()), in);
+
+        for (uint k = 0; k < in.values; k++) {
+            in.Ai[k] = uint(tmp[k].first >> j_bits);
+            in.Aj[k] = uint(tmp[k].first & j_mask);
+            in.Ax[k] = tmp[k].second;
+        }
+    }
+
     template<typename T>
     void cpu_coo_to_lil(uint             n_rows,
                         const CpuCoo<T>& in,
@@ -122,6 +186,40 @@ namespace spla {
         }
     }
 
+    template<typename T>
+    void cpu_coo_to_csc(uint             n_cols,
+                        const CpuCoo<T>& in,
+                        CpuCsc<T>&       out) {
+        auto& Rp = out.Ap;
+        auto& Ri = out.Ai;
+        auto& Rx = out.Ax;
+        auto& Ai = in.Ai;
+        auto& Aj = in.Aj;
+        auto& Ax = in.Ax;
+
+        assert(Rp.size() == n_cols + 1);
+        assert(Ri.size() == in.values);
+        assert(Rx.size() == in.values);
+
+        std::fill(Rp.begin(), Rp.end(), 0u);
+
+        for (uint k = 0; k < in.values; ++k) {
+            Rp[Aj[k]] += 1;
+        }
+
+        std::exclusive_scan(Rp.begin(), Rp.end(), Rp.begin(), 0, std::plus<>());
+        assert(Rp[n_cols] == in.values);
+
+        // entries are sorted by rows, so stable scatter keeps row indices of each column sorted
+        std::vector<uint> offsets(Rp.begin(), Rp.begin() + n_cols);
+
+        for (uint k = 0; k < in.values; ++k) {
+            const uint l = offsets[Aj[k]]++;
+            Ri[l]        = Ai[k];
+            Rx[l]        = Ax[k];
+        }
+    }
+
     /**
      * @}
      */
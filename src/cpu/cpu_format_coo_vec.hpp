@@ -29,6 +29,7 @@
 #define SPLA_CPU_FORMAT_COO_VEC_HPP
 
 #include <cpu/cpu_formats.hpp>
+#include <cpu/cpu_sort.hpp>
 
 #include <algorithm>
 #include <vector>
@@ -43,13 +44,16 @@ namespace spla {
     template<typename T>
     void cpu_coo_vec_sort(CpuCooVec<T>& vec) {
         std::vector<std::pair<uint, T>> buffer;
+        std::vector<std::pair<uint, T>> tmp;
         buffer.reserve(vec.values);
 
+        uint max_i = 0;
         for (uint i = 0; i < vec.values; i++) {
             buffer.emplace_back(vec.Ai[i], vec.Ax[i]);
+            max_i = std::max(max_i, vec.Ai[i]);
         }
 
-        std::sort(buffer.begin(), buffer.end(), [](auto& a, auto& b) { return a.first < b.first; });
+        cpu_radix_sort(buffer, tmp, cpu_bits_count(max_i), cpu_threads_count(ref_ptr<Descriptor>()), [](const std::pair<uint, T>& entry) { return entry.first; });
 
         for (uint i = 0; i < vec.values; i++) {
             vec.Ai[i] = buffer[i].first;
@@ -57,6 +61,56 @@ namespace spla {
         }
     }
 
+    /**
+     * @brief Checks that entries are ordered by indices without duplicates
+     */
+    template<typename T>
+    bool cpu_coo_vec_is_sorted(const CpuCooVec<T>& vec) {
+        for (uint i = 1; i < vec.values; i++) {
+            if (vec.Ai[i - 1] >= vec.Ai[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Sorts entries by indices and reduces duplicates in the order of insertion
+     *
+     * @param vec Entries to sort and reduce in place
+     * @param reduce Function called as reduce(accum, added) for duplicated entries
+     */
+    template<typename T, typename Reduce>
+    void cpu_coo_vec_sort_reduce(CpuCooVec<T>& vec, Reduce&& reduce) {
+        using Entry = std::pair<uint, T>;
+
+        std::vector<Entry> buffer;
+        std::vector<Entry> tmp;
+        buffer.reserve(vec.values);
+
+        uint max_i = 0;
+        for (uint i = 0; i < vec.values; i++) {
+            buffer.emplace_back(vec.Ai[i], vec.Ax[i]);
+            max_i = std::max(max_i, vec.Ai[i]);
+        }
+
+        const uint n_threads = cpu_threads_count(ref_ptr<Descriptor>());
+
+        auto key_of = [](const Entry& entry) { return entry.first; };
+
+        cpu_radix_sort(buffer, tmp, cpu_bits_count(max_i), n_threads, key_of);
+        cpu_reduce_sorted(buffer, tmp, n_threads, key_of, [&](Entry& accum, const Entry& entry) {
+            accum.second = reduce(accum.second, entry.second);
+        });
+
+        cpu_coo_vec_resize(uint(tmp.size()), vec);
+
+        for (uint i = 0; i < vec.values; i++) {
+            vec.Ai[i] = tmp[i].first;
+            vec.Ax[i] = tmp[i].second;
+        }
+    }
+
     template<typename T>
     void cpu_coo_vec_resize(const uint    n_values,
                             CpuCooVec<T>& vec) {
@@ -86,6 +140,14 @@ namespace spla {
         }
     }
 
+    template<typename T>
+    void cpu_coo_vec_to_dense(const CpuCooVec<T>& in,
+                              CpuDenseVec<T>&     out) {
+        for (std::size_t k = 0; k < in.Ai.size(); ++k) {
+            out.Ax[in.Ai[k]] = in.Ax[k];
+        }
+    }
+
     /**
      * @}
      */
@@ -0,0 +1,154 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_FORMAT_CSC_HPP
+#define SPLA_CPU_FORMAT_CSC_HPP
+
+#include <cpu/cpu_formats.hpp>
+#include <cpu/cpu_parallel.hpp>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    template<typename T>
+    void cpu_csc_resize(const uint n_cols,
+                        const uint n_values,
+                        CpuCsc<T>& storage) {
+        storage.Ap.resize(n_cols + 1);
+        storage.Ai.resize(n_values);
+        storage.Ax.resize(n_values);
+        storage.values = n_values;
+    }
+
+    template<typename T>
+    void cpu_csc_clear(const uint n_cols,
+                       CpuCsc<T>& storage) {
+        storage.Ap.assign(n_cols + 1, 0);
+        storage.Ai.clear();
+        storage.Ax.clear();
+        storage.values = 0;
+    }
+
+    /**
+     * @brief Transposes compressed (csr or csc) storage into compressed storage of other orientation
+     *
+     * Each thread counts entries of its range of source lines per target line,
+     * then scatters them to own offsets. Ranges are ordered, so indices in
+     * every target line are sorted as in the sequential transpose.
+     *
+     * @param n_major Number of lines of source (rows for csr)
+     * @param n_minor Number of lines of result (columns for csr)
+     */
+    template<typename T>
+    void cpu_compressed_transpose(uint                     n_major,
+                                  uint                     n_minor,
+                                  const std::vector<uint>& Ap,
+                                  const std::vector<uint>& Aj,
+                                  const std::vector<T>&    Ax,
+                                  std::vector<uint>&       Rp,
+                                  std::vector<uint>&       Ri,
+                                  std::vector<T>&          Rx) {
+        constexpr uint PARALLEL_MIN_NNZ = 1u << 16u;
+
+        assert(Ap.size() == n_major + 1);
+        assert(Rp.size() == n_minor + 1);
+        assert(Ri.size() == Ap[n_major]);
+        assert(Rx.size() == Ap[n_major]);
+
+        // each thread keeps n_minor counters, so their total size is bounded by twice the entries count
+        const uint n_values    = Ap[n_major];
+        const uint max_threads = uint(std::max<std::uint64_t>(1, std::uint64_t(n_values) * 2 / std::max(1u, n_minor)));
+        const uint n_threads   = n_values >= PARALLEL_MIN_NNZ ? std::min(max_threads, cpu_threads_count(ref_ptr<Descriptor>())) : 1u;
+
+        std::vector<uint> chunks;
+        cpu_split_by_work(Ap, n_threads, chunks);
+
+        const uint n_chunks = uint(chunks.size() - 1);
+
+        // offsets[chunk * n_minor + j] is count, then offset of entries of chunk in line j
+        std::vector<uint> offsets(std::size_t(n_chunks) * n_minor, 0);
+
+        cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint) {
+            uint* counts = offsets.data() + std::size_t(chunk_id) * n_minor;
+
+            for (uint k = Ap[chunks[chunk_id]]; k < Ap[chunks[chunk_id + 1]]; k++) {
+                counts[Aj[k]] += 1;
+            }
+        });
+
+        uint offset = 0;
+        for (uint j = 0; j < n_minor; j++) {
+            Rp[j] = offset;
+            for (uint chunk_id = 0; chunk_id < n_chunks; chunk_id++) {
+                uint& count = offsets[std::size_t(chunk_id) * n_minor + j];
+                uint  next  = offset + count;
+                count       = offset;
+                offset      = next;
+            }
+        }
+        Rp[n_minor] = offset;
+
+        cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint) {
+            uint* next = offsets.data() + std::size_t(chunk_id) * n_minor;
+
+            for (uint i = chunks[chunk_id]; i < chunks[chunk_id + 1]; i++) {
+                for (uint k = Ap[i]; k < Ap[i + 1]; k++) {
+                    const uint l = next[Aj[k]]++;
+                    Ri[l]        = i;
+                    Rx[l]        = Ax[k];
+                }
+            }
+        });
+    }
+
+    template<typename T>
+    void cpu_csr_to_csc(uint             n_rows,
+                        uint             n_cols,
+                        const CpuCsr<T>& in,
+                        CpuCsc<T>&       out) {
+        cpu_compressed_transpose(n_rows, n_cols, in.Ap, in.Aj, in.Ax, out.Ap, out.Ai, out.Ax);
+    }
+
+    template<typename T>
+    void cpu_csc_to_csr(uint             n_rows,
+                        uint             n_cols,
+                        const CpuCsc<T>& in,
+                        CpuCsr<T>&       out) {
+        cpu_compressed_transpose(n_cols, n_rows, in.Ap, in.Ai, in.Ax, out.Ap, out.Aj, out.Ax);
+    }
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_FORMAT_CSC_HPP
@@ -47,6 +47,15 @@ namespace spla {
         storage.values = n_values;
     }
 
+    template<typename T>
+    void cpu_csr_clear(const uint n_rows,
+                       CpuCsr<T>& storage) {
+        storage.Ap.assign(n_rows + 1, 0);
+        storage.Aj.clear();
+        storage.Ax.clear();
+        storage.values = 0;
+    }
+
     template<typename T>
     void cpu_csr_to_dok(uint             n_rows,
                         const CpuCsr<T>& in,
@@ -28,7 +28,10 @@
 #ifndef SPLA_CPU_FORMAT_DENSE_VEC_HPP
 #define SPLA_CPU_FORMAT_DENSE_VEC_HPP
 
+#include <spla/library.hpp>
+
 #include <cpu/cpu_formats.hpp>
+#include <cpu/cpu_thread_pool.hpp>
 
 namespace spla {
 
@@ -40,8 +43,16 @@ namespace spla {
     template<typename T>
     void cpu_dense_vec_resize(const uint      n_rows,
                               CpuDenseVec<T>& vec) {
+        const bool is_new = vec.Ax.empty();
+
         vec.Ax.resize(n_rows);
         vec.values = n_rows;
+
+        // fresh zeroed storage is placed on numa nodes of pool threads processing its rows;
+        // without pinning placement is not controlled, so pool is not even started
+        if (is_new && sizeof(T) * n_rows >= CpuThreadPool::FIRST_TOUCH_MIN_BYTES && Library::get()->is_set_cpu_pinning()) {
+            Library::get()->get_cpu_pool()->first_touch(vec.Ax.data(), sizeof(T) * n_rows);
+        }
     }
 
     template<typename T>
@@ -66,6 +77,24 @@ namespace spla {
         }
     }
 
+    template<typename T>
+    void cpu_dense_vec_to_coo(const uint            n_rows,
+                              const T               fill_value,
+                              const CpuDenseVec<T>& in,
+                              CpuCooVec<T>&         out) {
+        assert(out.values == 0);
+        assert(out.Ai.empty());
+
+        for (uint i = 0; i < n_rows; ++i) {
+            if (in.Ax[i] != fill_value) {
+                out.Ai.push_back(i);
+                out.Ax.push_back(in.Ax[i]);
+            }
+        }
+
+        out.values = uint(out.Ai.size());
+    }
+
     /**
      * @}
      */
@@ -29,6 +29,7 @@
 #define SPLA_CPU_FORMAT_DOK_VEC_HPP
 
 #include <cpu/cpu_formats.hpp>
+#include <cpu/cpu_sort.hpp>
 
 #include <algorithm>
 
@@ -47,13 +48,16 @@ namespace spla {
 
 
         std::vector<std::pair<uint, T>> tmp;
+        std::vector<std::pair<uint, T>> buffer;
         tmp.reserve(in.values);
 
+        uint max_i = 0;
         for (const auto& entry : in.Ax) {
             tmp.emplace_back(entry.first, entry.second);
+            max_i = std::max(max_i, entry.first);
         }
 
-        std::sort(tmp.begin(), tmp.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        cpu_radix_sort(tmp, buffer, cpu_bits_count(max_i), cpu_threads_count(ref_ptr<Descriptor>()), [](const std::pair<uint, T>& entry) { return entry.first; });
 
         uint k = 0;
 
@@ -146,6 +146,43 @@ namespace spla {
         }
     }
 
+    template<typename T>
+    void cpu_lil_to_csc(uint             n_rows,
+                        uint             n_cols,
+                        const CpuLil<T>& in,
+                        CpuCsc<T>&       out) {
+        auto& Rp = out.Ap;
+        auto& Ri = out.Ai;
+        auto& Rx = out.Ax;
+        auto& Ar = in.Ar;
+
+        assert(Rp.size() == n_cols + 1);
+        assert(Ri.size() == in.values);
+        assert(Rx.size() == in.values);
+
+        std::fill(Rp.begin(), Rp.end(), 0u);
+
+        for (uint i = 0; i < n_rows; i++) {
+            for (const auto& entry : Ar[i]) {
+                Rp[entry.first] += 1;
+            }
+        }
+
+        std::exclusive_scan(Rp.begin(), Rp.end(), Rp.begin(), 0, std::plus<>());
+        assert(Rp[n_cols] == in.values);
+
+        // rows are visited in order, so row indices of each column are sorted
+        std::vector<uint> offsets(Rp.begin(), Rp.begin() + n_cols);
+
+        for (uint i = 0; i < n_rows; i++) {
+            for (const auto& entry : Ar[i]) {
+                const uint k = offsets[entry.first]++;
+                Ri[k]        = i;
+                Rx[k]        = entry.second;
+            }
+        }
+    }
+
     /**
      * @}
      */
@@ -0,0 +1,327 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_FORMAT_SNAPSHOT_HPP
+#define SPLA_CPU_FORMAT_SNAPSHOT_HPP
+
+#include <cpu/cpu_formats.hpp>
+#include <util/mapped_file.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    static constexpr char          CPU_SNAPSHOT_MAGIC[8]   = {'S', 'P', 'L', 'A', 'S', 'N', 'A', 'P'};
+    static constexpr std::uint32_t CPU_SNAPSHOT_VERSION    = 1;
+    static constexpr std::uint32_t CPU_SNAPSHOT_BYTE_ORDER = 0x01020304;
+    static constexpr std::uint32_t CPU_SNAPSHOT_ALIGNMENT  = 64;
+    static constexpr std::uint32_t CPU_SNAPSHOT_MATRIX     = 0;
+    static constexpr std::uint32_t CPU_SNAPSHOT_VECTOR     = 1;
+    static constexpr std::uint32_t CPU_SNAPSHOT_MAX_ALIGN  = 1u << 16u;
+    static constexpr std::uint64_t CPU_SNAPSHOT_MAX_SIZE   = 0xffffffffu;
+
+    /**
+     * @class CpuSnapshotHeader
+     * @brief Header of binary snapshot file with matrix or vector data
+     *
+     * Snapshot keeps arrays of a single cpu format as they are in memory, so
+     * loading is a bulk copy limited by disk bandwidth instead of parsing.
+     * Arrays follow the header, each one starts at offset aligned by `alignment`.
+     * Matrix is stored in csr format (Ap, Aj, Ax), vector in coo format (Ai, Ax).
+     */
+    struct CpuSnapshotHeader {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t object;
+        std::uint32_t format;
+        char          type_code[4];
+        std::uint32_t value_size;
+        std::uint32_t index_size;
+        std::uint32_t alignment;
+        std::uint64_t n_rows;
+        std::uint64_t n_cols;
+        std::uint64_t n_values;
+        std::uint8_t  fill_value[8];
+        std::uint8_t  reserved[56];
+    };
+
+    static_assert(sizeof(CpuSnapshotHeader) == 128, "snapshot header layout must be stable");
+
+    template<typename T>
+    CpuSnapshotHeader cpu_snapshot_header(std::uint32_t      object,
+                                          std::uint32_t      format,
+                                          const std::string& type_code,
+                                          std::uint64_t      n_rows,
+                                          std::uint64_t      n_cols,
+                                          std::uint64_t      n_values,
+                                          T                  fill_value) {
+        static_assert(sizeof(T) <= sizeof(CpuSnapshotHeader::fill_value), "too large value type");
+
+        CpuSnapshotHeader header{};
+        std::memcpy(header.magic, CPU_SNAPSHOT_MAGIC, sizeof(header.magic));
+        std::memcpy(header.type_code, type_code.c_str(), std::min(type_code.size(), sizeof(header.type_code)));
+        std::memcpy(header.fill_value, &fill_value, sizeof(T));
+        header.version    = CPU_SNAPSHOT_VERSION;
+        header.byte_order = CPU_SNAPSHOT_BYTE_ORDER;
+        header.object     = object;
+        header.format     = format;
+        header.value_size = sizeof(T);
+        header.index_size = sizeof(uint);
+        header.alignment  = CPU_SNAPSHOT_ALIGNMENT;
+        header.n_rows     = n_rows;
+        header.n_cols     = n_cols;
+        header.n_values   = n_values;
+        return header;
+    }
+
+    static inline std::uint64_t cpu_snapshot_align(std::uint64_t offset, std::uint64_t alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Writes snapshot header followed by aligned arrays
+     *
+     * @param file_path Path to file to create
+     * @param header Header of snapshot
+     * @param arrays List of pairs (data, size in bytes) to write
+     *
+     * @return True if written successfully
+     */
+    static inline bool cpu_snapshot_write(const std::filesystem::path&                               file_path,
+                                          const CpuSnapshotHeader&                                   header,
+                                          std::initializer_list<std::pair<const void*, std::size_t>> arrays) {
+        std::ofstream file(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        const char    padding[CPU_SNAPSHOT_ALIGNMENT] = {};
+        std::uint64_t offset                          = sizeof(header);
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const auto& array : arrays) {
+            const std::uint64_t aligned = cpu_snapshot_align(offset, header.alignment);
+            file.write(padding, std::streamsize(aligned - offset));
+            file.write(static_cast<const char*>(array.first), std::streamsize(array.second));
+            offset = aligned + array.second;
+        }
+
+        return bool(file);
+    }
+
+    /**
+     * @brief Reads and checks header of snapshot file
+     *
+     * @param file Mapped file with snapshot
+     * @param object Expected kind of stored object
+     * @param header Header to fill
+     *
+     * Sizes are checked to fit into uint, so sizes of arrays computed from them
+     * can not overflow.
+     *
+     * @return True if file has compatible snapshot of expected object
+     */
+    static inline bool cpu_snapshot_read_header(const MappedFile& file, std::uint32_t object, CpuSnapshotHeader& header) {
+        if (file.size() < sizeof(header)) {
+            return false;
+        }
+
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        return std::memcmp(header.magic, CPU_SNAPSHOT_MAGIC, sizeof(header.magic)) == 0 &&
+               header.version == CPU_SNAPSHOT_VERSION &&
+               header.byte_order == CPU_SNAPSHOT_BYTE_ORDER &&
+               header.index_size == sizeof(uint) &&
+               header.alignment > 0 &&
+               header.alignment <= CPU_SNAPSHOT_MAX_ALIGN &&
+               header.n_rows <= CPU_SNAPSHOT_MAX_SIZE &&
+               header.n_cols <= CPU_SNAPSHOT_MAX_SIZE &&
+               header.n_values <= CPU_SNAPSHOT_MAX_SIZE &&
+               header.object == object;
+    }
+
+    /**
+     * @brief Copies aligned arrays following the header from snapshot file
+     *
+     * @param file Mapped file with snapshot
+     * @param header Header of snapshot
+     * @param arrays List of pairs (data, size in bytes) to read
+     *
+     * @return True if file has enough data for all arrays
+     */
+    static inline bool cpu_snapshot_read(const MappedFile&                                    file,
+                                         const CpuSnapshotHeader&                             header,
+                                         std::initializer_list<std::pair<void*, std::size_t>> arrays) {
+        std::uint64_t offset = sizeof(header);
+
+        for (const auto& array : arrays) {
+            const std::uint64_t aligned = cpu_snapshot_align(offset, header.alignment);
+            if (aligned + array.second > file.size()) {
+                return false;
+            }
+            if (array.second > 0) {
+                std::memcpy(array.first, file.data() + aligned, array.second);
+            }
+            offset = aligned + array.second;
+        }
+
+        return true;
+    }
+
+    template<typename T>
+    T cpu_snapshot_fill_value(const CpuSnapshotHeader& header) {
+        T value;
+        std::memcpy(&value, header.fill_value, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    bool cpu_csr_save_snapshot(const std::filesystem::path& file_path,
+                               const std::string&           type_code,
+                               uint                         n_rows,
+                               uint                         n_cols,
+                               T                            fill_value,
+                               const CpuCsr<T>&             in) {
+        assert(in.Ap.size() == n_rows + 1);
+
+        const auto header = cpu_snapshot_header<T>(CPU_SNAPSHOT_MATRIX, uint(FormatMatrix::CpuCsr), type_code, n_rows, n_cols, in.values, fill_value);
+
+        return cpu_snapshot_write(file_path, header,
+                                  {{in.Ap.data(), in.Ap.size() * sizeof(uint)},
+                                   {in.Aj.data(), in.Aj.size() * sizeof(uint)},
+                                   {in.Ax.data(), in.Ax.size() * sizeof(T)}});
+    }
+
+    /**
+     * @brief Checks that loaded csr arrays are consistent, so kernels never index out of bounds
+     *
+     * @return True if offsets grow from zero to values count and each row has sorted columns less than `n_cols`
+     */
+    template<typename T>
+    bool cpu_csr_is_valid(std::uint64_t n_cols, const CpuCsr<T>& in) {
+        if (in.Ap.front() != 0 || in.Ap.back() != in.values) {
+            return false;
+        }
+        for (std::size_t i = 0; i + 1 < in.Ap.size(); i++) {
+            if (in.Ap[i] > in.Ap[i + 1]) {
+                return false;
+            }
+            for (uint k = in.Ap[i]; k < in.Ap[i + 1]; k++) {
+                if (in.Aj[k] >= n_cols || (k > in.Ap[i] && in.Aj[k - 1] >= in.Aj[k])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool cpu_csr_load_snapshot(const MappedFile&        file,
+                               const CpuSnapshotHeader& header,
+                               CpuCsr<T>&               out) {
+        // sizes fit into uint after header check, so the sum does not overflow
+        if (header.format != uint(FormatMatrix::CpuCsr) || header.value_size != sizeof(T) ||
+            (header.n_rows + 1 + header.n_values) * sizeof(uint) + header.n_values * sizeof(T) > file.size()) {
+            return false;
+        }
+
+        out.Ap.resize(header.n_rows + 1);
+        out.Aj.resize(header.n_values);
+        out.Ax.resize(header.n_values);
+        out.values = uint(header.n_values);
+
+        return cpu_snapshot_read(file, header,
+                                 {{out.Ap.data(), out.Ap.size() * sizeof(uint)},
+                                  {out.Aj.data(), out.Aj.size() * sizeof(uint)},
+                                  {out.Ax.data(), out.Ax.size() * sizeof(T)}}) &&
+               cpu_csr_is_valid(header.n_cols, out);
+    }
+
+    template<typename T>
+    bool cpu_coo_vec_save_snapshot(const std::filesystem::path& file_path,
+                                   const std::string&           type_code,
+                                   uint                         n_rows,
+                                   T                            fill_value,
+                                   const CpuCooVec<T>&          in) {
+        const auto header = cpu_snapshot_header<T>(CPU_SNAPSHOT_VECTOR, uint(FormatVector::CpuCoo), type_code, n_rows, 1, in.values, fill_value);
+
+        return cpu_snapshot_write(file_path, header,
+                                  {{in.Ai.data(), in.Ai.size() * sizeof(uint)},
+                                   {in.Ax.data(), in.Ax.size() * sizeof(T)}});
+    }
+
+    template<typename T>
+    bool cpu_coo_vec_load_snapshot(const MappedFile&        file,
+                                   const CpuSnapshotHeader& header,
+                                   CpuCooVec<T>&            out) {
+        if (header.format != uint(FormatVector::CpuCoo) || header.value_size != sizeof(T) ||
+            header.n_values * (sizeof(uint) + sizeof(T)) > file.size()) {
+            return false;
+        }
+
+        out.Ai.resize(header.n_values);
+        out.Ax.resize(header.n_values);
+        out.values = uint(header.n_values);
+
+        if (!cpu_snapshot_read(file, header,
+                               {{out.Ai.data(), out.Ai.size() * sizeof(uint)},
+                                {out.Ax.data(), out.Ax.size() * sizeof(T)}})) {
+            return false;
+        }
+
+        // indices must be sorted and less than vector size
+        for (uint k = 0; k < out.values; k++) {
+            if (out.Ai[k] >= header.n_rows || (k > 0 && out.Ai[k - 1] >= out.Ai[k])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_FORMAT_SNAPSHOT_HPP
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <functional>
 #include <numeric>
 #include <string>
@@ -60,6 +61,14 @@ namespace spla {
 
         using Reduce = std::function<T(T accum, T added)>;
 
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return Ax.mask() ? (Ax.mask() + 1) * (sizeof(typename decltype(Ax)::value_type) + 1) : 0;
+        }
+        void release() override {
+            decltype(Ax)().swap(Ax);
+            this->values = 0;
+        }
+
         robin_hood::unordered_flat_map<uint, T> Ax{};
         Reduce                                  reduce = [](T, T a) { return a; };
     };
@@ -77,6 +86,9 @@ namespace spla {
 
         ~CpuDenseVec() override = default;
 
+        // Array is sized once on construction, so it is not released
+        [[nodiscard]] std::size_t get_memory_usage() const override { return Ax.capacity() * sizeof(T); }
+
         std::vector<T> Ax{};
     };
 
@@ -93,6 +105,15 @@ namespace spla {
 
         ~CpuCooVec() override = default;
 
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return Ai.capacity() * sizeof(uint) + Ax.capacity() * sizeof(T);
+        }
+        void release() override {
+            std::vector<uint>().swap(Ai);
+            std::vector<T>().swap(Ax);
+            this->values = 0;
+        }
+
         std::vector<uint> Ai;
         std::vector<T>    Ax;
     };
@@ -114,6 +135,14 @@ namespace spla {
         using Row    = std::vector<Entry>;
         using Reduce = std::function<T(T accum, T added)>;
 
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return Ar.capacity() * sizeof(Row) + std::size_t(this->values) * sizeof(Entry);
+        }
+        void release() override {
+            std::vector<Row>().swap(Ar);
+            this->values = 0;
+        }
+
         std::vector<Row> Ar{};
         Reduce           reduce = [](T, T a) { return a; };
     };
@@ -134,6 +163,14 @@ namespace spla {
         using Key    = std::pair<uint, uint>;
         using Reduce = std::function<T(T accum, T added)>;
 
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return Ax.mask() ? (Ax.mask() + 1) * (sizeof(typename decltype(Ax)::value_type) + 1) : 0;
+        }
+        void release() override {
+            decltype(Ax)().swap(Ax);
+            this->values = 0;
+        }
+
         robin_hood::unordered_flat_map<Key, T, pair_hash> Ax;
         Reduce                                            reduce = [](T, T a) { return a; };
     };
@@ -151,6 +188,16 @@ namespace spla {
 
         ~CpuCoo() override = default;
 
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return (Ai.capacity() + Aj.capacity()) * sizeof(uint) + Ax.capacity() * sizeof(T);
+        }
+        void release() override {
+            std::vector<uint>().swap(Ai);
+            std::vector<uint>().swap(Aj);
+            std::vector<T>().swap(Ax);
+            this->values = 0;
+        }
+
         std::vector<uint> Ai;
         std::vector<uint> Aj;
         std::vector<T>    Ax;
@@ -169,11 +216,49 @@ namespace spla {
 
         ~CpuCsr() override = default;
 
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return (Ap.capacity() + Aj.capacity()) * sizeof(uint) + Ax.capacity() * sizeof(T);
+        }
+        void release() override {
+            std::vector<uint>().swap(Ap);
+            std::vector<uint>().swap(Aj);
+            std::vector<T>().swap(Ax);
+            this->values = 0;
+        }
+
         std::vector<uint> Ap;
         std::vector<uint> Aj;
         std::vector<T>    Ax;
     };
 
+    /**
+     * @class CpuCsc
+     * @brief CPU compressed sparse column matrix format
+     *
+     * @tparam T Type of elements
+     */
+    template<typename T>
+    class CpuCsc : public TDecoration<T> {
+    public:
+        static constexpr FormatMatrix FORMAT = FormatMatrix::CpuCsc;
+
+        ~CpuCsc() override = default;
+
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return (Ap.capacity() + Ai.capacity()) * sizeof(uint) + Ax.capacity() * sizeof(T);
+        }
+        void release() override {
+            std::vector<uint>().swap(Ap);
+            std::vector<uint>().swap(Ai);
+            std::vector<T>().swap(Ax);
+            this->values = 0;
+        }
+
+        std::vector<uint> Ap;
+        std::vector<uint> Ai;
+        std::vector<T>    Ax;
+    };
+
     /**
      * @}
      */
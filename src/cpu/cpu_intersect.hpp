@@ -0,0 +1,287 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_INTERSECT_HPP
+#define SPLA_CPU_INTERSECT_HPP
+
+#include <spla/config.hpp>
+
+#include <cpu/cpu_bitmap.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SPLA_CPU_INTERSECT_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /** Size ratio of sorted lists starting from which shorter list is searched in longer one */
+    static constexpr uint CPU_INTERSECT_GALLOP_RATIO = 32;
+    /** Min length of row intersected with many lists to probe lists against bitmap of row */
+    static constexpr uint CPU_INTERSECT_BITMAP_MIN_LEN = 256;
+
+    /**
+     * @brief Finds first position in sorted range with value not less than key
+     *
+     * Steps are doubled from the beginning of the range first, so the cost is
+     * logarithmic in the distance to found position rather than in range size.
+     */
+    static inline const uint* cpu_gallop(const uint* begin, const uint* end, uint key) {
+        std::size_t step = 1;
+        const uint* lo   = begin;
+
+        while (lo + step < end && lo[step] < key) {
+            lo += step;
+            step *= 2;
+        }
+
+        const uint* hi = lo + step < end ? lo + step + 1 : end;
+
+        while (lo < hi) {
+            const uint* mid = lo + (hi - lo) / 2;
+            if (*mid < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        return lo;
+    }
+
+#ifdef SPLA_CPU_INTERSECT_SSE2
+    /**
+     * @brief Compares block of four values of a with block of four values of b
+     *
+     * Block of b is rotated three times, so all 16 pairs are compared with four
+     * vector compares.
+     *
+     * @return Bit k is set if a[k] is equal to some value of block of b
+     */
+    static inline uint cpu_intersect_block4(const uint* a, const uint* b) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq         = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq         = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq         = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        return uint(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+    }
+#endif
+
+    /**
+     * @brief Calls func(ia, ib) for each pair of equal values of two sorted lists
+     *
+     * Lists of similar size are merged, by blocks of four values where SSE2 is
+     * available; if one list is much longer, each value of the shorter one is
+     * found in the rest of the longer one by galloping.
+     */
+    template<typename Func>
+    void cpu_intersect(const uint* a, uint na, const uint* b, uint nb, Func&& func) {
+        if (std::size_t(na) * CPU_INTERSECT_GALLOP_RATIO < nb || std::size_t(nb) * CPU_INTERSECT_GALLOP_RATIO < na) {
+            const bool  swap  = na > nb;
+            const uint* s     = swap ? b : a;
+            const uint* l     = swap ? a : b;
+            const uint  ns    = swap ? nb : na;
+            const uint* l_pos = l;
+            const uint* l_end = l + (swap ? na : nb);
+
+            for (uint is = 0; is < ns && l_pos < l_end; ++is) {
+                l_pos = cpu_gallop(l_pos, l_end, s[is]);
+
+                if (l_pos < l_end && *l_pos == s[is]) {
+                    const uint il = uint(l_pos - l);
+                    if (swap) {
+                        func(il, is);
+                    } else {
+                        func(is, il);
+                    }
+                    ++l_pos;
+                }
+            }
+            return;
+        }
+
+        uint ia = 0, ib = 0;
+
+#ifdef SPLA_CPU_INTERSECT_SSE2
+        while (ia + 4 <= na && ib + 4 <= nb) {
+            uint matched = cpu_intersect_block4(a + ia, b + ib);
+
+            while (matched) {
+                const uint ka = cpu_ctz64(matched);
+                uint       kb = 0;
+                while (b[ib + kb] != a[ia + ka]) ++kb;
+                func(ia + ka, ib + kb);
+                matched &= matched - 1;
+            }
+
+            const uint a_max = a[ia + 3];
+            const uint b_max = b[ib + 3];
+            ia += a_max <= b_max ? 4 : 0;
+            ib += b_max <= a_max ? 4 : 0;
+        }
+#endif
+
+        while (ia < na && ib < nb) {
+            if (a[ia] == b[ib]) {
+                func(ia, ib);
+                ++ia;
+                ++ib;
+            } else if (a[ia] < b[ib]) {
+                ++ia;
+            } else {
+                ++ib;
+            }
+        }
+    }
+
+    /**
+     * @brief Counts equal values of two sorted lists
+     *
+     * Merge has no unpredictable branches here: blocks of four values are
+     * compared at once where SSE2 is available, and in the tail the index of
+     * the list with smaller value is advanced by the result of comparison.
+     */
+    static inline uint cpu_intersect_count(const uint* a, uint na, const uint* b, uint nb) {
+        if (std::size_t(na) * CPU_INTERSECT_GALLOP_RATIO < nb || std::size_t(nb) * CPU_INTERSECT_GALLOP_RATIO < na) {
+            uint count = 0;
+            cpu_intersect(a, na, b, nb, [&](uint, uint) { ++count; });
+            return count;
+        }
+
+        uint count = 0;
+        uint ia = 0, ib = 0;
+
+#ifdef SPLA_CPU_INTERSECT_SSE2
+        while (ia + 4 <= na && ib + 4 <= nb) {
+            count += cpu_popcount64(cpu_intersect_block4(a + ia, b + ib));
+
+            const uint a_max = a[ia + 3];
+            const uint b_max = b[ib + 3];
+            ia += a_max <= b_max ? 4 : 0;
+            ib += b_max <= a_max ? 4 : 0;
+        }
+#endif
+
+        while (ia < na && ib < nb) {
+            const uint va = a[ia];
+            const uint vb = b[ib];
+            count += va == vb;
+            ia += va <= vb;
+            ib += vb <= va;
+        }
+
+        return count;
+    }
+
+    /**
+     * @class CpuRowIntersect
+     * @brief Intersects one sorted row with a number of other sorted lists
+     *
+     * Long row, which is intersected with more than one list, is scattered into
+     * bitmap once, and then values of each shorter list are probed against it,
+     * so the cost of intersection does not depend on the length of the row.
+     * Other pairs are intersected with cpu_intersect.
+     */
+    struct CpuRowIntersect {
+        CpuBitmap   bits;
+        const uint* row   = nullptr;
+        uint        len   = 0;
+        bool        probe = false;
+
+        /** Starts row, which will be intersected with n_lists lists of values less than n_cols */
+        void begin(const uint* row_values, uint row_len, uint n_lists, uint n_cols) {
+            row   = row_values;
+            len   = row_len;
+            probe = len >= CPU_INTERSECT_BITMAP_MIN_LEN && n_lists > 1;
+
+            if (probe) {
+                if (bits.words.size() < CpuBitmap::words_count(n_cols)) bits.resize(n_cols);
+                for (uint k = 0; k < len; ++k) bits.set(row[k]);
+            }
+        }
+
+        /** Finishes row, only words touched by the row are cleared */
+        void end() {
+            if (probe) {
+                for (uint k = 0; k < len; ++k) bits.words[row[k] / CpuBitmap::BITS] = 0;
+            }
+        }
+
+        /** Calls func(i_row, i_list) for each pair of equal values of row and list */
+        template<typename Func>
+        void intersect(const uint* list, uint list_len, Func&& func) const {
+            if (!probe || list_len >= len) {
+                cpu_intersect(row, len, list, list_len, std::forward<Func>(func));
+                return;
+            }
+
+            const uint* row_pos = row;
+            const uint* row_end = row + len;
+
+            for (uint k = 0; k < list_len; ++k) {
+                if (bits.test(list[k])) {
+                    row_pos = cpu_gallop(row_pos, row_end, list[k]);
+                    func(uint(row_pos - row), k);
+                    ++row_pos;
+                }
+            }
+        }
+
+        /** Counts equal values of row and list */
+        uint count(const uint* list, uint list_len) const {
+            if (!probe || list_len >= len) {
+                return cpu_intersect_count(row, len, list, list_len);
+            }
+
+            uint count = 0;
+            for (uint k = 0; k < list_len; ++k) {
+                count += bits.test(list[k]);
+            }
+
+            return count;
+        }
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_INTERSECT_HPP
@@ -61,6 +61,9 @@ namespace spla {
             auto t = ctx.task.template cast_safe<ScheduleTask_m_extract_column>();
             auto M = t->M.template cast_safe<TMatrix<T>>();
 
+            if (M->is_valid(FormatMatrix::CpuCsc)) {
+                return execute_csc(ctx);
+            }
             if (M->is_valid(FormatMatrix::CpuCsr)) {
                 return execute_csr(ctx);
             }
@@ -170,6 +173,37 @@ namespace spla {
 
             return Status::Ok;
         }
+
+        Status execute_csc(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/m_extract_column_csc");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_m_extract_column>();
+
+            ref_ptr<TVector<T>>     r        = t->r.template cast_safe<TVector<T>>();
+            ref_ptr<TMatrix<T>>     M        = t->M.template cast_safe<TMatrix<T>>();
+            ref_ptr<TOpUnary<T, T>> op_apply = t->op_apply.template cast_safe<TOpUnary<T, T>>();
+            uint                    index    = t->index;
+
+            r->validate_wd(FormatVector::CpuCoo);
+            M->validate_rw(FormatMatrix::CpuCsc);
+
+            CpuCooVec<T>*    p_coo_r    = r->template get<CpuCooVec<T>>();
+            const CpuCsc<T>* p_csc_M    = M->template get<CpuCsc<T>>();
+            auto&            func_apply = op_apply->function;
+
+            const uint col_begin = p_csc_M->Ap[index];
+            const uint col_end   = p_csc_M->Ap[index + 1];
+
+            p_coo_r->values = col_end - col_begin;
+            p_coo_r->Ai.assign(p_csc_M->Ai.begin() + col_begin, p_csc_M->Ai.begin() + col_end);
+            p_coo_r->Ax.resize(col_end - col_begin);
+
+            for (uint k = col_begin; k < col_end; k++) {
+                p_coo_r->Ax[k - col_begin] = func_apply(p_csc_M->Ax[k]);
+            }
+
+            return Status::Ok;
+        }
     };
 
 }// namespace spla
@@ -59,6 +59,9 @@ namespace spla {
             auto t = ctx.task.template cast_safe<ScheduleTask_m_reduce_by_column>();
             auto M = t->M.template cast_safe<TMatrix<T>>();
 
+            if (M->is_valid(FormatMatrix::CpuCsc)) {
+                return execute_csc(ctx);
+            }
             if (M->is_valid(FormatMatrix::CpuLil)) {
                 return execute_lil(ctx);
             }
@@ -124,6 +127,36 @@ namespace spla {
 
             return Status::Ok;
         }
+
+        Status execute_csc(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/m_reduce_by_column_csc");
+
+            auto t         = ctx.task.template cast_safe<ScheduleTask_m_reduce_by_column>();
+            auto r         = t->r.template cast_safe<TVector<T>>();
+            auto M         = t->M.template cast_safe<TMatrix<T>>();
+            auto op_reduce = t->op_reduce.template cast_safe<TOpBinary<T, T, T>>();
+            auto init      = t->init.template cast_safe<TScalar<T>>();
+
+            r->validate_wd(FormatVector::CpuDense);
+            M->validate_rw(FormatMatrix::CpuCsc);
+
+            CpuDenseVec<T>*  p_dense_r = r->template get<CpuDenseVec<T>>();
+            const CpuCsc<T>* p_csc_M   = M->template get<CpuCsc<T>>();
+
+            auto& func_reduce = op_reduce->function;
+
+            for (uint j = 0; j < M->get_n_cols(); j++) {
+                T sum = init->get_value();
+
+                for (uint k = p_csc_M->Ap[j]; k < p_csc_M->Ap[j + 1]; k++) {
+                    sum = func_reduce(sum, p_csc_M->Ax[k]);
+                }
+
+                p_dense_r->Ax[j] = sum;
+            }
+
+            return Status::Ok;
+        }
     };
 
 }// namespace spla
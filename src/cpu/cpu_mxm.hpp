@@ -38,7 +38,13 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
+#include <cpu/cpu_accumulators.hpp>
+#include <cpu/cpu_parallel.hpp>
+
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
 
 namespace spla {
 
@@ -52,11 +58,24 @@ namespace spla {
         }
 
         std::string get_description() override {
-            return "sequential sparse matrix sparse matrix product on cpu";
+            return "parallel sparse matrix sparse matrix product on cpu";
         }
 
         Status execute(const DispatchContext& ctx) override {
-            TIME_PROFILE_SCOPE("cpu/mxm");
+            auto t = ctx.task.template cast_safe<ScheduleTask_mxm>();
+            auto A = t->A.template cast_safe<TMatrix<T>>();
+            auto B = t->B.template cast_safe<TMatrix<T>>();
+
+            if (A->is_valid(FormatMatrix::CpuCsr) && B->is_valid(FormatMatrix::CpuCsr)) {
+                return execute_csr(ctx);
+            }
+
+            return execute_lil(ctx);
+        }
+
+    private:
+        Status execute_lil(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/mxm_lil");
 
             auto t = ctx.task.template cast_safe<ScheduleTask_mxm>();
 
@@ -66,6 +85,7 @@ namespace spla {
             auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
             auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
             auto init        = t->init.template cast_safe<TScalar<T>>();
+            auto desc        = t->get_desc_or_default();
 
             R->validate_wd(FormatMatrix::CpuLil);
             A->validate_rw(FormatMatrix::CpuLil);
@@ -78,43 +98,190 @@ namespace spla {
             auto& func_multiply = op_multiply->function;
             auto& func_add      = op_add->function;
 
-            auto DM = R->get_n_rows();
-            auto DN = R->get_n_cols();
-            auto I  = init->get_value();
+            const uint DM = R->get_n_rows();
+            const uint DN = R->get_n_cols();
+            const T    I  = init->get_value();
 
-            std::vector<T> R_tmp(DN, I);
+            const CpuLilRows<T> rows_A(*p_lil_A);
+            const CpuLilRows<T> rows_B(*p_lil_B);
+
+            // estimate work per row as number of products to compute
+            std::vector<std::uint64_t> flops(DM + 1, 0);
 
             for (uint row_R = 0; row_R < DM; row_R++) {
-                const auto& A_lst = p_lil_A->Ar[row_R];
-                auto&       R_lst = p_lil_R->Ar[row_R];
+                std::uint64_t row_flops = 0;
+
+                for (const typename CpuLil<T>::Entry& entry_A : p_lil_A->Ar[row_R]) {
+                    row_flops += p_lil_B->Ar[entry_A.first].size();
+                }
+
+                flops[row_R] = row_flops;
+            }
+
+            std::exclusive_scan(flops.begin(), flops.end(), flops.begin(), std::uint64_t(0));
+
+            const uint n_threads = flops.back() >= PARALLEL_MIN_FLOPS ? cpu_threads_count(desc) : 1u;
 
-                assert(R_lst.empty());
+            std::vector<uint> chunks;
+            cpu_split_by_work(flops, n_threads * CHUNKS_PER_THREAD, chunks);
 
-                std::fill(R_tmp.begin(), R_tmp.end(), I);
+            using RowProduct = CpuRowProduct<T, CpuLilRows<T>, CpuLilRows<T>>;
+            std::vector<RowProduct> products(n_threads, RowProduct(rows_A, rows_B, DN, desc->get_accumulator()));
 
-                for (const typename CpuLil<T>::Entry& entry_A : A_lst) {
-                    const uint i       = entry_A.first;
-                    const T    value_A = entry_A.second;
+            cpu_parallel_for(n_threads, uint(chunks.size() - 1), [&](uint chunk_id, uint thread_id) {
+                RowProduct& product = products[thread_id];
 
-                    const auto& B_lst = p_lil_B->Ar[i];
+                for (uint row_R = chunks[chunk_id]; row_R < chunks[chunk_id + 1]; row_R++) {
+                    auto& R_lst = p_lil_R->Ar[row_R];
 
-                    for (const typename CpuLil<T>::Entry& entry_B : B_lst) {
-                        const uint j       = entry_B.first;
-                        const T    value_B = entry_B.second;
+                    assert(R_lst.empty());
 
-                        R_tmp[j] = func_add(R_tmp[j], func_multiply(value_A, value_B));
-                    }
+                    product.compute(row_R, flops[row_R + 1] - flops[row_R], I, func_multiply, func_add, [&](uint col_R, T value) {
+                        R_lst.emplace_back(col_R, value);
+                    });
                 }
+            });
+
+            uint values = 0;
+            for (uint row_R = 0; row_R < DM; row_R++) {
+                values += uint(p_lil_R->Ar[row_R].size());
+            }
+            p_lil_R->values = values;
+
+            return Status::Ok;
+        }
+
+        Status execute_csr(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/mxm_csr");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_mxm>();
+
+            auto R           = t->R.template cast_safe<TMatrix<T>>();
+            auto A           = t->A.template cast_safe<TMatrix<T>>();
+            auto B           = t->B.template cast_safe<TMatrix<T>>();
+            auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
+            auto init        = t->init.template cast_safe<TScalar<T>>();
+            auto desc        = t->get_desc_or_default();
+
+            R->validate_wd(FormatMatrix::CpuCsr);
+            A->validate_rw(FormatMatrix::CpuCsr);
+            B->validate_rw(FormatMatrix::CpuCsr);
+
+            CpuCsr<T>*       p_csr_R = R->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_A = A->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_B = B->template get<CpuCsr<T>>();
+
+            auto& func_multiply = op_multiply->function;
+            auto& func_add      = op_add->function;
 
-                for (uint col_R = 0; col_R < DN; col_R++) {
-                    if (R_tmp[col_R] != I) {
-                        R_lst.emplace_back(col_R, R_tmp[col_R]);
-                    }
+            const uint DM = R->get_n_rows();
+            const uint DN = R->get_n_cols();
+            const T    I  = init->get_value();
+
+            const auto& Ap = p_csr_A->Ap;
+            const auto& Aj = p_csr_A->Aj;
+            const auto& Bp = p_csr_B->Ap;
+
+            const CpuCsrRows<T> rows_A(*p_csr_A);
+            const CpuCsrRows<T> rows_B(*p_csr_B);
+
+            // estimate work per row as number of products to compute
+            std::vector<std::uint64_t> flops(DM + 1, 0);
+
+            for (uint row_R = 0; row_R < DM; row_R++) {
+                std::uint64_t row_flops = 0;
+
+                for (uint k = Ap[row_R]; k < Ap[row_R + 1]; k++) {
+                    row_flops += Bp[Aj[k] + 1] - Bp[Aj[k]];
+                }
+
+                flops[row_R] = row_flops;
+            }
+
+            std::exclusive_scan(flops.begin(), flops.end(), flops.begin(), std::uint64_t(0));
+
+            const uint n_threads = flops.back() >= PARALLEL_MIN_FLOPS ? cpu_threads_count(desc) : 1u;
+
+            std::vector<uint> chunks;
+            cpu_split_by_work(flops, n_threads * CHUNKS_PER_THREAD, chunks);
+
+            const uint n_chunks = uint(chunks.size() - 1);
+
+            using RowProduct = CpuRowProduct<T, CpuCsrRows<T>, CpuCsrRows<T>>;
+            std::vector<RowProduct> products(n_threads, RowProduct(rows_A, rows_B, DN, desc->get_accumulator()));
+
+            auto& Rp = p_csr_R->Ap;
+            auto& Rj = p_csr_R->Aj;
+            auto& Rx = p_csr_R->Ax;
+
+            Rp.assign(DM + 1, 0);
+
+            // symbolic phase: count distinct columns of each row to size R
+            cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint thread_id) {
+                RowProduct& product = products[thread_id];
+
+                for (uint row_R = chunks[chunk_id]; row_R < chunks[chunk_id + 1]; row_R++) {
+                    Rp[row_R] = product.count(row_R, flops[row_R + 1] - flops[row_R]);
                 }
+            });
+
+            std::exclusive_scan(Rp.begin(), Rp.end(), Rp.begin(), 0u);
+
+            Rj.resize(Rp[DM]);
+            Rx.resize(Rp[DM]);
+
+            // numeric phase: accumulate products and write sorted rows in place;
+            // accumulators are sized per row, so a thread may take numeric chunks
+            // without having run any symbolic chunk
+            std::vector<uint> row_sizes(DM, 0);
+
+            cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint thread_id) {
+                RowProduct& product = products[thread_id];
+
+                for (uint row_R = chunks[chunk_id]; row_R < chunks[chunk_id + 1]; row_R++) {
+                    const uint row_begin = Rp[row_R];
+                    uint       row_size  = 0;
+
+                    product.compute(row_R, flops[row_R + 1] - flops[row_R], I, func_multiply, func_add, [&](uint col_R, T value) {
+                        Rj[row_begin + row_size] = col_R;
+                        Rx[row_begin + row_size] = value;
+                        row_size += 1;
+                    });
+
+                    assert(row_size <= Rp[row_R + 1] - row_begin);
+
+                    row_sizes[row_R] = row_size;
+                }
+            });
+
+            // compact rows if some accumulated values are equal to init and were dropped
+            uint values = 0;
+            for (uint row_R = 0; row_R < DM; row_R++) {
+                const uint row_begin = Rp[row_R];
+                const uint row_size  = row_sizes[row_R];
+
+                if (values != row_begin) {
+                    std::copy(Rj.begin() + row_begin, Rj.begin() + row_begin + row_size, Rj.begin() + values);
+                    std::copy(Rx.begin() + row_begin, Rx.begin() + row_begin + row_size, Rx.begin() + values);
+                }
+
+                Rp[row_R] = values;
+                values += row_size;
             }
 
+            Rp[DM] = values;
+            Rj.resize(values);
+            Rx.resize(values);
+            p_csr_R->values = values;
+
             return Status::Ok;
         }
+
+        /** Min total number of products to run product on multiple threads */
+        static constexpr std::uint64_t PARALLEL_MIN_FLOPS = 1u << 16u;
+        /** Number of work chunks per thread for dynamic balancing of skewed rows */
+        static constexpr uint CHUNKS_PER_THREAD = 8;
     };
 
 }// namespace spla
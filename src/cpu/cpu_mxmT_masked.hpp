@@ -38,8 +38,36 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
+#include <cpu/cpu_intersect.hpp>
+#include <cpu/cpu_parallel.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
 namespace spla {
 
+    /**
+     * @brief Splits rows of masked product into chunks by the total length of lists to intersect
+     */
+    template<typename T>
+    void cpu_mxmT_split_rows(const CpuCsr<T>* p_csr_mask, const CpuCsr<T>* p_csr_A, const CpuCsr<T>* p_csr_B,
+                             uint DM, uint n_chunks, std::vector<uint>& chunks) {
+        std::vector<std::uint64_t> work(DM + 1, 0);
+
+        for (uint i = 0; i < DM; ++i) {
+            const uint A_len = p_csr_A->Ap[i + 1] - p_csr_A->Ap[i];
+
+            for (uint k = p_csr_mask->Ap[i]; k < p_csr_mask->Ap[i + 1]; ++k) {
+                const uint j = p_csr_mask->Aj[k];
+                work[i] += A_len + p_csr_B->Ap[j + 1] - p_csr_B->Ap[j];
+            }
+        }
+
+        std::exclusive_scan(work.begin(), work.end(), work.begin(), std::uint64_t(0));
+        cpu_split_by_work(work, n_chunks, chunks);
+    }
+
     template<typename T>
     class Algo_mxmT_masked_cpu final : public RegistryAlgo {
     public:
@@ -50,7 +78,7 @@ namespace spla {
         }
 
         std::string get_description() override {
-            return "sequential masked matrix matrix-transposed product on cpu";
+            return "parallel masked matrix matrix-transposed product on cpu";
         }
 
         Status execute(const DispatchContext& ctx) override {
@@ -66,66 +94,89 @@ namespace spla {
             auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
             auto op_select   = t->op_select.template cast_safe<TOpSelect<T>>();
             auto init        = t->init.template cast_safe<TScalar<T>>();
+            auto desc        = t->get_desc_or_default();
 
             R->validate_wd(FormatMatrix::CpuLil);
-            A->validate_rw(FormatMatrix::CpuLil);
-            B->validate_rw(FormatMatrix::CpuLil);
-            mask->validate_rw(FormatMatrix::CpuLil);
+            A->validate_rw(FormatMatrix::CpuCsr);
+            B->validate_rw(FormatMatrix::CpuCsr);
+            mask->validate_rw(FormatMatrix::CpuCsr);
 
             CpuLil<T>*       p_lil_R    = R->template get<CpuLil<T>>();
-            const CpuLil<T>* p_lil_A    = A->template get<CpuLil<T>>();
-            const CpuLil<T>* p_lil_B    = B->template get<CpuLil<T>>();
-            const CpuLil<T>* p_lil_mask = mask->template get<CpuLil<T>>();
+            const CpuCsr<T>* p_csr_A    = A->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_B    = B->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_mask = mask->template get<CpuCsr<T>>();
 
             auto& func_multiply = op_multiply->function;
             auto& func_add      = op_add->function;
             auto& func_select   = op_select->function;
 
-            auto DM = R->get_n_rows();
-            auto I  = init->get_value();
+            const uint DM = R->get_n_rows();
+            const uint DK = A->get_n_cols();
+            const T    I  = init->get_value();
+
+            const uint n_threads = p_csr_mask->values >= PARALLEL_MIN_NNZ ? cpu_threads_count(desc) : 1u;
+
+            std::vector<uint> chunks;
+            if (n_threads > 1) {
+                cpu_mxmT_split_rows(p_csr_mask, p_csr_A, p_csr_B, DM, n_threads * CHUNKS_PER_THREAD, chunks);
+            } else {
+                chunks.assign({0u, DM});
+            }
+
+            const uint n_chunks = uint(chunks.size() - 1);
+
+            std::vector<CpuRowIntersect> row_intersect(n_threads);
+            std::vector<std::size_t>     values(n_chunks, 0);
 
-            for (uint row_R = 0; row_R < DM; row_R++) {
-                const auto& mask_lst = p_lil_mask->Ar[row_R];
-                const auto& A_lst    = p_lil_A->Ar[row_R];
-                auto&       R_lst    = p_lil_R->Ar[row_R];
+            cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint thread_id) {
+                CpuRowIntersect& A_row     = row_intersect[thread_id];
+                std::size_t      n_written = 0;
 
-                assert(R_lst.empty());
+                for (uint i = chunks[chunk_id]; i < chunks[chunk_id + 1]; ++i) {
+                    const uint mask_begin = p_csr_mask->Ap[i];
+                    const uint mask_end   = p_csr_mask->Ap[i + 1];
+                    const T*   A_val      = p_csr_A->Ax.data() + p_csr_A->Ap[i];
+                    auto&      R_lst      = p_lil_R->Ar[i];
 
-                for (const typename CpuLil<T>::Entry& entry_mask : mask_lst) {
-                    const uint mask_i = entry_mask.first;
-                    const T    mask_x = entry_mask.second;
+                    assert(R_lst.empty());
 
-                    T r = I;
+                    A_row.begin(p_csr_A->Aj.data() + p_csr_A->Ap[i], p_csr_A->Ap[i + 1] - p_csr_A->Ap[i], mask_end - mask_begin, DK);
 
-                    if (func_select(mask_x)) {
-                        const auto& B_lst = p_lil_B->Ar[mask_i];
+                    for (uint k = mask_begin; k < mask_end; ++k) {
+                        const uint mask_i = p_csr_mask->Aj[k];
 
-                        auto       A_it  = A_lst.begin();
-                        auto       B_it  = B_lst.begin();
-                        const auto A_end = A_lst.end();
-                        const auto B_end = B_lst.end();
+                        T r = I;
 
-                        while (A_it != A_end && B_it != B_end) {
-                            if (A_it->first == B_it->first) {
-                                r = func_add(r, func_multiply(A_it->second, B_it->second));
-                                ++A_it;
-                                ++B_it;
-                            } else if (A_it->first < B_it->first) {
-                                ++A_it;
-                            } else {
-                                ++B_it;
-                            }
+                        if (func_select(p_csr_mask->Ax[k])) {
+                            const T* B_val = p_csr_B->Ax.data() + p_csr_B->Ap[mask_i];
+
+                            A_row.intersect(p_csr_B->Aj.data() + p_csr_B->Ap[mask_i], p_csr_B->Ap[mask_i + 1] - p_csr_B->Ap[mask_i], [&](uint ia, uint ib) {
+                                r = func_add(r, func_multiply(A_val[ia], B_val[ib]));
+                            });
                         }
-                    }
 
-                    if (r != I) {
-                        R_lst.emplace_back(mask_i, r);
+                        if (r != I) {
+                            R_lst.emplace_back(mask_i, r);
+                        }
                     }
+
+                    A_row.end();
+                    n_written += R_lst.size();
                 }
-            }
+
+                values[chunk_id] = n_written;
+            });
+
+            p_lil_R->values = uint(std::accumulate(values.begin(), values.end(), std::size_t(0)));
 
             return Status::Ok;
         }
+
+    private:
+        /** Min number of mask entries to run on multiple threads */
+        static constexpr uint PARALLEL_MIN_NNZ = 1u << 12u;
+        /** Number of work chunks per thread for dynamic balancing of skewed rows */
+        static constexpr uint CHUNKS_PER_THREAD = 8;
     };
 
 }// namespace spla
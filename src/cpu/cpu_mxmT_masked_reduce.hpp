@@ -0,0 +1,270 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/JetBrains-Research/spla                                     */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_MXMT_MASKED_REDUCE_HPP
+#define SPLA_CPU_MXMT_MASKED_REDUCE_HPP
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/registry.hpp>
+#include <core/tmatrix.hpp>
+#include <core/top.hpp>
+#include <core/tscalar.hpp>
+#include <core/ttype.hpp>
+#include <core/tvector.hpp>
+
+#include <cpu/cpu_intersect.hpp>
+#include <cpu/cpu_mxmT_masked.hpp>
+#include <cpu/cpu_parallel.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace spla {
+
+    template<typename T>
+    class Algo_mxmT_masked_reduce_cpu final : public RegistryAlgo {
+    public:
+        ~Algo_mxmT_masked_reduce_cpu() override = default;
+
+        std::string get_name() override {
+            return "mxmT_masked_reduce";
+        }
+
+        std::string get_description() override {
+            return "parallel masked matrix matrix-transposed product reduced to scalar on cpu";
+        }
+
+        Status execute(const DispatchContext& ctx) override {
+            auto t = ctx.task.template cast_safe<ScheduleTask_mxmT_masked_reduce>();
+
+            if constexpr (std::is_same<T, T_INT>::value) {
+                if (t->op_multiply == MULT_INT && t->op_add == PLUS_INT && t->get_desc_or_default()->get_struct_only()) {
+                    return execute_count(ctx);
+                }
+            }
+
+            return execute_generic(ctx);
+        }
+
+    private:
+        /**
+         * @brief Splits rows of mask into chunks by the total length of lists to intersect
+         *
+         * @return Number of threads to use
+         */
+        uint split_rows(const DispatchContext& ctx, std::vector<uint>& chunks) {
+            auto t    = ctx.task.template cast_safe<ScheduleTask_mxmT_masked_reduce>();
+            auto mask = t->mask.template cast_safe<TMatrix<T>>();
+            auto desc = t->get_desc_or_default();
+
+            const CpuCsr<T>* p_csr_mask = mask->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_A    = t->A.template cast_safe<TMatrix<T>>()->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_B    = t->B.template cast_safe<TMatrix<T>>()->template get<CpuCsr<T>>();
+
+            const uint DM = mask->get_n_rows();
+
+            uint n_threads = p_csr_mask->values >= PARALLEL_MIN_NNZ ? cpu_threads_count(desc) : 1u;
+
+            if (n_threads == 1) {
+                chunks.assign({0u, DM});
+                return 1u;
+            }
+
+            cpu_mxmT_split_rows(p_csr_mask, p_csr_A, p_csr_B, DM, n_threads * CHUNKS_PER_THREAD, chunks);
+
+            return n_threads;
+        }
+
+        /**
+         * @brief Counts common entries of rows of A and B for entries of mask
+         *
+         * Structure only: values of A and B are not read, so each product is one.
+         */
+        Status execute_count(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/mxmT_masked_reduce_count");
+
+            auto t         = ctx.task.template cast_safe<ScheduleTask_mxmT_masked_reduce>();
+            auto r         = t->r.template cast_safe<TScalar<T>>();
+            auto s         = t->s.template cast_safe<TScalar<T>>();
+            auto mask      = t->mask.template cast_safe<TMatrix<T>>();
+            auto A         = t->A.template cast_safe<TMatrix<T>>();
+            auto B         = t->B.template cast_safe<TMatrix<T>>();
+            auto op_select = t->op_select.template cast_safe<TOpSelect<T>>();
+
+            mask->validate_rw(FormatMatrix::CpuCsr);
+            A->validate_rw(FormatMatrix::CpuCsr);
+            B->validate_rw(FormatMatrix::CpuCsr);
+
+            const CpuCsr<T>* p_csr_mask = mask->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_A    = A->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_B    = B->template get<CpuCsr<T>>();
+
+            auto& func_select = op_select->function;
+
+            std::vector<uint> chunks;
+            const uint        n_threads = split_rows(ctx, chunks);
+            const uint        n_chunks  = uint(chunks.size() - 1);
+
+            const uint DK = A->get_n_cols();
+
+            std::vector<std::uint64_t>   counts(n_chunks, 0);
+            std::vector<CpuRowIntersect> row_intersect(n_threads);
+
+            cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint thread_id) {
+                CpuRowIntersect& A_row = row_intersect[thread_id];
+                std::uint64_t    count = 0;
+
+                for (uint i = chunks[chunk_id]; i < chunks[chunk_id + 1]; ++i) {
+                    const uint mask_begin = p_csr_mask->Ap[i];
+                    const uint mask_end   = p_csr_mask->Ap[i + 1];
+
+                    A_row.begin(p_csr_A->Aj.data() + p_csr_A->Ap[i], p_csr_A->Ap[i + 1] - p_csr_A->Ap[i], mask_end - mask_begin, DK);
+
+                    for (uint k = mask_begin; k < mask_end; ++k) {
+                        if (!func_select(p_csr_mask->Ax[k])) continue;
+
+                        const uint j = p_csr_mask->Aj[k];
+                        count += A_row.count(p_csr_B->Aj.data() + p_csr_B->Ap[j], p_csr_B->Ap[j + 1] - p_csr_B->Ap[j]);
+                    }
+
+                    A_row.end();
+                }
+
+                counts[chunk_id] = count;
+            });
+
+            // count is not truncated silently if it does not fit into scalar
+            const std::uint64_t total = std::accumulate(counts.begin(), counts.end(), std::uint64_t(0));
+
+            if (total > std::uint64_t(std::numeric_limits<T>::max())) return Status::Error;
+
+            const std::int64_t result = std::int64_t(s->get_value()) + std::int64_t(total);
+
+            if (result > std::int64_t(std::numeric_limits<T>::max())) return Status::Error;
+
+            r->get_value() = T(result);
+
+            return Status::Ok;
+        }
+
+        /**
+         * @brief Sums products of matching entries with user ops
+         *
+         * Partial sums are kept per chunk and added in chunk order, so result
+         * does not depend on number of threads.
+         */
+        Status execute_generic(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/mxmT_masked_reduce");
+
+            auto t           = ctx.task.template cast_safe<ScheduleTask_mxmT_masked_reduce>();
+            auto r           = t->r.template cast_safe<TScalar<T>>();
+            auto s           = t->s.template cast_safe<TScalar<T>>();
+            auto mask        = t->mask.template cast_safe<TMatrix<T>>();
+            auto A           = t->A.template cast_safe<TMatrix<T>>();
+            auto B           = t->B.template cast_safe<TMatrix<T>>();
+            auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_select   = t->op_select.template cast_safe<TOpSelect<T>>();
+
+            mask->validate_rw(FormatMatrix::CpuCsr);
+            A->validate_rw(FormatMatrix::CpuCsr);
+            B->validate_rw(FormatMatrix::CpuCsr);
+
+            const CpuCsr<T>* p_csr_mask = mask->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_A    = A->template get<CpuCsr<T>>();
+            const CpuCsr<T>* p_csr_B    = B->template get<CpuCsr<T>>();
+
+            auto& func_multiply = op_multiply->function;
+            auto& func_add      = op_add->function;
+            auto& func_select   = op_select->function;
+
+            std::vector<uint> chunks;
+            const uint        n_threads = split_rows(ctx, chunks);
+            const uint        n_chunks  = uint(chunks.size() - 1);
+
+            const uint DK = A->get_n_cols();
+
+            std::vector<T>               sums(n_chunks, T());
+            std::vector<char>            has_sum(n_chunks, 0);
+            std::vector<CpuRowIntersect> row_intersect(n_threads);
+
+            cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint thread_id) {
+                CpuRowIntersect& A_row = row_intersect[thread_id];
+                T                sum   = T();
+                bool             has   = false;
+
+                for (uint i = chunks[chunk_id]; i < chunks[chunk_id + 1]; ++i) {
+                    const uint mask_begin = p_csr_mask->Ap[i];
+                    const uint mask_end   = p_csr_mask->Ap[i + 1];
+                    const T*   A_val      = p_csr_A->Ax.data() + p_csr_A->Ap[i];
+
+                    A_row.begin(p_csr_A->Aj.data() + p_csr_A->Ap[i], p_csr_A->Ap[i + 1] - p_csr_A->Ap[i], mask_end - mask_begin, DK);
+
+                    for (uint k = mask_begin; k < mask_end; ++k) {
+                        if (!func_select(p_csr_mask->Ax[k])) continue;
+
+                        const uint j     = p_csr_mask->Aj[k];
+                        const T*   B_val = p_csr_B->Ax.data() + p_csr_B->Ap[j];
+
+                        A_row.intersect(p_csr_B->Aj.data() + p_csr_B->Ap[j], p_csr_B->Ap[j + 1] - p_csr_B->Ap[j], [&](uint ia, uint ib) {
+                            const T product = func_multiply(A_val[ia], B_val[ib]);
+                            sum             = has ? func_add(sum, product) : product;
+                            has             = true;
+                        });
+                    }
+
+                    A_row.end();
+                }
+
+                sums[chunk_id]    = sum;
+                has_sum[chunk_id] = has;
+            });
+
+            T result = s->get_value();
+            for (uint chunk_id = 0; chunk_id < n_chunks; ++chunk_id) {
+                if (has_sum[chunk_id]) result = func_add(result, sums[chunk_id]);
+            }
+
+            r->get_value() = result;
+
+            return Status::Ok;
+        }
+
+        /** Min number of mask entries to run on multiple threads */
+        static constexpr uint PARALLEL_MIN_NNZ = 1u << 12u;
+        /** Number of work chunks per thread for dynamic balancing of skewed rows */
+        static constexpr uint CHUNKS_PER_THREAD = 8;
+    };
+
+}// namespace spla
+
+#endif//SPLA_CPU_MXMT_MASKED_REDUCE_HPP
@@ -38,6 +38,16 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
+#include <cpu/cpu_bitmap.hpp>
+#include <cpu/cpu_parallel.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
 namespace spla {
 
     template<typename T>
@@ -50,7 +60,7 @@ namespace spla {
         }
 
         std::string get_description() override {
-            return "sequential masked matrix-vector product on cpu";
+            return "parallel masked matrix-vector product on cpu";
         }
 
         Status execute(const DispatchContext& ctx) override {
@@ -58,52 +68,316 @@ namespace spla {
 
             auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
 
-            auto r           = t->r.template cast_safe<TVector<T>>();
-            auto mask        = t->mask.template cast_safe<TVector<T>>();
-            auto M           = t->M.template cast_safe<TMatrix<T>>();
-            auto v           = t->v.template cast_safe<TVector<T>>();
             auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
             auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
-            auto op_select   = t->op_select.template cast_safe<TOpSelect<T>>();
-            auto init        = t->init.template cast_safe<TScalar<T>>();
+
+            // built-in semirings of bfs, sssp and pr get inlined kernels with reordered reduction
+            if constexpr (std::is_same<T, T_FLOAT>::value) {
+                auto plus = [](T a, T b) { return a + b; };
+                auto mult = [](T a, T b) { return a * b; };
+                auto min  = [](T a, T b) { return std::min(a, b); };
+
+                if (t->op_multiply == MULT_FLOAT && t->op_add == PLUS_FLOAT) {
+                    return execute_csr<true>(ctx, mult, plus, T(0));
+                }
+                if (t->op_multiply == PLUS_FLOAT && t->op_add == MIN_FLOAT) {
+                    return execute_csr<true>(ctx, plus, min, std::numeric_limits<T>::infinity());
+                }
+            }
+            if constexpr (std::is_same<T, T_INT>::value) {
+                auto bor  = [](T a, T b) { return a | b; };
+                auto band = [](T a, T b) { return a & b; };
+                auto desc = t->get_desc_or_default();
+
+                if (t->op_multiply == BAND_INT && t->op_add == BOR_INT) {
+                    if (desc->get_early_exit() && desc->get_struct_only()) {
+                        auto eqzero = [](T a) { return a == 0; };
+
+                        if (t->op_select == EQZERO_INT) {
+                            return execute_pull(ctx, eqzero);
+                        }
+                        return execute_pull(ctx, t->op_select.template cast_safe<TOpSelect<T>>()->function);
+                    }
+                    return execute_csr<true>(ctx, band, bor, T(0));
+                }
+                if (t->op_multiply == BONE_INT && t->op_add == PLUS_INT && !desc->get_early_exit()) {
+                    return execute_degree(ctx);
+                }
+            }
+
+            return execute_csr<false>(ctx, op_multiply->function, op_add->function, T());
+        }
+
+    private:
+        /**
+         * @class Scratch
+         * @brief Buffers of pull step kept with prepared task between executions
+         */
+        struct Scratch final : public ScheduleTaskScratch {
+            CpuBitmap         frontier;
+            std::vector<uint> rows;
+            std::vector<uint> work;
+            std::vector<uint> chunks;
+        };
+
+        /**
+         * @brief Structural pull step of bfs over bitmap of frontier
+         *
+         * Rows selected by mask are compacted into a list first, so visited vertices
+         * cost nothing beyond the mask scan, and work is balanced by the length of
+         * the remaining rows only. Frontier is tested by bits, which keeps it in cache
+         * for large graphs. Row gets init | 1 if it has an entry in frontier and init otherwise,
+         * as generic path does with entries and frontier taken as ones.
+         */
+        template<typename FuncSelect>
+        Status execute_pull(const DispatchContext& ctx, FuncSelect&& func_select) {
+            TIME_PROFILE_SCOPE("cpu/mxv_pull");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
+
+            auto r    = t->r.template cast_safe<TVector<T>>();
+            auto mask = t->mask.template cast_safe<TVector<T>>();
+            auto M    = t->M.template cast_safe<TMatrix<T>>();
+            auto v    = t->v.template cast_safe<TVector<T>>();
+            auto init = t->init.template cast_safe<TScalar<T>>();
+            auto desc = t->get_desc_or_default();
 
             const uint DM       = M->get_n_rows();
             const T    sum_init = init->get_value();
+            const T    sum_hit  = sum_init | T(1);
+
+            Scratch&   scratch  = t->template get_scratch<Scratch>();
+            CpuBitmap& frontier = scratch.frontier;
+
+            // sparse frontier after push step is scattered into bits without densification
+            frontier.resize(v->get_n_rows());
+
+            if (v->is_valid(FormatVector::CpuCoo)) {
+                v->validate_rw(FormatVector::CpuCoo);
+                const CpuCooVec<T>* p_sparse_v = v->template get<CpuCooVec<T>>();
+
+                for (uint idx = 0; idx < p_sparse_v->values; ++idx) {
+                    if (p_sparse_v->Ax[idx] != T()) frontier.set(p_sparse_v->Ai[idx]);
+                }
+            } else {
+                v->validate_rw(FormatVector::CpuDense);
+                const CpuDenseVec<T>* p_dense_v = v->template get<CpuDenseVec<T>>();
+
+                const uint n_words = uint(frontier.words.size());
+                const uint n       = v->get_n_rows();
+
+                // dense frontier after pull step is packed word by word without branches
+                for (uint w = 0; w < n_words; ++w) {
+                    const uint    begin = w * CpuBitmap::BITS;
+                    const uint    end   = std::min(begin + CpuBitmap::BITS, n);
+                    std::uint64_t word  = 0;
+                    for (uint i = begin; i < end; ++i) {
+                        word |= std::uint64_t(p_dense_v->Ax[i] != T()) << (i - begin);
+                    }
+                    frontier.words[w] = word;
+                }
+            }
 
             r->validate_wd(FormatVector::CpuDense);
             mask->validate_rw(FormatVector::CpuDense);
-            v->validate_rw(FormatVector::CpuDense);
-            M->validate_rw(FormatMatrix::CpuLil);
+            M->validate_rw(FormatMatrix::CpuCsr);
 
             CpuDenseVec<T>*       p_dense_r    = r->template get<CpuDenseVec<T>>();
             const CpuDenseVec<T>* p_dense_mask = mask->template get<CpuDenseVec<T>>();
-            const CpuDenseVec<T>* p_dense_v    = v->template get<CpuDenseVec<T>>();
-            const CpuLil<T>*      p_lil_M      = M->template get<CpuLil<T>>();
-            auto                  early_exit   = t->get_desc_or_default()->get_early_exit();
+            const CpuCsr<T>*      p_csr_M      = M->template get<CpuCsr<T>>();
 
-            auto& func_multiply = op_multiply->function;
-            auto& func_add      = op_add->function;
-            auto& func_select   = op_select->function;
+            const uint* Ap     = p_csr_M->Ap.data();
+            const uint* Aj     = p_csr_M->Aj.data();
+            const T*    mask_x = p_dense_mask->Ax.data();
+            T*          r_x    = p_dense_r->Ax.data();
 
+            auto& rows   = scratch.rows;
+            auto& work   = scratch.work;
+            auto& chunks = scratch.chunks;
+
+            rows.clear();
             for (uint i = 0; i < DM; ++i) {
-                T sum = sum_init;
+                if (func_select(mask_x[i])) rows.push_back(i);
+            }
 
-                if (func_select(p_dense_mask->Ax[i])) {
-                    const auto& row = p_lil_M->Ar[i];
+            std::fill(r_x, r_x + DM, sum_init);
 
-                    for (const auto& j_x : row) {
-                        const uint j = j_x.first;
-                        sum          = func_add(sum, func_multiply(j_x.second, p_dense_v->Ax[j]));
+            // work of remaining rows is needed only to balance threads
+            uint n_threads = Ap[DM] >= PARALLEL_MIN_NNZ ? cpu_threads_count(desc) : 1u;
 
-                        if ((sum != sum_init) && early_exit) break;
+            if (n_threads > 1) {
+                work.resize(rows.size() + 1);
+                for (std::size_t k = 0; k < rows.size(); ++k) {
+                    work[k] = Ap[rows[k] + 1] - Ap[rows[k]];
+                }
+                work.back() = 0;
+                std::exclusive_scan(work.begin(), work.end(), work.begin(), 0u);
+
+                if (work.back() < PARALLEL_MIN_NNZ) n_threads = 1;
+            }
+            if (n_threads > 1) {
+                cpu_split_by_work(work, n_threads * CHUNKS_PER_THREAD, chunks);
+            } else {
+                chunks.assign({0u, uint(rows.size())});
+            }
+
+            cpu_parallel_for(n_threads, uint(chunks.size() - 1), [&](uint chunk_id, uint) {
+                for (uint k = chunks[chunk_id]; k < chunks[chunk_id + 1]; ++k) {
+                    const uint i = rows[k];
+
+                    for (uint e = Ap[i]; e < Ap[i + 1]; ++e) {
+                        if (frontier.test(Aj[e])) {
+                            r_x[i] = sum_hit;
+                            break;
+                        }
                     }
                 }
+            });
+
+            return Status::Ok;
+        }
+
+        /**
+         * @brief Counts entries of selected rows, reads row offsets only
+         */
+        Status execute_degree(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/mxv_degree");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
 
-                p_dense_r->Ax[i] = sum;
+            auto r         = t->r.template cast_safe<TVector<T>>();
+            auto mask      = t->mask.template cast_safe<TVector<T>>();
+            auto M         = t->M.template cast_safe<TMatrix<T>>();
+            auto op_select = t->op_select.template cast_safe<TOpSelect<T>>();
+            auto init      = t->init.template cast_safe<TScalar<T>>();
+
+            const uint DM       = M->get_n_rows();
+            const T    sum_init = init->get_value();
+
+            r->validate_wd(FormatVector::CpuDense);
+            M->validate_rw(FormatMatrix::CpuCsr);
+
+            CpuDenseVec<T>*  p_dense_r = r->template get<CpuDenseVec<T>>();
+            const CpuCsr<T>* p_csr_M   = M->template get<CpuCsr<T>>();
+
+            // mask is not read at all if every row is selected
+            if (t->op_select == ALWAYS_INT) {
+                for (uint i = 0; i < DM; ++i) {
+                    p_dense_r->Ax[i] = sum_init + T(p_csr_M->Ap[i + 1] - p_csr_M->Ap[i]);
+                }
+                return Status::Ok;
+            }
+
+            mask->validate_rw(FormatVector::CpuDense);
+            const CpuDenseVec<T>* p_dense_mask = mask->template get<CpuDenseVec<T>>();
+
+            auto& func_select = op_select->function;
+
+            for (uint i = 0; i < DM; ++i) {
+                const T degree   = T(p_csr_M->Ap[i + 1] - p_csr_M->Ap[i]);
+                p_dense_r->Ax[i] = func_select(p_dense_mask->Ax[i]) ? sum_init + degree : sum_init;
             }
 
             return Status::Ok;
         }
+
+        /**
+         * @brief Computes masked product over csr rows in parallel
+         *
+         * @tparam Lanes If true, row is reduced in LANES independent partial sums starting
+         *               from `identity` of add op; allowed for associative and commutative ops only
+         */
+        template<bool Lanes, typename FuncMult, typename FuncAdd>
+        Status execute_csr(const DispatchContext& ctx, FuncMult&& func_multiply, FuncAdd&& func_add, T identity) {
+            auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
+
+            auto r         = t->r.template cast_safe<TVector<T>>();
+            auto mask      = t->mask.template cast_safe<TVector<T>>();
+            auto M         = t->M.template cast_safe<TMatrix<T>>();
+            auto v         = t->v.template cast_safe<TVector<T>>();
+            auto op_select = t->op_select.template cast_safe<TOpSelect<T>>();
+            auto init      = t->init.template cast_safe<TScalar<T>>();
+            auto desc      = t->get_desc_or_default();
+
+            const uint DM       = M->get_n_rows();
+            const T    sum_init = init->get_value();
+
+            r->validate_wd(FormatVector::CpuDense);
+            mask->validate_rw(FormatVector::CpuDense);
+            v->validate_rw(FormatVector::CpuDense);
+            M->validate_rw(FormatMatrix::CpuCsr);
+
+            CpuDenseVec<T>*       p_dense_r    = r->template get<CpuDenseVec<T>>();
+            const CpuDenseVec<T>* p_dense_mask = mask->template get<CpuDenseVec<T>>();
+            const CpuDenseVec<T>* p_dense_v    = v->template get<CpuDenseVec<T>>();
+            const CpuCsr<T>*      p_csr_M      = M->template get<CpuCsr<T>>();
+            const bool            early_exit   = desc->get_early_exit();
+
+            auto& func_select = op_select->function;
+
+            const uint* Ap     = p_csr_M->Ap.data();
+            const uint* Aj     = p_csr_M->Aj.data();
+            const T*    Ax     = p_csr_M->Ax.data();
+            const T*    v_x    = p_dense_v->Ax.data();
+            const T*    mask_x = p_dense_mask->Ax.data();
+            T*          r_x    = p_dense_r->Ax.data();
+
+            const uint n_threads = Ap[DM] >= PARALLEL_MIN_NNZ ? cpu_threads_count(desc) : 1u;
+
+            std::vector<uint> chunks;
+            cpu_split_by_work(p_csr_M->Ap, n_threads * CHUNKS_PER_THREAD, chunks);
+
+            cpu_parallel_for(n_threads, uint(chunks.size() - 1), [&](uint chunk_id, uint) {
+                for (uint i = chunks[chunk_id]; i < chunks[chunk_id + 1]; ++i) {
+                    T sum = sum_init;
+
+                    if (func_select(mask_x[i])) {
+                        const uint begin = Ap[i];
+                        const uint end   = Ap[i + 1];
+
+                        if (early_exit) {
+                            // exit exactly at the first product changing the sum, as sequential loop does
+                            for (uint k = begin; k < end; ++k) {
+                                sum = func_add(sum, func_multiply(Ax[k], v_x[Aj[k]]));
+                                if (sum != sum_init) break;
+                            }
+                        } else if constexpr (Lanes) {
+                            T    lanes[LANES];
+                            uint k = begin;
+
+                            std::fill(lanes, lanes + LANES, identity);
+
+                            for (; k + LANES <= end; k += LANES) {
+                                for (uint l = 0; l < LANES; ++l) {
+                                    lanes[l] = func_add(lanes[l], func_multiply(Ax[k + l], v_x[Aj[k + l]]));
+                                }
+                            }
+                            for (; k < end; ++k) {
+                                lanes[0] = func_add(lanes[0], func_multiply(Ax[k], v_x[Aj[k]]));
+                            }
+                            for (uint l = 0; l < LANES; ++l) {
+                                sum = func_add(sum, lanes[l]);
+                            }
+                        } else {
+                            for (uint k = begin; k < end; ++k) {
+                                sum = func_add(sum, func_multiply(Ax[k], v_x[Aj[k]]));
+                            }
+                        }
+                    }
+
+                    r_x[i] = sum;
+                }
+            });
+
+            return Status::Ok;
+        }
+
+        /** Min number of matrix entries to run product on multiple threads */
+        static constexpr uint PARALLEL_MIN_NNZ = 1u << 16u;
+        /** Number of work chunks per thread for dynamic balancing of skewed rows */
+        static constexpr uint CHUNKS_PER_THREAD = 8;
+        /** Number of independent partial sums of a row, fits single simd register of floats */
+        static constexpr uint LANES = 8;
     };
 
 }// namespace spla
@@ -0,0 +1,135 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_PARALLEL_HPP
+#define SPLA_CPU_PARALLEL_HPP
+
+#include <spla/config.hpp>
+#include <spla/descriptor.hpp>
+#include <spla/library.hpp>
+
+#include <cpu/cpu_thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @brief Resolves number of cpu threads to use for a task
+     *
+     * @param desc Descriptor of the task; threads count 0 means all threads of library pool
+     *
+     * @return Number of threads, always at least 1
+     */
+    static inline uint cpu_threads_count(const ref_ptr<Descriptor>& desc) {
+        const int requested = desc ? desc->get_threads_count() : 0;
+        if (requested > 0) {
+            return uint(requested);
+        }
+        return Library::get()->get_cpu_pool()->get_threads_count();
+    }
+
+    /**
+     * @brief Splits range of rows into chunks with approximately equal work
+     *
+     * @param work_offsets Exclusive prefix sum of per-row work of size n_rows + 1
+     * @param n_chunks Desired number of chunks
+     * @param chunks Output chunk boundaries (rows), size is actual chunks count + 1
+     *
+     * @tparam Offset Type of work offsets, for example row pointers of csr matrix
+     */
+    template<typename Offset>
+    void cpu_split_by_work(const std::vector<Offset>& work_offsets,
+                           uint                       n_chunks,
+                           std::vector<uint>&         chunks) {
+        const uint          n_rows = uint(work_offsets.size() - 1);
+        const std::uint64_t total  = work_offsets.back();
+
+        chunks.clear();
+        chunks.push_back(0);
+
+        for (uint k = 1; k < n_chunks; k++) {
+            const Offset target = Offset(total * k / n_chunks);
+            const uint   row    = uint(std::lower_bound(work_offsets.begin(), work_offsets.end(), target) - work_offsets.begin());
+
+            if (row > chunks.back() && row < n_rows) {
+                chunks.push_back(row);
+            }
+        }
+
+        if (chunks.back() != n_rows || chunks.size() == 1) {
+            chunks.push_back(n_rows);
+        }
+    }
+
+    /**
+     * @brief Executes chunks of work on a number of cpu threads
+     *
+     * Chunks are dynamically taken by threads from shared counter, so threads
+     * which finished its work earlier take the remaining chunks of slower ones.
+     * Threads are taken from library cpu pool; calling thread participates
+     * in execution as the thread with id 0.
+     *
+     * @param n_threads Number of threads to use
+     * @param n_chunks Number of chunks to process
+     * @param func Function called as func(chunk_id, thread_id)
+     */
+    template<typename Func>
+    void cpu_parallel_for(uint n_threads, uint n_chunks, Func&& func) {
+        n_threads = std::max(1u, std::min(n_threads, n_chunks));
+
+        if (n_threads == 1) {
+            for (uint chunk_id = 0; chunk_id < n_chunks; chunk_id++) {
+                func(chunk_id, 0u);
+            }
+            return;
+        }
+
+        std::atomic_uint next_chunk{0};
+
+        Library::get()->get_cpu_pool()->execute(n_threads, [&](uint thread_id) {
+            for (uint chunk_id = next_chunk++; chunk_id < n_chunks; chunk_id = next_chunk++) {
+                func(chunk_id, thread_id);
+            }
+        });
+    }
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_PARALLEL_HPP
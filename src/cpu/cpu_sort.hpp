@@ -0,0 +1,194 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_SORT_HPP
+#define SPLA_CPU_SORT_HPP
+
+#include <spla/config.hpp>
+
+#include <cpu/cpu_parallel.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /** Number of key bits sorted by a single radix sort pass */
+    static constexpr uint CPU_RADIX_BITS = 8;
+    /** Number of buckets in a single radix sort pass */
+    static constexpr uint CPU_RADIX_BUCKETS = 1u << CPU_RADIX_BITS;
+    /** Minimum number of entries per thread in sort and reduce of sorted entries */
+    static constexpr std::size_t CPU_SORT_PARALLEL_MIN = 1 << 16;
+
+    /**
+     * @brief Number of significant bits of value, zero for zero
+     */
+    static inline uint cpu_bits_count(std::uint64_t value) {
+        uint bits = 0;
+        while (bits < 64 && (value >> bits)) bits++;
+        return bits;
+    }
+
+    /**
+     * @brief Number of contiguous blocks of entries processed independently in sort and reduce
+     */
+    static inline uint cpu_sort_blocks_count(std::size_t n, uint n_threads) {
+        return uint(std::max<std::size_t>(1, std::min<std::size_t>(n_threads, n / CPU_SORT_PARALLEL_MIN)));
+    }
+
+    /**
+     * @brief Stable parallel lsd radix sort of entries by integer key
+     *
+     * Each pass counts digits per block of entries, then every block scatters its
+     * entries into its own bucket-major slice of temporary buffer, so passes
+     * need no synchronization except between count and scatter. Passes where
+     * all entries share the same digit are skipped.
+     *
+     * @param entries Entries to sort
+     * @param tmp Temporary buffer, resized to entries count
+     * @param n_bits Number of lower bits of key which may be not zero
+     * @param n_threads Number of threads to use
+     * @param key_of Function returning key of entry as unsigned integer
+     */
+    template<typename Entry, typename KeyOf>
+    void cpu_radix_sort(std::vector<Entry>& entries, std::vector<Entry>& tmp, uint n_bits, uint n_threads, KeyOf&& key_of) {
+        const std::size_t n = entries.size();
+
+        if (n < 2) return;
+
+        const uint n_blocks = cpu_sort_blocks_count(n, n_threads);
+
+        std::vector<std::size_t> offsets(std::size_t(n_blocks) * CPU_RADIX_BUCKETS);
+        tmp.resize(n);
+
+        auto block_begin = [&](uint block) { return n * block / n_blocks; };
+
+        for (uint shift = 0; shift < n_bits; shift += CPU_RADIX_BITS) {
+            auto digit_of = [&](const Entry& entry) { return uint(std::uint64_t(key_of(entry)) >> shift) & (CPU_RADIX_BUCKETS - 1); };
+
+            cpu_parallel_for(n_threads, n_blocks, [&](uint block, uint) {
+                std::size_t* count = offsets.data() + std::size_t(block) * CPU_RADIX_BUCKETS;
+                std::fill(count, count + CPU_RADIX_BUCKETS, 0);
+                for (std::size_t k = block_begin(block); k < block_begin(block + 1); k++) {
+                    count[digit_of(entries[k])]++;
+                }
+            });
+
+            const uint  first_digit = digit_of(entries[0]);
+            std::size_t first_count = 0;
+            for (uint block = 0; block < n_blocks; block++) {
+                first_count += offsets[std::size_t(block) * CPU_RADIX_BUCKETS + first_digit];
+            }
+            if (first_count == n) continue;
+
+            // bucket-major order of blocks keeps sort stable
+            std::size_t offset = 0;
+            for (uint bucket = 0; bucket < CPU_RADIX_BUCKETS; bucket++) {
+                for (uint block = 0; block < n_blocks; block++) {
+                    std::size_t& count = offsets[std::size_t(block) * CPU_RADIX_BUCKETS + bucket];
+                    std::size_t  size  = count;
+                    count              = offset;
+                    offset += size;
+                }
+            }
+
+            cpu_parallel_for(n_threads, n_blocks, [&](uint block, uint) {
+                std::size_t* write = offsets.data() + std::size_t(block) * CPU_RADIX_BUCKETS;
+                for (std::size_t k = block_begin(block); k < block_begin(block + 1); k++) {
+                    tmp[write[digit_of(entries[k])]++] = entries[k];
+                }
+            });
+
+            entries.swap(tmp);
+        }
+    }
+
+    /**
+     * @brief Reduces runs of entries with equal keys of sorted entries into single entries
+     *
+     * Entries are split into blocks starting at runs, so each block counts and
+     * then writes its runs independently of other blocks.
+     *
+     * @param entries Entries sorted by key
+     * @param result Reduced entries, one per key in order of keys
+     * @param n_threads Number of threads to use
+     * @param key_of Function returning key of entry
+     * @param reduce Function called as reduce(accum, entry) for each next entry of run
+     */
+    template<typename Entry, typename KeyOf, typename Reduce>
+    void cpu_reduce_sorted(const std::vector<Entry>& entries, std::vector<Entry>& result, uint n_threads, KeyOf&& key_of, Reduce&& reduce) {
+        const std::size_t n        = entries.size();
+        const uint        n_blocks = cpu_sort_blocks_count(n, n_threads);
+
+        auto is_first = [&](std::size_t k) { return k == 0 || key_of(entries[k]) != key_of(entries[k - 1]); };
+
+        std::vector<std::size_t> blocks_begin(n_blocks + 1, n);
+        blocks_begin[0] = 0;
+        for (uint block = 1; block < n_blocks; block++) {
+            std::size_t k = std::max(n * block / n_blocks, blocks_begin[block - 1]);
+            while (k < n && !is_first(k)) k++;
+            blocks_begin[block] = k;
+        }
+
+        std::vector<std::size_t> blocks_offsets(n_blocks + 1, 0);
+        cpu_parallel_for(n_threads, n_blocks, [&](uint block, uint) {
+            std::size_t count = 0;
+            for (std::size_t k = blocks_begin[block]; k < blocks_begin[block + 1]; k++) {
+                count += is_first(k);
+            }
+            blocks_offsets[block + 1] = count;
+        });
+        std::partial_sum(blocks_offsets.begin(), blocks_offsets.end(), blocks_offsets.begin());
+
+        result.resize(blocks_offsets.back());
+
+        cpu_parallel_for(n_threads, n_blocks, [&](uint block, uint) {
+            std::size_t write = blocks_offsets[block];
+            for (std::size_t k = blocks_begin[block]; k < blocks_begin[block + 1]; k++) {
+                if (is_first(k)) {
+                    result[write++] = entries[k];
+                } else {
+                    reduce(result[write - 1], entries[k]);
+                }
+            }
+        });
+    }
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_SORT_HPP
@@ -0,0 +1,297 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "cpu_thread_pool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace spla {
+
+    // set for threads executing parallel section, so nested sections run sequentially
+    static thread_local bool t_in_parallel = false;
+
+    class CpuParallelScope {
+    public:
+        CpuParallelScope() : m_prev(t_in_parallel) { t_in_parallel = true; }
+        ~CpuParallelScope() { t_in_parallel = m_prev; }
+
+    private:
+        bool m_prev;
+    };
+
+#if defined(__linux__)
+    static std::vector<int> parse_cpu_list(const std::string& list) {
+        std::vector<int>  cpus;
+        std::stringstream stream(list);
+        std::string       range;
+
+        while (std::getline(stream, range, ',')) {
+            if (range.empty() || range == "\n") continue;
+
+            const auto dash  = range.find('-');
+            const int  first = std::stoi(range.substr(0, dash));
+            const int  last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+            for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+        }
+
+        return cpus;
+    }
+
+    static std::vector<std::vector<int>> read_numa_nodes(const cpu_set_t& allowed) {
+        std::vector<std::pair<int, std::vector<int>>> nodes;
+        std::error_code                               error;
+
+        for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+            const std::string name = entry.path().filename().string();
+            if (name.rfind("node", 0) != 0 || name.size() <= 4 || !std::isdigit(name[4])) continue;
+
+            std::ifstream file(entry.path() / "cpulist");
+            std::string   list;
+            if (!std::getline(file, list)) continue;
+
+            std::vector<int> cpus;
+            for (int cpu : parse_cpu_list(list)) {
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+            }
+            if (!cpus.empty()) nodes.emplace_back(std::stoi(name.substr(4)), std::move(cpus));
+        }
+
+        std::sort(nodes.begin(), nodes.end());
+
+        std::vector<std::vector<int>> result;
+        for (auto& node : nodes) result.push_back(std::move(node.second));
+        return result;
+    }
+#endif
+
+    CpuThreadPool::CpuThreadPool(uint threads_count, bool pin) {
+        m_threads_count = std::max(1u, threads_count);
+        m_pinned        = pin;
+        m_thread_cpu.assign(m_threads_count, -1);
+        m_thread_node.assign(m_threads_count, 0);
+        m_errors.resize(m_threads_count);
+
+        setup_topology();
+
+        m_workers.reserve(m_threads_count - 1);
+        for (uint thread_id = 1; thread_id < m_threads_count; thread_id++) {
+            m_workers.emplace_back([this, thread_id]() { worker_main(thread_id); });
+        }
+    }
+
+    CpuThreadPool::~CpuThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv_work.notify_all();
+
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void CpuThreadPool::execute(uint threads_count, const std::function<void(uint)>& func) {
+        threads_count = std::max(1u, threads_count);
+
+        std::unique_lock<std::mutex> execute_lock(m_execute_mutex, std::defer_lock);
+
+        if (threads_count == 1 || m_threads_count == 1 || t_in_parallel || !execute_lock.try_lock()) {
+            CpuParallelScope scope;
+            for (uint thread_id = 0; thread_id < threads_count; thread_id++) {
+                func(thread_id);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_generation += 1;
+            m_func    = &func;
+            m_ids     = threads_count;
+            m_active  = std::min(threads_count, m_threads_count);
+            m_pending = m_active - 1;
+        }
+        m_cv_work.notify_all();
+
+        run(0);
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv_done.wait(lock, [&]() { return m_pending == 0; });
+            m_func = nullptr;
+        }
+
+        for (auto& error : m_errors) {
+            if (error) {
+                std::exception_ptr first = error;
+                std::fill(m_errors.begin(), m_errors.end(), nullptr);
+                std::rethrow_exception(first);
+            }
+        }
+    }
+
+    void CpuThreadPool::first_touch(void* data, std::size_t bytes) {
+#if defined(__linux__)
+        if (!m_pinned || m_nodes_count < 2 || bytes < FIRST_TOUCH_MIN_BYTES || t_in_parallel) {
+            return;
+        }
+
+        const auto page  = std::uintptr_t(sysconf(_SC_PAGESIZE));
+        const auto begin = (std::uintptr_t(data) + page - 1) / page * page;
+        const auto end   = (std::uintptr_t(data) + bytes) / page * page;
+
+        if (end <= begin) {
+            return;
+        }
+
+        // released pages of private memory are zero filled again on next access by the accessing node
+        if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED) != 0) {
+            return;
+        }
+
+        const std::size_t n_pages = (end - begin) / page;
+
+        execute(m_threads_count, [&](uint thread_id) {
+            const std::size_t first = n_pages * thread_id / m_threads_count;
+            const std::size_t last  = n_pages * (thread_id + 1) / m_threads_count;
+
+            for (std::size_t i = first; i < last; i++) {
+                *reinterpret_cast<volatile char*>(begin + i * page) = 0;
+            }
+        });
+#else
+        (void) data;
+        (void) bytes;
+#endif
+    }
+
+    void CpuThreadPool::setup_topology() {
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+            m_pinned = false;
+            return;
+        }
+
+        std::vector<std::vector<int>> nodes = read_numa_nodes(allowed);
+        if (nodes.empty()) {
+            std::vector<int> cpus;
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+            }
+            nodes.push_back(std::move(cpus));
+        }
+
+        std::size_t total = 0;
+        for (auto& node : nodes) total += node.size();
+
+        // each node gets contiguous range of thread ids proportional to its cpus
+        uint        thread_id = 0;
+        std::size_t preceding = 0;
+        for (std::size_t node_id = 0; node_id < nodes.size(); node_id++) {
+            preceding += nodes[node_id].size();
+            const uint end = uint(std::size_t(m_threads_count) * preceding / total);
+
+            for (uint k = 0; thread_id < end; thread_id++, k++) {
+                m_thread_node[thread_id] = uint(node_id);
+                m_thread_cpu[thread_id]  = nodes[node_id][k % nodes[node_id].size()];
+            }
+        }
+
+        m_nodes_count = uint(nodes.size());
+#else
+        m_pinned = false;
+#endif
+    }
+
+    void CpuThreadPool::worker_main(uint thread_id) {
+#if defined(__linux__)
+        if (m_pinned && m_thread_cpu[thread_id] >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(m_thread_cpu[thread_id], &cpus);
+            pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        }
+#endif
+
+        std::uint64_t seen = 0;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv_work.wait(lock, [&]() { return m_stop || m_generation != seen; });
+                if (m_stop) {
+                    return;
+                }
+                seen = m_generation;
+                if (thread_id >= m_active) {
+                    continue;
+                }
+            }
+
+            run(thread_id);
+
+            bool is_last;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                is_last = --m_pending == 0;
+            }
+            if (is_last) {
+                m_cv_done.notify_all();
+            }
+        }
+    }
+
+    void CpuThreadPool::run(uint thread_id) {
+        CpuParallelScope scope;
+
+        // ids above pool size are executed by pool threads in turn
+        try {
+            for (uint id = thread_id; id < m_ids; id += m_active) {
+                (*m_func)(id);
+            }
+        } catch (...) {
+            m_errors[thread_id] = std::current_exception();
+        }
+    }
+
+}// namespace spla
@@ -0,0 +1,133 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_THREAD_POOL_HPP
+#define SPLA_CPU_THREAD_POOL_HPP
+
+#include <spla/config.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class CpuThreadPool
+     * @brief Persistent pool of threads executing parallel cpu kernels
+     *
+     * Pool is owned by library and shared by all kernels. Calling thread participates
+     * in execution as thread with id 0, so pool starts `threads - 1` workers.
+     *
+     * Threads ids are partitioned by NUMA nodes: each node gets contiguous range of ids
+     * proportional to its number of available cpus. If pinning is enabled, worker is bound
+     * to a single cpu of its node, so statically partitioned data is processed by the same node.
+     */
+    class CpuThreadPool {
+    public:
+        CpuThreadPool(uint threads_count, bool pin);
+        ~CpuThreadPool();
+
+        CpuThreadPool(const CpuThreadPool&) = delete;
+        CpuThreadPool& operator=(const CpuThreadPool&) = delete;
+
+        /**
+         * @brief Calls func(thread_id) once for each thread id in [0, threads_count)
+         *
+         * If called from inside of a parallel section or while pool is busy with
+         * other caller, all thread ids are executed sequentially by calling thread.
+         * Exceptions thrown by func are re-thrown in calling thread.
+         *
+         * @param threads_count Number of thread ids; ids above pool size are executed by pool threads in turn
+         * @param func Function to execute
+         */
+        void execute(uint threads_count, const std::function<void(uint)>& func);
+
+        /**
+         * @brief Places zeroed memory pages on NUMA nodes of threads which will process them
+         *
+         * Range is split into equal contiguous parts touched by threads in order of ids.
+         * Pages of the range are released and touched again by the threads, so
+         * memory must be zero filled (for example, freshly value-initialized).
+         * Does nothing without pinning or on a single node system.
+         *
+         * @param data Pointer to zeroed memory
+         * @param bytes Size of memory in bytes
+         */
+        void first_touch(void* data, std::size_t bytes);
+
+        [[nodiscard]] uint get_threads_count() const { return m_threads_count; }
+        [[nodiscard]] uint get_nodes_count() const { return m_nodes_count; }
+        [[nodiscard]] bool is_pinned() const { return m_pinned; }
+        [[nodiscard]] uint get_thread_node(uint thread_id) const { return m_thread_node[thread_id]; }
+
+        /** Min size of memory worth placing on nodes */
+        static constexpr std::size_t FIRST_TOUCH_MIN_BYTES = 1024 * 1024;
+
+    private:
+        void setup_topology();
+        void worker_main(uint thread_id);
+        void run(uint thread_id);
+
+    private:
+        uint              m_threads_count;
+        uint              m_nodes_count = 1;
+        bool              m_pinned      = false;
+        std::vector<int>  m_thread_cpu; // cpu of thread to pin to, -1 if none
+        std::vector<uint> m_thread_node;// numa node of thread
+
+        std::vector<std::thread>         m_workers;
+        std::mutex                       m_execute_mutex;
+        std::mutex                       m_mutex;
+        std::condition_variable          m_cv_work;
+        std::condition_variable          m_cv_done;
+        std::uint64_t                    m_generation = 0;
+        bool                             m_stop       = false;
+        uint                             m_ids        = 0;
+        uint                             m_active     = 0;
+        uint                             m_pending    = 0;
+        const std::function<void(uint)>* m_func       = nullptr;
+        std::vector<std::exception_ptr>  m_errors;
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_THREAD_POOL_HPP
@@ -0,0 +1,239 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_V_FUSED_HPP
+#define SPLA_CPU_V_FUSED_HPP
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/registry.hpp>
+#include <core/top.hpp>
+#include <core/tscalar.hpp>
+#include <core/ttype.hpp>
+#include <core/tvector.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace spla {
+
+    template<typename T>
+    class Algo_v_fused_cpu final : public RegistryAlgo {
+    public:
+        ~Algo_v_fused_cpu() override = default;
+
+        std::string get_name() override {
+            return "v_fused";
+        }
+
+        std::string get_description() override {
+            return "sequential fused element-wise vector operations on cpu";
+        }
+
+        Status execute(const DispatchContext& ctx) override {
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_fused>();
+
+            std::vector<Stage> stages;
+            if (!collect_stages(t, stages)) {
+                return execute_tasks(ctx);
+            }
+
+            return execute_dn(ctx, stages);
+        }
+
+    private:
+        enum class StageKind {
+            Eadd,
+            Map,
+            Reduce
+        };
+
+        struct Stage {
+            StageKind                   kind;
+            ref_ptr<TVector<T>>         r;
+            ref_ptr<TVector<T>>         u;
+            ref_ptr<TVector<T>>         v;
+            ref_ptr<TScalar<T>>         r_scalar;
+            ref_ptr<TScalar<T>>         s_scalar;
+            ref_ptr<TOpBinary<T, T, T>> op_binary;
+            ref_ptr<TOpUnary<T, T>>     op_unary;
+        };
+
+        static bool collect_stages(const ref_ptr<ScheduleTask_v_fused>& t, std::vector<Stage>& stages) {
+            // accelerated algorithms of chained tasks are preferred to cpu fused loop
+            Library* g_lib = Library::get();
+            if (g_lib->get_accelerator() && !g_lib->is_set_force_no_acceleration()) {
+                return false;
+            }
+
+            for (auto& task : t->tasks) {
+                Stage stage{};
+
+                if (auto eadd = task.template cast<ScheduleTask_v_eadd>()) {
+                    stage.kind      = StageKind::Eadd;
+                    stage.r         = eadd->r.template cast<TVector<T>>();
+                    stage.u         = eadd->u.template cast<TVector<T>>();
+                    stage.v         = eadd->v.template cast<TVector<T>>();
+                    stage.op_binary = eadd->op.template cast<TOpBinary<T, T, T>>();
+                    if (!stage.r || !stage.u || !stage.v || !stage.op_binary) return false;
+                } else if (auto map = task.template cast<ScheduleTask_v_map>()) {
+                    stage.kind     = StageKind::Map;
+                    stage.r        = map->r.template cast<TVector<T>>();
+                    stage.v        = map->v.template cast<TVector<T>>();
+                    stage.op_unary = map->op.template cast<TOpUnary<T, T>>();
+                    if (!stage.r || !stage.v || !stage.op_unary) return false;
+                } else if (auto reduce = task.template cast<ScheduleTask_v_reduce>()) {
+                    stage.kind      = StageKind::Reduce;
+                    stage.r_scalar  = reduce->r.template cast<TScalar<T>>();
+                    stage.s_scalar  = reduce->s.template cast<TScalar<T>>();
+                    stage.v         = reduce->v.template cast<TVector<T>>();
+                    stage.op_binary = reduce->op_reduce.template cast<TOpBinary<T, T, T>>();
+                    if (!stage.r_scalar || !stage.s_scalar || !stage.v || !stage.op_binary) return false;
+                } else {
+                    return false;
+                }
+
+                stages.push_back(std::move(stage));
+            }
+
+            // vectors not written by the chain must be dense, otherwise chained tasks take sparse paths
+            std::vector<TVector<T>*> written;
+            const uint               N = stages.front().r->get_n_rows();
+
+            for (auto& stage : stages) {
+                for (TVector<T>* input : {stage.u.get(), stage.v.get()}) {
+                    if (!input) continue;
+                    if (input->get_n_rows() != N) return false;
+                    if (std::find(written.begin(), written.end(), input) != written.end()) continue;
+                    if (!input->is_valid(FormatVector::CpuDense) || input->is_valid(FormatVector::CpuCoo)) return false;
+                }
+                if (stage.r) {
+                    if (stage.r->get_n_rows() != N) return false;
+                    written.push_back(stage.r.get());
+                }
+            }
+
+            return true;
+        }
+
+        Status execute_tasks(const DispatchContext& ctx) {
+            auto        t            = ctx.task.template cast_safe<ScheduleTask_v_fused>();
+            Dispatcher* g_dispatcher = Library::get()->get_dispatcher();
+
+            DispatchContext sub_ctx = ctx;
+
+            for (std::size_t i = 0; i < t->tasks.size(); i++) {
+                sub_ctx.task    = t->tasks[i];
+                sub_ctx.step_id = ctx.step_id + int(i);
+
+                Status status  = g_dispatcher->dispatch(sub_ctx);
+                t->statuses[i] = status;
+                if (status != Status::Ok) {
+                    return status;
+                }
+            }
+
+            return Status::Ok;
+        }
+
+        Status execute_dn(const DispatchContext& ctx, std::vector<Stage>& stages) {
+            TIME_PROFILE_SCOPE("cpu/vector_fused_dense");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_fused>();
+
+            std::vector<const T*> p_u(stages.size(), nullptr);
+            std::vector<const T*> p_v(stages.size(), nullptr);
+            std::vector<T*>       p_r(stages.size(), nullptr);
+            std::vector<T>        sums(stages.size());
+
+            // inputs are validated first, since dense output validation keeps the values
+            for (auto& stage : stages) {
+                if (stage.u) stage.u->validate_rw(FormatVector::CpuDense);
+                if (stage.v) stage.v->validate_rw(FormatVector::CpuDense);
+            }
+            for (auto& stage : stages) {
+                if (stage.r) stage.r->validate_wd(FormatVector::CpuDense);
+            }
+            for (std::size_t k = 0; k < stages.size(); k++) {
+                auto& stage = stages[k];
+                if (stage.u) p_u[k] = stage.u->template get<CpuDenseVec<T>>()->Ax.data();
+                if (stage.v) p_v[k] = stage.v->template get<CpuDenseVec<T>>()->Ax.data();
+                if (stage.r) p_r[k] = stage.r->template get<CpuDenseVec<T>>()->Ax.data();
+                if (stage.s_scalar) sums[k] = stage.s_scalar->get_value();
+            }
+
+            const uint N = stages.front().r->get_n_rows();
+
+            // each block passes all stages while still in cache; element order matches unfused execution
+            for (uint block = 0; block < N; block += BLOCK_SIZE) {
+                const uint block_end = std::min(N, block + BLOCK_SIZE);
+
+                for (std::size_t k = 0; k < stages.size(); k++) {
+                    auto& stage = stages[k];
+
+                    switch (stage.kind) {
+                        case StageKind::Eadd: {
+                            const auto& function = stage.op_binary->function;
+                            for (uint i = block; i < block_end; i++) {
+                                p_r[k][i] = function(p_u[k][i], p_v[k][i]);
+                            }
+                        } break;
+                        case StageKind::Map: {
+                            const auto& function = stage.op_unary->function;
+                            for (uint i = block; i < block_end; i++) {
+                                p_r[k][i] = function(p_v[k][i]);
+                            }
+                        } break;
+                        case StageKind::Reduce: {
+                            const auto& function = stage.op_binary->function;
+                            T           sum      = sums[k];
+                            for (uint i = block; i < block_end; i++) {
+                                sum = function(sum, p_v[k][i]);
+                            }
+                            sums[k] = sum;
+                        } break;
+                    }
+                }
+            }
+
+            for (std::size_t k = 0; k < stages.size(); k++) {
+                if (stages[k].r_scalar) stages[k].r_scalar->get_value() = sums[k];
+            }
+
+            std::fill(t->statuses.begin(), t->statuses.end(), Status::Ok);
+
+            return Status::Ok;
+        }
+
+        /** Count of elements processed by all stages at once */
+        static constexpr uint BLOCK_SIZE = 4096;
+    };
+
+}// namespace spla
+
+#endif//SPLA_CPU_V_FUSED_HPP
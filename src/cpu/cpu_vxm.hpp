@@ -38,7 +38,15 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
-#include <robin_hood.hpp>
+#include <cpu/cpu_bitmap.hpp>
+#include <cpu/cpu_parallel.hpp>
+#include <cpu/cpu_sort.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
 
 namespace spla {
 
@@ -52,11 +60,55 @@ namespace spla {
         }
 
         std::string get_description() override {
-            return "sequential masked vector-matrix product on cpu";
+            return "frontier size adaptive masked vector-matrix product on cpu";
         }
 
         Status execute(const DispatchContext& ctx) override {
-            TIME_PROFILE_SCOPE("cpu/vxm");
+            auto t = ctx.task.template cast_safe<ScheduleTask_vxm_masked>();
+
+            auto r = t->r.template cast_safe<TVector<T>>();
+            auto v = t->v.template cast_safe<TVector<T>>();
+            auto M = t->M.template cast_safe<TMatrix<T>>();
+
+            r->validate_wd(FormatVector::CpuCoo);
+            v->validate_rw(FormatVector::CpuCoo);
+            M->validate_rw(FormatMatrix::CpuCsr);
+
+            const CpuCooVec<T>* p_sparse_v = v->template get<CpuCooVec<T>>();
+            const CpuCsr<T>*    p_csr_M    = M->template get<CpuCsr<T>>();
+
+            // upper bound of products, used to select accumulator
+            std::uint64_t flops = 0;
+            for (const uint v_i : p_sparse_v->Ai) {
+                flops += p_csr_M->Ap[v_i + 1] - p_csr_M->Ap[v_i];
+            }
+
+            if (flops * SPARSE_RATIO < M->get_n_cols()) {
+                return execute_sparse(ctx);
+            }
+
+            return execute_bitmap(ctx, flops);
+        }
+
+    private:
+        /**
+         * @class Scratch
+         * @brief Buffers kept with prepared task between executions
+         */
+        struct Scratch final : public ScheduleTaskScratch {
+            std::vector<std::pair<uint, T>> entries;
+            std::vector<std::pair<uint, T>> tmp;
+            CpuBitmap                       touched;
+            std::vector<T>                  values;
+        };
+
+        /**
+         * @brief Small frontier: collects products in a list and merges them by radix sort
+         *
+         * Work does not depend on the number of columns of the matrix.
+         */
+        Status execute_sparse(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vxm_sparse");
 
             auto t = ctx.task.template cast_safe<ScheduleTask_vxm_masked>();
 
@@ -67,65 +119,178 @@ namespace spla {
             auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
             auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
             auto op_select   = t->op_select.template cast_safe<TOpSelect<T>>();
-            auto init        = t->init.template cast_safe<TScalar<T>>();
 
-            const T sum_init = init->get_value();
-
-            r->validate_wd(FormatVector::CpuCoo);
             mask->validate_rw(FormatVector::CpuDense);
-            v->validate_rw(FormatVector::CpuCoo);
-            M->validate_rw(FormatMatrix::CpuLil);
 
             CpuCooVec<T>*         p_sparse_r   = r->template get<CpuCooVec<T>>();
             const CpuDenseVec<T>* p_dense_mask = mask->template get<CpuDenseVec<T>>();
             const CpuCooVec<T>*   p_sparse_v   = v->template get<CpuCooVec<T>>();
-            const CpuLil<T>*      p_lil_M      = M->template get<CpuLil<T>>();
+            const CpuCsr<T>*      p_csr_M      = M->template get<CpuCsr<T>>();
 
             auto& func_multiply = op_multiply->function;
             auto& func_add      = op_add->function;
             auto& func_select   = op_select->function;
 
+            const auto& Ap = p_csr_M->Ap;
+            const auto& Aj = p_csr_M->Aj;
+            const auto& Ax = p_csr_M->Ax;
+
             const uint N = p_sparse_v->values;
 
-            robin_hood::unordered_flat_map<uint, T> r_tmp;
+            Scratch& scratch = t->template get_scratch<Scratch>();
+            auto&    entries = scratch.entries;
+            entries.clear();
 
             for (uint idx = 0; idx < N; ++idx) {
                 const uint v_i = p_sparse_v->Ai[idx];
                 const T    v_x = p_sparse_v->Ax[idx];
 
-                const auto& row = p_lil_M->Ar[v_i];
-
-                for (const auto& j_x : row) {
-                    const uint j = j_x.first;
+                for (uint k = Ap[v_i]; k < Ap[v_i + 1]; ++k) {
+                    const uint j = Aj[k];
 
                     if (func_select(p_dense_mask->Ax[j])) {
-                        auto r_x = r_tmp.find(j);
-
-                        if (r_x != r_tmp.end())
-                            r_x->second = func_add(r_x->second, func_multiply(v_x, j_x.second));
-                        else
-                            r_tmp[j] = func_multiply(v_x, j_x.second);
+                        entries.emplace_back(j, func_multiply(v_x, Ax[k]));
                     }
                 }
             }
 
-            std::vector<std::pair<uint, T>> r_entries;
-            r_entries.reserve(r_tmp.size());
-            for (const auto& e : r_tmp) {
-                r_entries.emplace_back(e.first, e.second);
-            }
-            std::sort(r_entries.begin(), r_entries.end());
-
-            p_sparse_r->values = uint(r_tmp.size());
-            p_sparse_r->Ai.reserve(r_tmp.size());
-            p_sparse_r->Ax.reserve(r_tmp.size());
-            for (const auto& e : r_entries) {
-                p_sparse_r->Ai.push_back(e.first);
-                p_sparse_r->Ax.push_back(e.second);
+            const uint n_threads = entries.size() >= PARALLEL_MIN_FLOPS ? cpu_threads_count(t->get_desc_or_default()) : 1u;
+
+            auto key_of = [](const std::pair<uint, T>& entry) { return entry.first; };
+
+            // stable sort keeps order of products of the same column as in frontier
+            cpu_radix_sort(entries, scratch.tmp, cpu_bits_count(M->get_n_cols() - 1), n_threads, key_of);
+            cpu_reduce_sorted(entries, scratch.tmp, n_threads, key_of, [&](std::pair<uint, T>& accum, const std::pair<uint, T>& entry) {
+                accum.second = func_add(accum.second, entry.second);
+            });
+
+            const auto& reduced = scratch.tmp;
+
+            p_sparse_r->Ai.resize(reduced.size());
+            p_sparse_r->Ax.resize(reduced.size());
+
+            for (std::size_t k = 0; k < reduced.size(); ++k) {
+                p_sparse_r->Ai[k] = reduced[k].first;
+                p_sparse_r->Ax[k] = reduced[k].second;
             }
 
+            p_sparse_r->values = uint(p_sparse_r->Ai.size());
+
             return Status::Ok;
         }
+
+        /**
+         * @brief Large frontier: scatters products into dense values marked by bitmap
+         *
+         * Result is produced in sorted order by bitmap scan. On multiple threads
+         * each thread owns a range of columns and finds its part of each row by
+         * binary search, so no atomics are required and every column accumulates
+         * products in frontier order.
+         */
+        Status execute_bitmap(const DispatchContext& ctx, std::uint64_t flops) {
+            TIME_PROFILE_SCOPE("cpu/vxm_bitmap");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_vxm_masked>();
+
+            auto r           = t->r.template cast_safe<TVector<T>>();
+            auto mask        = t->mask.template cast_safe<TVector<T>>();
+            auto v           = t->v.template cast_safe<TVector<T>>();
+            auto M           = t->M.template cast_safe<TMatrix<T>>();
+            auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_select   = t->op_select.template cast_safe<TOpSelect<T>>();
+
+            mask->validate_rw(FormatVector::CpuDense);
+
+            CpuCooVec<T>*         p_sparse_r   = r->template get<CpuCooVec<T>>();
+            const CpuDenseVec<T>* p_dense_mask = mask->template get<CpuDenseVec<T>>();
+            const CpuCooVec<T>*   p_sparse_v   = v->template get<CpuCooVec<T>>();
+            const CpuCsr<T>*      p_csr_M      = M->template get<CpuCsr<T>>();
+
+            auto& func_multiply = op_multiply->function;
+            auto& func_add      = op_add->function;
+            auto& func_select   = op_select->function;
+
+            const uint* Ap = p_csr_M->Ap.data();
+            const uint* Aj = p_csr_M->Aj.data();
+            const T*    Ax = p_csr_M->Ax.data();
+
+            const uint N       = p_sparse_v->values;
+            const uint DN      = M->get_n_cols();
+            const uint n_words = CpuBitmap::words_count(DN);
+
+            const uint n_threads = flops >= PARALLEL_MIN_FLOPS ? cpu_threads_count(t->get_desc_or_default()) : 1u;
+            const uint n_ranges  = std::max(1u, std::min(n_words, n_threads > 1 ? n_threads * CHUNKS_PER_THREAD : 1u));
+
+            Scratch&          scratch = t->template get_scratch<Scratch>();
+            CpuBitmap&        touched = scratch.touched;
+            std::vector<uint> offsets(n_ranges + 1, 0);
+
+            // buffers of previous executions are reused, values are read only where touched
+            touched.resize(DN);
+            if (scratch.values.size() < DN) scratch.values.resize(DN);
+            T* values = scratch.values.data();
+
+            auto range_words = [&](uint range) { return uint(std::uint64_t(n_words) * range / n_ranges); };
+
+            cpu_parallel_for(n_threads, n_ranges, [&](uint range, uint) {
+                const uint word_begin = range_words(range);
+                const uint word_end   = range_words(range + 1);
+                const uint col_begin  = word_begin * CpuBitmap::BITS;
+                const uint col_end    = std::min(DN, word_end * CpuBitmap::BITS);
+
+                for (uint idx = 0; idx < N; ++idx) {
+                    const uint v_i = p_sparse_v->Ai[idx];
+                    const T    v_x = p_sparse_v->Ax[idx];
+
+                    uint       k   = Ap[v_i];
+                    const uint end = Ap[v_i + 1];
+
+                    if (n_ranges > 1) {
+                        k = uint(std::lower_bound(Aj + k, Aj + end, col_begin) - Aj);
+                    }
+
+                    for (; k < end && Aj[k] < col_end; ++k) {
+                        const uint j = Aj[k];
+
+                        if (func_select(p_dense_mask->Ax[j])) {
+                            if (touched.test_and_set(j)) {
+                                values[j] = func_multiply(v_x, Ax[k]);
+                            } else {
+                                values[j] = func_add(values[j], func_multiply(v_x, Ax[k]));
+                            }
+                        }
+                    }
+                }
+
+                offsets[range] = touched.count(word_begin, word_end);
+            });
+
+            std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), 0u);
+
+            p_sparse_r->values = offsets[n_ranges];
+            p_sparse_r->Ai.resize(offsets[n_ranges]);
+            p_sparse_r->Ax.resize(offsets[n_ranges]);
+
+            cpu_parallel_for(n_threads, n_ranges, [&](uint range, uint) {
+                uint k = offsets[range];
+
+                touched.for_each(range_words(range), range_words(range + 1), [&](uint j) {
+                    p_sparse_r->Ai[k] = j;
+                    p_sparse_r->Ax[k] = values[j];
+                    k += 1;
+                });
+            });
+
+            return Status::Ok;
+        }
+
+        /** Use sparse path if products count times this ratio is less than columns count */
+        static constexpr std::uint64_t SPARSE_RATIO = 64;
+        /** Min number of products to run product on multiple threads */
+        static constexpr std::uint64_t PARALLEL_MIN_FLOPS = 1u << 16u;
+        /** Number of column ranges per thread for dynamic balancing */
+        static constexpr uint CHUNKS_PER_THREAD = 4;
     };
 
 }// namespace spla
@@ -44,6 +44,10 @@ namespace spla {
         return g_dispatcher->dispatch(ctx);
     }
 
+    Status exec_task(const ref_ptr<ScheduleTask>& task) {
+        return execute_immediate(task);
+    }
+
 #define EXEC_OR_MAKE_TASK                                  \
     if (task_hnd) {                                        \
         *task_hnd = task.as<ScheduleTask>();               \
@@ -107,6 +111,30 @@ namespace spla {
         EXEC_OR_MAKE_TASK
     }
 
+    Status exec_mxmT_masked_reduce(
+            ref_ptr<Scalar>        r,
+            ref_ptr<Scalar>        s,
+            ref_ptr<Matrix>        mask,
+            ref_ptr<Matrix>        A,
+            ref_ptr<Matrix>        B,
+            ref_ptr<OpBinary>      op_multiply,
+            ref_ptr<OpBinary>      op_add,
+            ref_ptr<OpSelect>      op_select,
+            ref_ptr<Descriptor>    desc,
+            ref_ptr<ScheduleTask>* task_hnd) {
+        auto task         = make_ref<ScheduleTask_mxmT_masked_reduce>();
+        task->r           = std::move(r);
+        task->s           = std::move(s);
+        task->mask        = std::move(mask);
+        task->A           = std::move(A);
+        task->B           = std::move(B);
+        task->op_multiply = std::move(op_multiply);
+        task->op_add      = std::move(op_add);
+        task->op_select   = std::move(op_select);
+        task->desc        = std::move(desc);
+        EXEC_OR_MAKE_TASK
+    }
+
     Status exec_kron(
             ref_ptr<Matrix>        R,
             ref_ptr<Matrix>        A,
@@ -30,10 +30,14 @@
 #include <spla/timer.hpp>
 
 #include <core/logger.hpp>
+#include <cpu/cpu_parallel.hpp>
+#include <cpu/cpu_sort.hpp>
+#include <util/mapped_file.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
@@ -44,6 +48,96 @@
 
 namespace spla {
 
+    /** Minimum size of text in bytes to be parsed as a separate chunk */
+    static constexpr std::size_t IO_CHUNK_MIN_BYTES = 1 << 20;
+    /** Number of text chunks per thread to balance parsing of lines with different length */
+    static constexpr uint IO_CHUNKS_PER_THREAD = 4;
+    /** Max value of index or dimension, which fits into uint */
+    static constexpr std::uint64_t IO_MAX_INDEX = 0xffffffffu;
+
+    static const char* io_skip_spaces(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        return p;
+    }
+
+    static const char* io_parse_uint(const char* p, const char* end, std::uint64_t& value) {
+        p                 = io_skip_spaces(p, end);
+        const char* first = p;
+        std::uint64_t v   = 0;
+        while (p < end && static_cast<unsigned char>(*p - '0') < 10) {
+            // value stops growing once out of index range, so long digit runs can not wrap around
+            if (v <= IO_MAX_INDEX) v = v * 10 + std::uint64_t(*p - '0');
+            p++;
+        }
+        value = v;
+        return p != first ? p : nullptr;
+    }
+
+    static const char* io_line_end(const char* p, const char* end) {
+        const void* found = std::memchr(p, '\n', std::size_t(end - p));
+        return found ? static_cast<const char*>(found) : end;
+    }
+
+    /**
+     * @brief Parsed entries of a single newline-aligned chunk of text
+     */
+    struct IoChunk {
+        const char*                begin = nullptr;
+        const char*                end   = nullptr;
+        std::vector<std::uint64_t> keys;
+        std::size_t                n_lines = 0;
+        std::size_t                n_bad   = 0;
+        std::uint64_t              max_i   = 0;
+        std::uint64_t              max_j   = 0;
+    };
+
+    static void io_parse_chunk(IoChunk& chunk, std::uint64_t n_rows, std::uint64_t n_cols, bool offset_indices, bool make_undirected, bool remove_loops) {
+        const char* p   = chunk.begin;
+        const char* end = chunk.end;
+
+        chunk.keys.reserve(std::size_t(end - p) / 8);
+
+        while (p < end) {
+            const char* line_end = io_line_end(p, end);
+            const char* line     = io_skip_spaces(p, line_end);
+            p                    = line_end + 1;
+
+            if (line == line_end || *line == '%' || *line == '\r') continue;
+
+            chunk.n_lines++;
+
+            std::uint64_t i    = 0;
+            std::uint64_t j    = 0;
+            const char*   next = io_parse_uint(line, line_end, i);
+            next               = next ? io_parse_uint(next, line_end, j) : nullptr;
+
+            // indices are one-based and must fit the size from header, also for doubled edges
+            const bool out_of_range = i == 0 || j == 0 || i > n_rows || j > n_cols ||
+                                      (make_undirected && (j > n_rows || i > n_cols));
+
+            if (!next || out_of_range) {
+                chunk.n_bad++;
+                continue;
+            }
+            if (remove_loops) {
+                if (i == j) continue;
+            }
+            if (offset_indices) {
+                i -= 1;
+                j -= 1;
+            }
+
+            chunk.max_i = std::max(chunk.max_i, make_undirected ? std::max(i, j) : i);
+            chunk.max_j = std::max(chunk.max_j, make_undirected ? std::max(i, j) : j);
+
+            if (make_undirected) {
+                chunk.keys.push_back((j << 32u) | i);
+            }
+
+            chunk.keys.push_back((i << 32u) | j);
+        }
+    }
+
     MtxLoader::MtxLoader(std::string name) : m_name(std::move(name)) {
     }
 
@@ -51,8 +145,8 @@ namespace spla {
         m_file_path    = std::move(file_path);
         m_base_is_zero = offset_indices;
 
-        std::fstream file(m_file_path, std::ios::in);
-        if (!file.is_open()) {
+        MappedFile file;
+        if (!file.open(m_file_path)) {
             LOG_MSG(Status::Error, "failed to open file " << m_file_path);
             return false;
         }
@@ -60,18 +154,36 @@ namespace spla {
         Timer t;
         t.start();
 
+        const uint  n_threads = cpu_threads_count(ref_ptr<Descriptor>());
+        const char* text      = file.data();
+        const char* text_end  = text + file.size();
+
         std::size_t n_lines = 0;
         std::size_t n_sort  = 0;
 
-        std::string line;
-        while (std::getline(file, line)) {
-            if (line[0] != '%') break;
+        // skip comments and read header
+        const char* p = text;
+        while (p < text_end) {
+            const char* line_end = io_line_end(p, text_end);
+            const char* line     = io_skip_spaces(p, line_end);
+            if (line != line_end && *line != '%' && *line != '\r') break;
+            p = line_end + 1;
             n_lines++;
         }
 
-        std::size_t       nnz;
-        std::stringstream header(line);
-        header >> m_n_rows >> m_n_cols >> nnz;
+        std::uint64_t header[3] = {0, 0, 0};
+        const char*   header_end = p < text_end ? io_line_end(p, text_end) : text_end;
+        for (auto& value : header) {
+            p = p ? io_parse_uint(p, header_end, value) : nullptr;
+        }
+        if (!p || header[0] > IO_MAX_INDEX || header[1] > IO_MAX_INDEX) {
+            LOG_MSG(Status::Error, "failed to parse header of file " << m_file_path);
+            return false;
+        }
+
+        const std::size_t nnz = header[2];
+        m_n_rows              = uint(header[0]);
+        m_n_cols              = uint(header[1]);
 
         std::cout << "Loading matrix-market coordinate format data... " << std::endl;
         std::cout << " Reading from " << m_file_path << std::endl;
@@ -80,137 +192,90 @@ namespace spla {
         if (remove_loops) std::cout << " Opt: remove self-loops" << std::endl;
         if (offset_indices) std::cout << " Opt: offset indices by -1" << std::endl;
         if (make_undirected) std::cout << " Opt: double edges" << std::endl;
-        std::cout << " Reading data: ";
-
-        // optimized reading by sliding window
-        const std::size_t BUFFER_CAPACITY = 1024 * 8;
-        std::size_t       buffer_size     = 0;
-        std::size_t       buffer_offset   = 0;
-        char              buffer[BUFFER_CAPACITY + 1];
-
-        // read data
-        std::size_t       to_count       = 0;
-        std::size_t       to_read        = nnz;
-        std::size_t       to_preallocate = to_read * (make_undirected ? 2 : 1);
-        std::vector<uint> Ai;
-        std::vector<uint> Aj;
-
-        // preallocate to avoid copy
-        Ai.reserve(to_preallocate);
-        Aj.reserve(to_preallocate);
-
-        float job_done  = 0.0f;
-        float job_total = 35.0f;
-
-        while (to_read > 0) {
-            to_count++;
-            to_read--;
-            n_lines++;
-
-            // display current progress of reading the file
-            while (float(to_count) / float(nnz) > job_done / job_total) {
-                job_done += 1.0f;
-                std::cout << "|";
+        std::cout << " Reading data: " << n_threads << " threads";
+
+        // split data into chunks, aligned to the beginning of lines
+        const char*       data_begin = std::min(header_end + 1, text_end);
+        const std::size_t data_size  = std::size_t(text_end - data_begin);
+        const uint        n_chunks   = uint(std::max<std::size_t>(1, std::min<std::size_t>(std::size_t(n_threads) * IO_CHUNKS_PER_THREAD, data_size / IO_CHUNK_MIN_BYTES)));
+
+        std::vector<IoChunk> chunks(n_chunks);
+        for (uint k = 0; k < n_chunks; k++) {
+            const char* begin = k == 0 ? data_begin : chunks[k - 1].end;
+            const char* end   = data_begin + data_size * (k + 1) / n_chunks;
+            end               = k + 1 == n_chunks ? text_end : std::max(begin, end);
+            if (end < text_end && end > data_begin && end[-1] != '\n') {
+                end = std::min(text_end, io_line_end(end, text_end) + 1);
             }
+            chunks[k].begin = begin;
+            chunks[k].end   = end;
+        }
 
-            // try to find where next line is ends up
-            bool        line_found = false;
-            std::size_t line_end;
-            while (!line_found) {
-                line_end = buffer_offset;
-
-                // travers buffer to find ending
-                while (line_end < buffer_size && buffer[line_end] != '\n') {
-                    line_end += 1;
-                }
-
-                // buffer not ended of file is ended
-                line_found = line_end < buffer_size || file.eof();
-
-                // not found in buffer, need to fetch more data
-                if (!line_found) {
-                    assert(!file.eof());
-                    assert(buffer_offset <= BUFFER_CAPACITY);
-
-                    if (buffer_offset > 0) {
-                        if (buffer_offset < BUFFER_CAPACITY) {
-                            std::memcpy(buffer, buffer + buffer_offset, BUFFER_CAPACITY - buffer_offset);
-                        }
-                        buffer_offset = BUFFER_CAPACITY - buffer_offset;
-                    }
-
-                    auto bytes_to_read = BUFFER_CAPACITY - buffer_offset;
-                    file.read(buffer + buffer_offset, std::streamsize(bytes_to_read));
-                    auto bytes_actually_read = file.gcount();
-                    buffer_size              = buffer_offset + bytes_actually_read;
-                    buffer_offset            = 0;
-                    buffer[buffer_size]      = '\0';
-                    assert(buffer_size <= BUFFER_CAPACITY + 1);
-                }
-            }
+        cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint) {
+            io_parse_chunk(chunks[chunk_id], m_n_rows, m_n_cols, offset_indices, make_undirected, remove_loops);
+        });
+
+        std::vector<std::size_t> chunks_offsets(n_chunks + 1, 0);
+        std::size_t              n_bad = 0;
+        std::uint64_t            max_i = 0;
+        std::uint64_t            max_j = 0;
+        for (uint k = 0; k < n_chunks; k++) {
+            chunks_offsets[k + 1] = chunks_offsets[k] + chunks[k].keys.size();
+            n_lines += chunks[k].n_lines;
+            n_bad += chunks[k].n_bad;
+            max_i = std::max(max_i, chunks[k].max_i);
+            max_j = std::max(max_j, chunks[k].max_j);
+        }
 
-            char* end     = nullptr;
-            auto  i       = uint(std::strtoll(buffer + buffer_offset, &end, 10));
-            auto  j       = uint(std::strtoll(end, &end, 10));
-            buffer_offset = line_end + 1;
+        if (n_bad > 0) {
+            LOG_MSG(Status::Error, "skipped " << n_bad << " malformed lines in file " << m_file_path);
+        }
 
-            assert(i > 0 && j > 0);
+        std::vector<std::uint64_t> sorted(chunks_offsets.back());
+        cpu_parallel_for(n_threads, n_chunks, [&](uint chunk_id, uint) {
+            std::copy(chunks[chunk_id].keys.begin(), chunks[chunk_id].keys.end(), sorted.begin() + std::ptrdiff_t(chunks_offsets[chunk_id]));
+            std::vector<std::uint64_t>().swap(chunks[chunk_id].keys);
+        });
+        t.lap_end();// parsing
 
-            if (remove_loops) {
-                if (i == j) continue;
-            }
-            if (offset_indices) {
-                i -= 1;
-                j -= 1;
-            }
-            if (make_undirected) {
-                Ai.push_back(j);
-                Aj.push_back(i);
-            }
+        // pack keys densely, so radix sort processes only significant bits
+        const uint j_bits = cpu_bits_count(max_j);
+        const uint i_bits = cpu_bits_count(max_i);
 
-            Ai.push_back(i);
-            Aj.push_back(j);
-        }
-        t.lap_end();// parsing
+        auto key_of = [](std::uint64_t key) { return key; };
 
-        std::vector<std::uint64_t> sorted;
+        std::vector<std::uint64_t> tmp;
         {
-            sorted.reserve(Ai.size());
-            n_sort = Ai.size();
-
-            for (std::size_t k = 0; k < Ai.size(); k++) {
-                std::uint64_t entry = 0;
-                entry |= std::uint64_t(Ai[k]) << 32u;
-                entry |= std::uint64_t(Aj[k]) << 0u;
-                sorted.push_back(entry);
-            }
-            Ai.clear();
-            Aj.clear();
+            n_sort = sorted.size();
 
-            std::sort(sorted.begin(), sorted.end());
+            const uint n_blocks = cpu_sort_blocks_count(n_sort, n_threads);
+            cpu_parallel_for(n_threads, n_blocks, [&](uint block, uint) {
+                for (std::size_t k = n_sort * block / n_blocks; k < n_sort * (block + 1) / n_blocks; k++) {
+                    sorted[k] = ((sorted[k] >> 32u) << j_bits) | (sorted[k] & 0xffffffffu);
+                }
+            });
+
+            cpu_radix_sort(sorted, tmp, i_bits + j_bits, n_threads, key_of);
         }
         t.lap_end();// sorting
 
-        std::vector<uint> reduced_Ai;
-        std::vector<uint> reduced_Aj;
         {
-            reduced_Ai.reserve(sorted.size());
-            reduced_Aj.reserve(sorted.size());
-
-            std::uint64_t entry_prev = 0xffffffffffffffff;
-            for (std::uint64_t entry : sorted) {
-                if (entry_prev != entry) {
-                    uint i = uint((entry >> 32u) & 0xffffffff);
-                    uint j = uint((entry >> 0u) & 0xffffffff);
-                    reduced_Ai.push_back(i);
-                    reduced_Aj.push_back(j);
-                }
-                entry_prev = entry;
-            }
+            cpu_reduce_sorted(sorted, tmp, n_threads, key_of, [](std::uint64_t&, std::uint64_t) {});
+            std::vector<std::uint64_t>().swap(sorted);
 
-            m_n_values = reduced_Ai.size();
-            m_Ai       = std::move(reduced_Ai);
-            m_Aj       = std::move(reduced_Aj);
+            const std::uint64_t j_mask   = (std::uint64_t(1) << j_bits) - 1;
+            const uint          n_blocks = cpu_sort_blocks_count(tmp.size(), n_threads);
+
+            m_n_values = tmp.size();
+            m_Ai.resize(m_n_values);
+            m_Aj.resize(m_n_values);
+
+            cpu_parallel_for(n_threads, n_blocks, [&](uint block, uint) {
+                for (std::size_t k = m_n_values * block / n_blocks; k < m_n_values * (block + 1) / n_blocks; k++) {
+                    m_Ai[k] = uint(tmp[k] >> j_bits);
+                    m_Aj[k] = uint(tmp[k] & j_mask);
+                }
+            });
         }
         t.lap_end();// reducing
 
@@ -34,8 +34,16 @@
 #include <core/top.hpp>
 
 #include <cpu/cpu_algo_registry.hpp>
+#include <cpu/cpu_thread_pool.hpp>
 
+#include <schedule/schedule_future.hpp>
+
+#include <storage/storage_residency.hpp>
+
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <thread>
 
 #if defined(SPLA_BUILD_OPENCL)
     #include <opencl/cl_accelerator.hpp>
@@ -74,6 +82,16 @@ namespace spla {
         m_registry = std::make_unique<Registry>();
         // Setup dispatcher (always available)
         m_dispatcher = std::make_unique<Dispatcher>();
+        // Setup formats residency tracking (always available)
+        m_storage_residency = std::make_shared<StorageResidency>();
+
+        // Setup cpu thread pool options (pool itself is started on first use)
+        if (const char* threads = std::getenv("SPLA_CPU_THREADS")) {
+            m_cpu_threads = std::max(0, std::atoi(threads));
+        }
+        if (const char* pin = std::getenv("SPLA_CPU_PIN")) {
+            m_cpu_pin = std::atoi(pin) != 0;
+        }
 
         // Register build-in bin ops (id's done here, since registration depend on types)
         register_ops();
@@ -92,15 +110,24 @@ namespace spla {
 #endif
     }
 
-    Library::~Library() = default;
+    Library::~Library() {
+        release_async_executor();
+    }
 
     void Library::finalize() {
         LOG_MSG(Status::Ok, "finalize library state");
 
+        // pending asynchronous submits still need accelerator and cpu pool
+        release_async_executor();
+
         if (m_accelerator) {
             LOG_MSG(Status::Ok, "release accelerator: " << m_accelerator->get_name());
             m_accelerator.reset();
         }
+
+        std::lock_guard<std::mutex> lock(m_cpu_pool_mutex);
+        m_cpu_pool_cached.store(nullptr);
+        m_cpu_pool.reset();
     }
 
     Status Library::set_accelerator(AcceleratorType accelerator) {
@@ -172,6 +199,60 @@ namespace spla {
         return m_force_no_acc;
     }
 
+    Status Library::set_format_policy(FormatPolicy policy) {
+        LOG_MSG(Status::Ok, "set format policy: " << static_cast<uint>(policy));
+        m_storage_residency->set_policy(policy);
+        return Status::Ok;
+    }
+
+    FormatPolicy Library::get_format_policy() {
+        return m_storage_residency->get_policy();
+    }
+
+    Status Library::set_memory_budget(std::size_t bytes) {
+        LOG_MSG(Status::Ok, "set memory budget: " << bytes);
+        m_storage_residency->set_budget(bytes);
+        return Status::Ok;
+    }
+
+    std::size_t Library::get_memory_budget() {
+        return m_storage_residency->get_budget();
+    }
+
+    std::size_t Library::get_memory_usage() {
+        return m_storage_residency->get_usage();
+    }
+
+    Status Library::set_cpu_threads(int count) {
+        if (count < 0) {
+            return Status::InvalidArgument;
+        }
+
+        LOG_MSG(Status::Ok, "set cpu threads: " << count);
+        std::lock_guard<std::mutex> lock(m_cpu_pool_mutex);
+        m_cpu_threads = count;
+        m_cpu_pool_cached.store(nullptr);
+        m_cpu_pool.reset();
+        return Status::Ok;
+    }
+
+    int Library::get_cpu_threads() {
+        return int(get_cpu_pool()->get_threads_count());
+    }
+
+    Status Library::set_cpu_pinning(bool value) {
+        LOG_MSG(Status::Ok, "set cpu pinning: " << value);
+        std::lock_guard<std::mutex> lock(m_cpu_pool_mutex);
+        m_cpu_pin = value;
+        m_cpu_pool_cached.store(nullptr);
+        m_cpu_pool.reset();
+        return Status::Ok;
+    }
+
+    bool Library::is_set_cpu_pinning() {
+        return m_cpu_pin;
+    }
+
     Status Library::get_accelerator_info(std::string& info) {
         if (!m_accelerator) {
             info = "none";
@@ -215,6 +296,47 @@ namespace spla {
         return m_time_profiler.get();
     }
 
+    class StorageResidency* Library::get_storage_residency() {
+        return m_storage_residency.get();
+    }
+
+    class CpuThreadPool* Library::get_cpu_pool() {
+        // pool is replaced only on configuration change, so parallel sections take it without lock
+        if (CpuThreadPool* pool = m_cpu_pool_cached.load(std::memory_order_acquire)) {
+            return pool;
+        }
+
+        std::lock_guard<std::mutex> lock(m_cpu_pool_mutex);
+
+        if (!m_cpu_pool) {
+            const uint threads = m_cpu_threads > 0 ? uint(m_cpu_threads) : std::max(1u, uint(std::thread::hardware_concurrency()));
+            m_cpu_pool         = std::make_unique<CpuThreadPool>(threads, m_cpu_pin.load());
+        }
+
+        m_cpu_pool_cached.store(m_cpu_pool.get(), std::memory_order_release);
+        return m_cpu_pool.get();
+    }
+
+    class ScheduleAsyncExecutor* Library::get_async_executor() {
+        std::lock_guard<std::mutex> lock(m_async_executor_mutex);
+
+        if (!m_async_executor) {
+            m_async_executor = std::make_unique<ScheduleAsyncExecutor>(std::max(1u, uint(std::thread::hardware_concurrency())));
+        }
+
+        return m_async_executor.get();
+    }
+
+    void Library::release_async_executor() {
+        std::unique_ptr<ScheduleAsyncExecutor> executor;
+        {
+            std::lock_guard<std::mutex> lock(m_async_executor_mutex);
+            executor.swap(m_async_executor);
+        }
+        // destroyed without lock: running jobs may submit asynchronously again
+        executor.reset();
+    }
+
     Library* Library::get() {
         static std::unique_ptr<Library> g_library;
 
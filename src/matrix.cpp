@@ -27,6 +27,10 @@
 
 #include <core/logger.hpp>
 #include <core/tmatrix.hpp>
+#include <cpu/cpu_format_snapshot.hpp>
+#include <util/mapped_file.hpp>
+
+#include <cstring>
 
 namespace spla {
 
@@ -56,4 +60,40 @@ namespace spla {
         return ref_ptr<Matrix>();
     }
 
+    ref_ptr<Matrix> Matrix::load_snapshot(const std::string& file_path) {
+        Library::get();
+
+        MappedFile        file;
+        CpuSnapshotHeader header{};
+
+        if (!file.open(file_path)) {
+            LOG_MSG(Status::Error, "failed to open file " << file_path);
+            return ref_ptr<Matrix>{};
+        }
+        if (!cpu_snapshot_read_header(file, CPU_SNAPSHOT_MATRIX, header) || header.n_rows == 0 || header.n_cols == 0) {
+            LOG_MSG(Status::InvalidArgument, "not a compatible snapshot file " << file_path);
+            return ref_ptr<Matrix>{};
+        }
+
+        const std::string type_code(header.type_code, strnlen(header.type_code, sizeof(header.type_code)));
+        ref_ptr<Matrix>    loaded;
+
+        if (type_code == INT->get_code()) {
+            loaded = TMatrix<std::int32_t>::make_from_snapshot(file, header);
+        } else if (type_code == UINT->get_code()) {
+            loaded = TMatrix<std::uint32_t>::make_from_snapshot(file, header);
+        } else if (type_code == FLOAT->get_code()) {
+            loaded = TMatrix<float>::make_from_snapshot(file, header);
+        } else {
+            LOG_MSG(Status::NotImplemented, "not supported type " << type_code);
+            return ref_ptr<Matrix>{};
+        }
+
+        if (!loaded) {
+            LOG_MSG(Status::InvalidArgument, "corrupted data in snapshot file " << file_path);
+        }
+
+        return loaded;
+    }
+
 }// namespace spla
\ No newline at end of file
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <functional>
 #include <numeric>
 #include <string>
@@ -80,6 +81,15 @@ namespace spla {
 
         ~CLCooVec() override = default;
 
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return std::size_t(this->values) * (sizeof(uint) + sizeof(T));
+        }
+        void release() override {
+            Ai           = cl::Buffer();
+            Ax           = cl::Buffer();
+            this->values = 0;
+        }
+
         cl::Buffer Ai;
         cl::Buffer Ax;
     };
@@ -97,6 +107,16 @@ namespace spla {
 
         ~CLCsr() override = default;
 
+        [[nodiscard]] std::size_t get_memory_usage() const override {
+            return std::size_t(this->values) * (sizeof(uint) + sizeof(T));
+        }
+        void release() override {
+            Ap           = cl::Buffer();
+            Aj           = cl::Buffer();
+            Ax           = cl::Buffer();
+            this->values = 0;
+        }
+
         cl::Buffer Ap;
         cl::Buffer Aj;
         cl::Buffer Ax;
@@ -38,8 +38,7 @@ namespace spla {
         parent   = in_parent;
 
         if (parent) {
-            name = parent->name + "/" + std::to_string(parent->child_count) + "-" + name;
-            parent->child_count += 1;
+            name = parent->name + "/" + std::to_string(parent->child_count.fetch_add(1)) + "-" + name;
         }
 
         Library::get()->get_time_profiler()->add_label(this);
@@ -57,10 +56,12 @@ namespace spla {
     }
 
     void TimeProfiler::add_label(TimeProfilerLabel* label) {
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_labels[label->name] = label;
     }
 
     void TimeProfiler::dump(std::ostream& where) {
+        std::lock_guard<std::mutex> lock(m_mutex);
         for (const auto& entry : m_labels) {
             const auto& name  = entry.first;
             const auto& label = entry.second;
@@ -68,8 +69,8 @@ namespace spla {
 
             if (value != 0) {
                 auto all      = static_cast<double>(label->nano.load()) * 1e-6;
-                auto queued   = static_cast<double>(label->queued_nano) * 1e-6;
-                auto executed = static_cast<double>(label->executed_nano) * 1e-6;
+                auto queued   = static_cast<double>(label->queued_nano.load()) * 1e-6;
+                auto executed = static_cast<double>(label->executed_nano.load()) * 1e-6;
 
                 where << "  - " << name << " " << all << " (queue: " << queued << " exec: " << executed << ") ms\n";
             }
@@ -77,11 +78,12 @@ namespace spla {
     }
 
     void TimeProfiler::reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
         for (const auto& entry : m_labels) {
             const auto& label = entry.second;
             label->nano.store(0);
-            label->queued_nano   = 0;
-            label->executed_nano = 0;
+            label->queued_nano.store(0);
+            label->executed_nano.store(0);
         }
     }
 
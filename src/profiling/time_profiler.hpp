@@ -31,6 +31,7 @@
 #include <atomic>
 #include <chrono>
 #include <map>
+#include <mutex>
 #include <ostream>
 #include <string>
 
@@ -47,10 +48,10 @@ namespace spla {
         std::string          name;
         const char*          file;
         const char*          function;
-        int                  child_count = 0;
-        std::atomic_uint64_t nano;
-        std::uint64_t        queued_nano   = 0;
-        std::uint64_t        executed_nano = 0;
+        std::atomic_int      child_count{0};
+        std::atomic_uint64_t nano{0};
+        std::atomic_uint64_t queued_nano{0};
+        std::atomic_uint64_t executed_nano{0};
         TimeProfilerLabel*   parent;
     };
 
@@ -66,6 +67,9 @@ namespace spla {
     /**
      * @class TimeProfiler
      * @brief Scope-based time profiler to measure perf of schedule tasks execution
+     *
+     * Labels are registered on first pass through a scope, which may happen on
+     * several worker threads at once, so registry of labels is guarded by mutex.
      */
     class TimeProfiler final {
     public:
@@ -75,6 +79,7 @@ namespace spla {
 
     private:
         std::map<std::string, TimeProfilerLabel*> m_labels;
+        std::mutex                                m_mutex;
     };
 
     /**
@@ -27,7 +27,9 @@
 
 #include <spla/schedule.hpp>
 
+#include <schedule/schedule_graph.hpp>
 #include <schedule/schedule_st.hpp>
+#include <schedule/schedule_tp.hpp>
 
 namespace spla {
 
@@ -35,4 +37,14 @@ namespace spla {
         return ref_ptr<Schedule>(new ScheduleSingleThread);
     }
 
+    ref_ptr<Schedule> make_schedule(ScheduleType type, uint workers_count) {
+        if (type == ScheduleType::ThreadPool) {
+            return ref_ptr<Schedule>(new ScheduleThreadPool(workers_count));
+        }
+        if (type == ScheduleType::Graph) {
+            return ref_ptr<Schedule>(new ScheduleGraph(workers_count));
+        }
+        return ref_ptr<Schedule>(new ScheduleSingleThread);
+    }
+
 }// namespace spla
\ No newline at end of file
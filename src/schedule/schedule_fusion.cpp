@@ -0,0 +1,101 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "schedule_fusion.hpp"
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <algorithm>
+
+namespace spla {
+
+    static bool fusion_is_element_wise(ScheduleTask* task) {
+        return dynamic_cast<ScheduleTask_v_eadd*>(task) || dynamic_cast<ScheduleTask_v_map*>(task);
+    }
+
+    static bool fusion_is_reduce(ScheduleTask* task) {
+        return dynamic_cast<ScheduleTask_v_reduce*>(task);
+    }
+
+    static bool fusion_is_compatible(ScheduleTask* task, const ref_ptr<Type>& type, uint n_rows) {
+        for (auto& arg : task->get_args()) {
+            auto* vec = dynamic_cast<Vector*>(arg.get());
+            if (vec && (vec->get_type() != type || vec->get_n_rows() != n_rows)) return false;
+        }
+        return true;
+    }
+
+    static bool fusion_reads_any(ScheduleTask* task, const std::vector<Object*>& written) {
+        std::vector<ref_ptr<Object>> args      = task->get_args();
+        const int                    n_outputs = task->get_n_outputs();
+
+        for (int i = n_outputs; i < int(args.size()); i++) {
+            if (std::find(written.begin(), written.end(), args[i].get()) != written.end()) return true;
+        }
+        return false;
+    }
+
+    void schedule_find_fusions(const std::vector<ScheduleTask*>& steps, std::vector<ScheduleFusion>& fusions) {
+        fusions.clear();
+
+        const int n_steps = int(steps.size());
+        int       step_id = 0;
+
+        while (step_id < n_steps) {
+            ScheduleTask* head = steps[step_id];
+
+            if (!head || !fusion_is_element_wise(head)) {
+                step_id += 1;
+                continue;
+            }
+
+            auto                 r      = head->get_args().front().cast_safe<Vector>();
+            ref_ptr<Type>        type   = r->get_type();
+            const uint           n_rows = r->get_n_rows();
+            std::vector<Object*> written{r.get()};
+
+            int end = step_id + 1;
+            while (end < n_steps) {
+                ScheduleTask* task = steps[end];
+
+                if (!task || !(fusion_is_element_wise(task) || fusion_is_reduce(task))) break;
+                if (!fusion_is_compatible(task, type, n_rows) || !fusion_reads_any(task, written)) break;
+
+                end += 1;
+                if (fusion_is_reduce(task)) break;
+                written.push_back(task->get_args().front().get());
+            }
+
+            if (end - step_id >= 2 && fusion_is_compatible(head, type, n_rows)) {
+                fusions.push_back(ScheduleFusion{step_id, end - step_id});
+            }
+
+            step_id = end;
+        }
+    }
+
+}// namespace spla
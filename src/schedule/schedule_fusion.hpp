@@ -0,0 +1,69 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_SCHEDULE_FUSION_HPP
+#define SPLA_SCHEDULE_FUSION_HPP
+
+#include <spla/schedule.hpp>
+
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class ScheduleFusion
+     * @brief Range of consecutive schedule steps which can be executed as one fused task
+     */
+    struct ScheduleFusion {
+        int first_step = 0;
+        int n_steps    = 0;
+    };
+
+    /**
+     * @brief Finds chains of element-wise vector tasks to fuse
+     *
+     * Chain is a sequence of consecutive single-task steps of `v_eadd` and `v_map`,
+     * optionally terminated by `v_reduce`, where each task reads a vector written
+     * by a previous task of the chain. All vectors of a chain have the same type and size.
+     *
+     * @param steps Task of each step; null for steps with more than one task
+     * @param fusions Found chains of at least two tasks
+     */
+    void schedule_find_fusions(const std::vector<ScheduleTask*>& steps, std::vector<ScheduleFusion>& fusions);
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_SCHEDULE_FUSION_HPP
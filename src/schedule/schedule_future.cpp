@@ -0,0 +1,173 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "schedule_future.hpp"
+
+#include <spla/library.hpp>
+
+#include <chrono>
+#include <thread>
+#include <utility>
+
+namespace spla {
+
+    Status ScheduleFutureImpl::wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&]() { return m_done; });
+        return m_status;
+    }
+
+    bool ScheduleFutureImpl::wait_for(uint timeout_ms) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&]() { return m_done; });
+    }
+
+    bool ScheduleFutureImpl::is_done() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_done;
+    }
+
+    Status ScheduleFutureImpl::get_status() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_done ? m_status : Status::InvalidState;
+    }
+
+    Status ScheduleFutureImpl::on_complete(ScheduleCompleteCallback callback) {
+        if (!callback) {
+            return Status::InvalidArgument;
+        }
+
+        Status status;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_completing) {
+                m_callbacks.push_back(std::move(callback));
+                return Status::Ok;
+            }
+            status = m_status;
+        }
+
+        callback(status);
+        return Status::Ok;
+    }
+
+    void ScheduleFutureImpl::set_label(std::string label) {
+        m_label = std::move(label);
+    }
+
+    const std::string& ScheduleFutureImpl::get_label() const {
+        return m_label;
+    }
+
+    void ScheduleFutureImpl::complete(Status status) {
+        std::vector<ScheduleCompleteCallback> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_status     = status;
+            m_completing = true;
+            callbacks.swap(m_callbacks);
+        }
+
+        // callbacks are called without lock, but before waiters are released
+        for (auto& callback : callbacks) {
+            callback(status);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done = true;
+        }
+        m_cv.notify_all();
+    }
+
+    ScheduleAsyncExecutor::ScheduleAsyncExecutor(uint max_threads) : m_max_threads(std::max(1u, max_threads)) {
+    }
+
+    ScheduleAsyncExecutor::~ScheduleAsyncExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void ScheduleAsyncExecutor::execute(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.push_back(std::move(job));
+
+            if (m_idle < m_jobs.size() && m_threads.size() < m_max_threads) {
+                m_threads.emplace_back([this]() { worker_main(); });
+                return;
+            }
+        }
+        m_cv.notify_one();
+    }
+
+    void ScheduleAsyncExecutor::worker_main() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true) {
+            m_idle += 1;
+            m_cv.wait(lock, [&]() { return m_stop || !m_jobs.empty(); });
+            m_idle -= 1;
+
+            // queued jobs are executed before stop, so every returned future is completed
+            if (m_jobs.empty()) {
+                return;
+            }
+
+            std::function<void()> job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+    ref_ptr<ScheduleFuture> schedule_submit_async(ref_ptr<Schedule> schedule, ref_ptr<ScheduleFutureImpl>& last) {
+        ref_ptr<ScheduleFutureImpl> future(new ScheduleFutureImpl);
+        ref_ptr<ScheduleFutureImpl> previous = last;
+        last                                 = future;
+
+        // job holds references to schedule and future, so both live until execution is completed
+        Library::get()->get_async_executor()->execute([schedule, future, previous]() {
+            if (previous.is_not_null()) {
+                previous->wait();
+            }
+            future->complete(schedule->submit());
+        });
+
+        return future.as<ScheduleFuture>();
+    }
+
+}// namespace spla
@@ -0,0 +1,123 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_SCHEDULE_FUTURE_HPP
+#define SPLA_SCHEDULE_FUTURE_HPP
+
+#include <spla/schedule.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class ScheduleFutureImpl
+     * @brief Future completed by a thread executing asynchronously submitted schedule
+     */
+    class ScheduleFutureImpl final : public ScheduleFuture {
+    public:
+        ~ScheduleFutureImpl() override = default;
+        Status             wait() override;
+        bool               wait_for(uint timeout_ms) override;
+        bool               is_done() override;
+        Status             get_status() override;
+        Status             on_complete(ScheduleCompleteCallback callback) override;
+        void               set_label(std::string label) override;
+        const std::string& get_label() const override;
+
+        void complete(Status status);
+
+    private:
+        std::mutex                            m_mutex;
+        std::condition_variable               m_cv;
+        std::vector<ScheduleCompleteCallback> m_callbacks;
+        std::string                           m_label;
+        Status                                m_status     = Status::NoValue;
+        bool                                  m_completing = false;
+        bool                                  m_done       = false;
+    };
+
+    /**
+     * @class ScheduleAsyncExecutor
+     * @brief Library owned threads executing asynchronously submitted schedules
+     *
+     * Threads are started on demand, when all started threads are busy, up to
+     * a fixed limit; further jobs wait in a queue. Destructor executes all queued
+     * jobs and joins threads, so no submit outlives the library.
+     */
+    class ScheduleAsyncExecutor final {
+    public:
+        explicit ScheduleAsyncExecutor(uint max_threads);
+        ~ScheduleAsyncExecutor();
+
+        void execute(std::function<void()> job);
+
+    private:
+        void worker_main();
+
+    private:
+        std::mutex                        m_mutex;
+        std::condition_variable           m_cv;
+        std::deque<std::function<void()>> m_jobs;
+        std::vector<std::thread>          m_threads;
+        uint                              m_max_threads;
+        uint                              m_idle = 0;
+        bool                              m_stop = false;
+    };
+
+    /**
+     * @brief Submits schedule on library async executor
+     *
+     * Execution starts after previous asynchronous submit of the same schedule is completed,
+     * since schedules are not safe to be submitted concurrently. Jobs are taken in
+     * order of submission, so the previous submit is always running or already done.
+     *
+     * @param schedule Schedule to submit
+     * @param last Last future of schedule; updated to returned future
+     *
+     * @return Future of schedule execution
+     */
+    ref_ptr<ScheduleFuture> schedule_submit_async(ref_ptr<Schedule> schedule, ref_ptr<ScheduleFutureImpl>& last);
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_SCHEDULE_FUTURE_HPP
@@ -0,0 +1,312 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "schedule_graph.hpp"
+
+#include <core/dispatcher.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace spla {
+
+    ScheduleGraph::ScheduleGraph(uint workers_count) {
+        m_workers_count = workers_count > 0 ? workers_count : std::max(1u, uint(std::thread::hardware_concurrency()));
+
+        m_queues.reserve(m_workers_count);
+        for (uint thread_id = 0; thread_id < m_workers_count; thread_id++) {
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+        }
+    }
+
+    ScheduleGraph::~ScheduleGraph() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv_work.notify_all();
+
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    Status ScheduleGraph::step_task(ref_ptr<ScheduleTask> task) {
+        m_steps.emplace_back().push_back(std::move(task));
+        return Status::Ok;
+    }
+
+    Status ScheduleGraph::step_tasks(std::vector<ref_ptr<ScheduleTask>> tasks) {
+        auto& step = m_steps.emplace_back();
+        step.reserve(tasks.size());
+        for (auto& task : tasks) step.push_back(std::move(task));
+        return Status::Ok;
+    }
+
+    Status ScheduleGraph::submit() {
+        build_graph();
+
+        const int n_nodes = static_cast<int>(m_nodes.size());
+        if (n_nodes == 0) {
+            return Status::Ok;
+        }
+
+        if (m_workers_count > 1 && m_workers.empty()) {
+            start_workers();
+        }
+
+        m_remaining.store(n_nodes);
+
+        // spread initially ready tasks over queues, so workers start without stealing
+        uint thread_id = 0;
+        for (int node_id = 0; node_id < n_nodes; node_id++) {
+            if (m_nodes[node_id].n_deps == 0) {
+                push_task(thread_id, node_id);
+                thread_id = (thread_id + 1) % m_workers_count;
+            }
+        }
+
+        while (m_remaining.load() > 0) {
+            run_ready(0);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv_work.wait(lock, [&]() { return m_ready.load() > 0 || m_remaining.load() == 0; });
+        }
+
+        // report first failure in program order, as sequential schedule does
+        for (const Node& node : m_nodes) {
+            if (node.status != Status::Ok && node.status != Status::NoValue) {
+                return node.status;
+            }
+        }
+
+        return Status::Ok;
+    }
+
+    ref_ptr<ScheduleFuture> ScheduleGraph::submit_async() {
+        return schedule_submit_async(ref_ptr<Schedule>(this), m_last_future);
+    }
+
+    Status ScheduleGraph::get_task_status(int step_id, int task_id) {
+        if (step_id < 0 || step_id >= int(m_node_ids.size()) ||
+            task_id < 0 || task_id >= int(m_node_ids[step_id].size())) {
+            return Status::NoValue;
+        }
+        return m_nodes[m_node_ids[step_id][task_id]].status;
+    }
+
+    void ScheduleGraph::set_label(std::string label) {
+        m_label = std::move(label);
+    }
+
+    const std::string& ScheduleGraph::get_label() const {
+        return m_label;
+    }
+
+    void ScheduleGraph::build_graph() {
+        struct Access {
+            int              last_writer = -1;
+            std::vector<int> readers;
+        };
+
+        std::unordered_map<const Object*, Access> accesses;
+        std::vector<int>                          since_barrier;
+        std::vector<int>                          deps;
+        int                                       last_barrier = -1;
+
+        m_nodes.clear();
+        m_node_ids.resize(m_steps.size());
+
+        for (std::size_t step_id = 0; step_id < m_steps.size(); step_id++) {
+            m_node_ids[step_id].clear();
+
+            for (std::size_t task_id = 0; task_id < m_steps[step_id].size(); task_id++) {
+                const int node_id = static_cast<int>(m_nodes.size());
+
+                Node& node   = m_nodes.emplace_back();
+                node.task    = m_steps[step_id][task_id];
+                node.step_id = static_cast<int>(step_id);
+                node.task_id = static_cast<int>(task_id);
+                m_node_ids[step_id].push_back(node_id);
+
+                std::vector<ref_ptr<Object>> args      = node.task->get_args();
+                const int                    n_outputs = node.task->get_n_outputs();
+
+                deps.clear();
+
+                if (args.empty()) {
+                    // unknown side effects: wait for everything before, block everything after
+                    deps.swap(since_barrier);
+                    if (last_barrier >= 0) deps.push_back(last_barrier);
+                    last_barrier = node_id;
+                    accesses.clear();
+                } else {
+                    if (last_barrier >= 0) deps.push_back(last_barrier);
+
+                    for (int i = 0; i < int(args.size()); i++) {
+                        if (args[i].is_null()) continue;
+
+                        Access& access = accesses[args[i].get()];
+                        if (access.last_writer >= 0) deps.push_back(access.last_writer);
+                        if (i < n_outputs) deps.insert(deps.end(), access.readers.begin(), access.readers.end());
+                    }
+
+                    // outputs are updated last, so object both read and written ends up with this task as writer
+                    for (int i = n_outputs; i < int(args.size()); i++) {
+                        if (args[i].is_not_null()) accesses[args[i].get()].readers.push_back(node_id);
+                    }
+                    for (int i = 0; i < n_outputs && i < int(args.size()); i++) {
+                        if (args[i].is_null()) continue;
+
+                        Access& access     = accesses[args[i].get()];
+                        access.last_writer = node_id;
+                        access.readers.clear();
+                    }
+
+                    since_barrier.push_back(node_id);
+                }
+
+                std::sort(deps.begin(), deps.end());
+                deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+
+                for (int dep : deps) {
+                    m_nodes[dep].successors.push_back(node_id);
+                }
+                node.n_deps = static_cast<int>(deps.size());
+            }
+        }
+
+        const std::size_t n_nodes = m_nodes.size();
+        m_deps_left               = std::make_unique<std::atomic_int[]>(n_nodes);
+        for (std::size_t node_id = 0; node_id < n_nodes; node_id++) {
+            m_deps_left[node_id].store(m_nodes[node_id].n_deps);
+        }
+        m_first_failed.store(static_cast<int>(n_nodes));
+    }
+
+    void ScheduleGraph::start_workers() {
+        m_workers.reserve(m_workers_count - 1);
+        for (uint thread_id = 1; thread_id < m_workers_count; thread_id++) {
+            m_workers.emplace_back([this, thread_id]() { worker_main(thread_id); });
+        }
+    }
+
+    void ScheduleGraph::push_task(uint thread_id, int node_id) {
+        {
+            std::lock_guard<std::mutex> lock(m_queues[thread_id]->mutex);
+            m_queues[thread_id]->tasks.push_back(node_id);
+        }
+        m_ready.fetch_add(1);
+
+        // lock is required to not lose wake up of thread checking for ready tasks right now
+        { std::lock_guard<std::mutex> lock(m_mutex); }
+        m_cv_work.notify_one();
+    }
+
+    bool ScheduleGraph::pop_task(uint thread_id, int& node_id) {
+        // own queue is used as a stack: recently released successors likely reuse data in cache
+        {
+            WorkerQueue&                queue = *m_queues[thread_id];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                node_id = queue.tasks.back();
+                queue.tasks.pop_back();
+                m_ready.fetch_sub(1);
+                return true;
+            }
+        }
+
+        // steal oldest task of other worker
+        for (uint i = 1; i < m_workers_count; i++) {
+            WorkerQueue&                queue = *m_queues[(thread_id + i) % m_workers_count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                node_id = queue.tasks.front();
+                queue.tasks.pop_front();
+                m_ready.fetch_sub(1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ScheduleGraph::run_node(uint thread_id, int node_id) {
+        Node& node = m_nodes[node_id];
+
+        // task is skipped if some task before it in program order failed,
+        // this also covers all tasks depending on the failed one
+        if (node_id < m_first_failed.load()) {
+            DispatchContext ctx{};
+            ctx.schedule  = ref_ptr<Schedule>(this);
+            ctx.task      = node.task;
+            ctx.thread_id = int(thread_id);
+            ctx.step_id   = node.step_id;
+            ctx.task_id   = node.task_id;
+
+            node.status = Library::get()->get_dispatcher()->dispatch(ctx);
+
+            if (node.status != Status::Ok) {
+                int first_failed = m_first_failed.load();
+                while (node_id < first_failed && !m_first_failed.compare_exchange_weak(first_failed, node_id)) {}
+            }
+        }
+
+        for (int successor : node.successors) {
+            if (m_deps_left[successor].fetch_sub(1) == 1) {
+                push_task(thread_id, successor);
+            }
+        }
+
+        if (m_remaining.fetch_sub(1) == 1) {
+            { std::lock_guard<std::mutex> lock(m_mutex); }
+            m_cv_work.notify_all();
+        }
+    }
+
+    void ScheduleGraph::run_ready(uint thread_id) {
+        int node_id;
+        while (pop_task(thread_id, node_id)) {
+            run_node(thread_id, node_id);
+        }
+    }
+
+    void ScheduleGraph::worker_main(uint thread_id) {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv_work.wait(lock, [&]() { return m_stop || m_ready.load() > 0; });
+                if (m_stop) {
+                    return;
+                }
+            }
+
+            run_ready(thread_id);
+        }
+    }
+
+}// namespace spla
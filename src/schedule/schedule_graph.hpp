@@ -0,0 +1,129 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_SCHEDULE_GRAPH_HPP
+#define SPLA_SCHEDULE_GRAPH_HPP
+
+#include <spla/schedule.hpp>
+
+#include <schedule/schedule_future.hpp>
+
+#include <svector.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class ScheduleGraph
+     * @brief Schedule executing tasks out of order following data dependencies between them
+     *
+     * On submit tasks of all steps are flattened in program order and a dependency
+     * graph is built from objects read and written by each task (read after write,
+     * write after read and write after write hazards). Tasks without arguments
+     * are barriers. Ready tasks are executed by a pool of workers, each owning
+     * a queue of tasks; idle workers steal tasks from queues of other workers.
+     *
+     * As in sequential schedule, after a task fails no task following it in
+     * program order is started; such tasks keep NoValue status.
+     */
+    class ScheduleGraph final : public Schedule {
+    public:
+        explicit ScheduleGraph(uint workers_count);
+        ~ScheduleGraph() override;
+        Status                  step_task(ref_ptr<ScheduleTask> task) override;
+        Status                  step_tasks(std::vector<ref_ptr<ScheduleTask>> tasks) override;
+        Status                  submit() override;
+        ref_ptr<ScheduleFuture> submit_async() override;
+        Status                  get_task_status(int step_id, int task_id) override;
+        void                    set_label(std::string label) override;
+        const std::string&      get_label() const override;
+
+    private:
+        struct Node {
+            ref_ptr<ScheduleTask> task;
+            std::vector<int>      successors;
+            int                   n_deps  = 0;
+            int                   step_id = 0;
+            int                   task_id = 0;
+            Status                status  = Status::NoValue;
+        };
+
+        struct WorkerQueue {
+            std::mutex      mutex;
+            std::deque<int> tasks;
+        };
+
+        void build_graph();
+        void start_workers();
+        void push_task(uint thread_id, int node_id);
+        bool pop_task(uint thread_id, int& node_id);
+        void run_node(uint thread_id, int node_id);
+        void run_ready(uint thread_id);
+        void worker_main(uint thread_id);
+
+    private:
+        using vector_step  = ankerl::svector<ref_ptr<ScheduleTask>, 4>;
+        using vector_steps = ankerl::svector<vector_step, 4>;
+
+        vector_steps                        m_steps;
+        std::vector<std::vector<int>>       m_node_ids;
+        std::vector<Node>                   m_nodes;
+        std::unique_ptr<std::atomic_int[]>  m_deps_left;
+        std::atomic_int                     m_first_failed{0};
+        std::string                         m_label;
+        ref_ptr<ScheduleFutureImpl>         m_last_future;
+        uint                                m_workers_count;
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+        std::vector<std::thread>                  m_workers;
+        std::mutex                                m_mutex;
+        std::condition_variable                   m_cv_work;
+        bool                                      m_stop = false;
+        std::atomic_int                           m_ready{0};
+        std::atomic_int                           m_remaining{0};
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_SCHEDULE_GRAPH_HPP
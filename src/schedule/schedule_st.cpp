@@ -33,6 +33,7 @@ namespace spla {
 
     Status ScheduleSingleThread::step_task(ref_ptr<ScheduleTask> task) {
         m_steps.emplace_back().push_back(std::move(task));
+        m_fusions_valid = false;
         return Status::Ok;
     }
 
@@ -40,6 +41,7 @@ namespace spla {
         auto& step = m_steps.emplace_back();
         step.reserve(tasks.size());
         for (auto& task : tasks) step.push_back(std::move(task));
+        m_fusions_valid = false;
         return Status::Ok;
     }
 
@@ -49,16 +51,46 @@ namespace spla {
 
         ctx.schedule = ref_ptr<Schedule>(this);
 
+        m_statuses.resize(m_steps.size());
+        for (std::size_t step_id = 0; step_id < m_steps.size(); step_id++) {
+            m_statuses[step_id].assign(m_steps[step_id].size(), Status::NoValue);
+        }
+
+        update_fusions();
+
+        std::size_t fusion_id = 0;
+
         for (int step_id = 0; step_id < static_cast<int>(m_steps.size()); step_id++) {
             auto& step  = m_steps[step_id];
             ctx.step_id = step_id;
 
+            if (fusion_id < m_fusions.size() && m_fusions[fusion_id].first_step == step_id) {
+                const int n_steps = m_fusions[fusion_id].n_steps;
+                auto&     fused   = m_fused[fusion_id];
+                ctx.task          = fused.as<ScheduleTask>();
+                ctx.task_id       = 0;
+
+                fused->statuses.assign(n_steps, Status::NoValue);
+                auto status = g_dispatcher->dispatch(ctx);
+                for (int i = 0; i < n_steps; i++) {
+                    m_statuses[step_id + i][0] = fused->statuses[i];
+                }
+                if (status != Status::Ok) {
+                    return status;
+                }
+
+                step_id += n_steps - 1;
+                fusion_id += 1;
+                continue;
+            }
+
             for (int task_id = 0; task_id < static_cast<int>(step.size()); task_id++) {
                 auto& task  = step[task_id];
                 ctx.task    = task;
                 ctx.task_id = task_id;
 
-                auto status = g_dispatcher->dispatch(ctx);
+                auto status                  = g_dispatcher->dispatch(ctx);
+                m_statuses[step_id][task_id] = status;
                 if (status != Status::Ok) {
                     return status;
                 }
@@ -68,6 +100,56 @@ namespace spla {
         return Status::Ok;
     }
 
+    void ScheduleSingleThread::update_fusions() {
+        // plan depends only on tasks of steps and their arguments, so it is kept until either changes
+        std::uint64_t args_version = 0;
+        for (const auto& step : m_steps) {
+            if (step.size() == 1) args_version += static_cast<ScheduleTaskBase*>(step.front().get())->args_version.load();
+        }
+        if (m_fusions_valid && m_fusions_args_version == args_version) {
+            return;
+        }
+        m_fusions_valid        = true;
+        m_fusions_args_version = args_version;
+
+        std::vector<ScheduleTask*> steps(m_steps.size(), nullptr);
+        for (std::size_t step_id = 0; step_id < m_steps.size(); step_id++) {
+            if (m_steps[step_id].size() == 1) steps[step_id] = m_steps[step_id].front().get();
+        }
+
+        schedule_find_fusions(steps, m_fusions);
+        m_fused.resize(m_fusions.size());
+
+        // keep fused tasks of unchanged chains, so resubmit reuses their dispatch cache
+        for (std::size_t fusion_id = 0; fusion_id < m_fusions.size(); fusion_id++) {
+            const auto& fusion = m_fusions[fusion_id];
+            auto&       fused  = m_fused[fusion_id];
+
+            bool same = fused && int(fused->tasks.size()) == fusion.n_steps;
+            for (int i = 0; same && i < fusion.n_steps; i++) {
+                same = fused->tasks[i] == m_steps[fusion.first_step + i].front();
+            }
+            if (same) continue;
+
+            fused = make_ref<ScheduleTask_v_fused>();
+            for (int i = 0; i < fusion.n_steps; i++) {
+                fused->tasks.push_back(m_steps[fusion.first_step + i].front());
+            }
+        }
+    }
+
+    ref_ptr<ScheduleFuture> ScheduleSingleThread::submit_async() {
+        return schedule_submit_async(ref_ptr<Schedule>(this), m_last_future);
+    }
+
+    Status ScheduleSingleThread::get_task_status(int step_id, int task_id) {
+        if (step_id < 0 || step_id >= int(m_statuses.size()) ||
+            task_id < 0 || task_id >= int(m_statuses[step_id].size())) {
+            return Status::NoValue;
+        }
+        return m_statuses[step_id][task_id];
+    }
+
     void ScheduleSingleThread::set_label(std::string label) {
         m_label = std::move(label);
     }
@@ -30,9 +30,15 @@
 
 #include <spla/schedule.hpp>
 
+#include <schedule/schedule_fusion.hpp>
+#include <schedule/schedule_future.hpp>
+#include <schedule/schedule_tasks.hpp>
+
 #include <svector.hpp>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace spla {
 
@@ -44,22 +50,35 @@ namespace spla {
     /**
      * @class ScheduleSingleThread
      * @brief Single-thread dispatch sequential execution schedule
+     *
+     * Chains of element-wise vector tasks in consecutive steps are
+     * executed as fused tasks, see `schedule_find_fusions`.
      */
     class ScheduleSingleThread final : public Schedule {
     public:
         ~ScheduleSingleThread() override = default;
-        Status             step_task(ref_ptr<ScheduleTask> task) override;
-        Status             step_tasks(std::vector<ref_ptr<ScheduleTask>> tasks) override;
-        Status             submit() override;
-        void               set_label(std::string label) override;
-        const std::string& get_label() const override;
+        Status                  step_task(ref_ptr<ScheduleTask> task) override;
+        Status                  step_tasks(std::vector<ref_ptr<ScheduleTask>> tasks) override;
+        Status                  submit() override;
+        ref_ptr<ScheduleFuture> submit_async() override;
+        Status                  get_task_status(int step_id, int task_id) override;
+        void                    set_label(std::string label) override;
+        const std::string&      get_label() const override;
 
     private:
+        void update_fusions();
+
         using vector_step  = ankerl::svector<ref_ptr<ScheduleTask>, 4>;
         using vector_steps = ankerl::svector<vector_step, 4>;
 
-        vector_steps m_steps;
-        std::string  m_label;
+        vector_steps                               m_steps;
+        std::vector<std::vector<Status>>           m_statuses;
+        std::string                                m_label;
+        ref_ptr<ScheduleFutureImpl>                m_last_future;
+        std::vector<ScheduleFusion>                m_fusions;
+        std::vector<ref_ptr<ScheduleTask_v_fused>> m_fused;
+        std::uint64_t                              m_fusions_args_version = 0;
+        bool                                       m_fusions_valid        = false;
     };
 
     /**
@@ -29,6 +29,7 @@
 
 #include <core/registry.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 namespace spla {
@@ -49,6 +50,10 @@ namespace spla {
         return desc.is_not_null() ? desc : default_desc;
     }
 
+    int ScheduleTaskBase::get_n_outputs() {
+        return 1;
+    }
+
     std::string ScheduleTask_callback::get_name() {
         return "callback";
     }
@@ -61,6 +66,12 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_callback::get_args() {
         return {};
     }
+    Status ScheduleTask_callback::set_arg(int, ref_ptr<Object>) {
+        return Status::InvalidArgument;
+    }
+    int ScheduleTask_callback::get_n_outputs() {
+        return 0;
+    }
 
     std::string ScheduleTask_mxm::get_name() {
         return "mxm";
@@ -83,6 +94,24 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_mxm::get_args() {
         return {R.as<Object>(), A.as<Object>(), B.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), init.as<Object>()};
     }
+    Status ScheduleTask_mxm::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(R, std::move(arg));
+            case 1:
+                return bind_arg(A, std::move(arg));
+            case 2:
+                return bind_arg(B, std::move(arg));
+            case 3:
+                return bind_arg(op_multiply, std::move(arg));
+            case 4:
+                return bind_arg(op_add, std::move(arg));
+            case 5:
+                return bind_arg(init, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_mxmT_masked::get_name() {
         return "mxmT_masked";
@@ -106,6 +135,73 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_mxmT_masked::get_args() {
         return {R.as<Object>(), mask.as<Object>(), A.as<Object>(), B.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), op_select.as<Object>(), init.as<Object>()};
     }
+    Status ScheduleTask_mxmT_masked::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(R, std::move(arg));
+            case 1:
+                return bind_arg(mask, std::move(arg));
+            case 2:
+                return bind_arg(A, std::move(arg));
+            case 3:
+                return bind_arg(B, std::move(arg));
+            case 4:
+                return bind_arg(op_multiply, std::move(arg));
+            case 5:
+                return bind_arg(op_add, std::move(arg));
+            case 6:
+                return bind_arg(op_select, std::move(arg));
+            case 7:
+                return bind_arg(init, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
+
+    std::string ScheduleTask_mxmT_masked_reduce::get_name() {
+        return "mxmT_masked_reduce";
+    }
+    std::string ScheduleTask_mxmT_masked_reduce::get_key() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(r->get_type());
+
+        return key.str();
+    }
+    std::string ScheduleTask_mxmT_masked_reduce::get_key_full() {
+        std::stringstream key;
+        key << get_name()
+            << OP_KEY(op_multiply)
+            << OP_KEY(op_add)
+            << OP_KEY(op_select);
+
+        return key.str();
+    }
+    std::vector<ref_ptr<Object>> ScheduleTask_mxmT_masked_reduce::get_args() {
+        return {r.as<Object>(), s.as<Object>(), mask.as<Object>(), A.as<Object>(), B.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), op_select.as<Object>()};
+    }
+    Status ScheduleTask_mxmT_masked_reduce::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(s, std::move(arg));
+            case 2:
+                return bind_arg(mask, std::move(arg));
+            case 3:
+                return bind_arg(A, std::move(arg));
+            case 4:
+                return bind_arg(B, std::move(arg));
+            case 5:
+                return bind_arg(op_multiply, std::move(arg));
+            case 6:
+                return bind_arg(op_add, std::move(arg));
+            case 7:
+                return bind_arg(op_select, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_kron::get_name() {
         return "kron";
@@ -127,6 +223,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_kron::get_args() {
         return {R.as<Object>(), A.as<Object>(), B.as<Object>(), op_multiply.as<Object>()};
     }
+    Status ScheduleTask_kron::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(R, std::move(arg));
+            case 1:
+                return bind_arg(A, std::move(arg));
+            case 2:
+                return bind_arg(B, std::move(arg));
+            case 3:
+                return bind_arg(op_multiply, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_mxv_masked::get_name() {
         return "mxv_masked";
@@ -150,6 +260,28 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_mxv_masked::get_args() {
         return {r.as<Object>(), mask.as<Object>(), M.as<Object>(), v.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), op_select.as<Object>(), init.as<Object>()};
     }
+    Status ScheduleTask_mxv_masked::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(mask, std::move(arg));
+            case 2:
+                return bind_arg(M, std::move(arg));
+            case 3:
+                return bind_arg(v, std::move(arg));
+            case 4:
+                return bind_arg(op_multiply, std::move(arg));
+            case 5:
+                return bind_arg(op_add, std::move(arg));
+            case 6:
+                return bind_arg(op_select, std::move(arg));
+            case 7:
+                return bind_arg(init, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_vxm_masked::get_name() {
         return "vxm_masked";
@@ -173,6 +305,28 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_vxm_masked::get_args() {
         return {r.as<Object>(), mask.as<Object>(), v.as<Object>(), M.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), op_select.as<Object>(), init.as<Object>()};
     }
+    Status ScheduleTask_vxm_masked::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(mask, std::move(arg));
+            case 2:
+                return bind_arg(v, std::move(arg));
+            case 3:
+                return bind_arg(M, std::move(arg));
+            case 4:
+                return bind_arg(op_multiply, std::move(arg));
+            case 5:
+                return bind_arg(op_add, std::move(arg));
+            case 6:
+                return bind_arg(op_select, std::move(arg));
+            case 7:
+                return bind_arg(init, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_m_eadd::get_name() {
         return "m_eadd";
@@ -194,6 +348,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_m_eadd::get_args() {
         return {R.as<Object>(), A.as<Object>(), B.as<Object>(), op.as<Object>()};
     }
+    Status ScheduleTask_m_eadd::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(R, std::move(arg));
+            case 1:
+                return bind_arg(A, std::move(arg));
+            case 2:
+                return bind_arg(B, std::move(arg));
+            case 3:
+                return bind_arg(op, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_m_emult::get_name() {
         return "m_emult";
@@ -215,6 +383,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_m_emult::get_args() {
         return {R.as<Object>(), A.as<Object>(), B.as<Object>(), op.as<Object>()};
     }
+    Status ScheduleTask_m_emult::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(R, std::move(arg));
+            case 1:
+                return bind_arg(A, std::move(arg));
+            case 2:
+                return bind_arg(B, std::move(arg));
+            case 3:
+                return bind_arg(op, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_m_reduce_by_row::get_name() {
         return "m_reduce_by_row";
@@ -236,6 +418,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_m_reduce_by_row::get_args() {
         return {r.as<Object>(), M.as<Object>(), op_reduce.as<Object>(), init.as<Object>()};
     }
+    Status ScheduleTask_m_reduce_by_row::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(M, std::move(arg));
+            case 2:
+                return bind_arg(op_reduce, std::move(arg));
+            case 3:
+                return bind_arg(init, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_m_reduce_by_column::get_name() {
         return "m_reduce_by_column";
@@ -257,6 +453,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_m_reduce_by_column::get_args() {
         return {r.as<Object>(), M.as<Object>(), op_reduce.as<Object>(), init.as<Object>()};
     }
+    Status ScheduleTask_m_reduce_by_column::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(M, std::move(arg));
+            case 2:
+                return bind_arg(op_reduce, std::move(arg));
+            case 3:
+                return bind_arg(init, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_m_reduce::get_name() {
         return "m_reduce";
@@ -278,6 +488,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_m_reduce::get_args() {
         return {r.as<Object>(), s.as<Object>(), M.as<Object>(), op_reduce.as<Object>()};
     }
+    Status ScheduleTask_m_reduce::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(s, std::move(arg));
+            case 2:
+                return bind_arg(M, std::move(arg));
+            case 3:
+                return bind_arg(op_reduce, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_m_transpose::get_name() {
         return "m_transpose";
@@ -299,6 +523,18 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_m_transpose::get_args() {
         return {R.as<Object>(), M.as<Object>(), op_apply.as<Object>()};
     }
+    Status ScheduleTask_m_transpose::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(R, std::move(arg));
+            case 1:
+                return bind_arg(M, std::move(arg));
+            case 2:
+                return bind_arg(op_apply, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_m_extract_row::get_name() {
         return "m_extract_row";
@@ -320,6 +556,18 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_m_extract_row::get_args() {
         return {r.as<Object>(), M.as<Object>(), op_apply.as<Object>()};
     }
+    Status ScheduleTask_m_extract_row::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(M, std::move(arg));
+            case 2:
+                return bind_arg(op_apply, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_m_extract_column::get_name() {
         return "m_extract_column";
@@ -341,6 +589,18 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_m_extract_column::get_args() {
         return {r.as<Object>(), M.as<Object>(), op_apply.as<Object>()};
     }
+    Status ScheduleTask_m_extract_column::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(M, std::move(arg));
+            case 2:
+                return bind_arg(op_apply, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_v_eadd::get_name() {
         return "v_eadd";
@@ -362,6 +622,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_v_eadd::get_args() {
         return {r.as<Object>(), u.as<Object>(), v.as<Object>(), op.as<Object>()};
     }
+    Status ScheduleTask_v_eadd::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(u, std::move(arg));
+            case 2:
+                return bind_arg(v, std::move(arg));
+            case 3:
+                return bind_arg(op, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_v_emult::get_name() {
         return "v_emult";
@@ -383,6 +657,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_v_emult::get_args() {
         return {r.as<Object>(), u.as<Object>(), v.as<Object>(), op.as<Object>()};
     }
+    Status ScheduleTask_v_emult::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(u, std::move(arg));
+            case 2:
+                return bind_arg(v, std::move(arg));
+            case 3:
+                return bind_arg(op, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_v_eadd_fdb::get_name() {
         return "v_eadd_fdb";
@@ -402,7 +690,24 @@ namespace spla {
         return key.str();
     }
     std::vector<ref_ptr<Object>> ScheduleTask_v_eadd_fdb::get_args() {
-        return {r.as<Object>(), v.as<Object>(), fdb.as<Object>(), op.as<Object>()};
+        return {r.as<Object>(), fdb.as<Object>(), v.as<Object>(), op.as<Object>()};
+    }
+    Status ScheduleTask_v_eadd_fdb::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(fdb, std::move(arg));
+            case 2:
+                return bind_arg(v, std::move(arg));
+            case 3:
+                return bind_arg(op, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
+    int ScheduleTask_v_eadd_fdb::get_n_outputs() {
+        return 2;
     }
 
     std::string ScheduleTask_v_assign_masked::get_name() {
@@ -426,6 +731,22 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_v_assign_masked::get_args() {
         return {r.as<Object>(), mask.as<Object>(), value.as<Object>(), op_assign.as<Object>(), op_select.as<Object>()};
     }
+    Status ScheduleTask_v_assign_masked::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(mask, std::move(arg));
+            case 2:
+                return bind_arg(value, std::move(arg));
+            case 3:
+                return bind_arg(op_assign, std::move(arg));
+            case 4:
+                return bind_arg(op_select, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_v_map::get_name() {
         return "v_map";
@@ -447,6 +768,18 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_v_map::get_args() {
         return {r.as<Object>(), v.as<Object>(), op.as<Object>()};
     }
+    Status ScheduleTask_v_map::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(v, std::move(arg));
+            case 2:
+                return bind_arg(op, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_v_reduce::get_name() {
         return "v_reduce";
@@ -468,6 +801,20 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_v_reduce::get_args() {
         return {r.as<Object>(), s.as<Object>(), v.as<Object>(), op_reduce.as<Object>()};
     }
+    Status ScheduleTask_v_reduce::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(s, std::move(arg));
+            case 2:
+                return bind_arg(v, std::move(arg));
+            case 3:
+                return bind_arg(op_reduce, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
 
     std::string ScheduleTask_v_count_mf::get_name() {
         return "v_count_mf";
@@ -489,5 +836,78 @@ namespace spla {
     std::vector<ref_ptr<Object>> ScheduleTask_v_count_mf::get_args() {
         return {r.as<Object>(), v.as<Object>()};
     }
+    Status ScheduleTask_v_count_mf::set_arg(int index, ref_ptr<Object> arg) {
+        switch (index) {
+            case 0:
+                return bind_arg(r, std::move(arg));
+            case 1:
+                return bind_arg(v, std::move(arg));
+            default:
+                return Status::InvalidArgument;
+        }
+    }
+
+    std::string ScheduleTask_v_fused::get_name() {
+        return "v_fused";
+    }
+    std::string ScheduleTask_v_fused::get_key() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(tasks.front()->get_args().front().cast_safe<Vector>()->get_type());
+
+        return key.str();
+    }
+    std::string ScheduleTask_v_fused::get_key_full() {
+        std::stringstream key;
+        key << get_name();
+        for (auto& task : tasks) {
+            key << "_" << task->get_key_full();
+        }
+
+        return key.str();
+    }
+    std::vector<ref_ptr<Object>> ScheduleTask_v_fused::get_args() {
+        std::vector<ref_ptr<Object>> outputs;
+        std::vector<ref_ptr<Object>> inputs;
+
+        for (auto& task : tasks) {
+            std::vector<ref_ptr<Object>> args      = task->get_args();
+            const int                    n_outputs = task->get_n_outputs();
+
+            for (int i = 0; i < int(args.size()); i++) {
+                auto& list = i < n_outputs ? outputs : inputs;
+                if (std::find(list.begin(), list.end(), args[i]) == list.end()) {
+                    list.push_back(args[i]);
+                }
+            }
+        }
+
+        for (auto& input : inputs) {
+            if (std::find(outputs.begin(), outputs.end(), input) == outputs.end()) {
+                outputs.push_back(input);
+            }
+        }
+
+        return outputs;
+    }
+    int ScheduleTask_v_fused::get_n_outputs() {
+        std::vector<ref_ptr<Object>> outputs;
+
+        for (auto& task : tasks) {
+            std::vector<ref_ptr<Object>> args      = task->get_args();
+            const int                    n_outputs = task->get_n_outputs();
+
+            for (int i = 0; i < n_outputs; i++) {
+                if (std::find(outputs.begin(), outputs.end(), args[i]) == outputs.end()) {
+                    outputs.push_back(args[i]);
+                }
+            }
+        }
+
+        return int(outputs.size());
+    }
+    Status ScheduleTask_v_fused::set_arg(int, ref_ptr<Object>) {
+        return Status::InvalidArgument;
+    }
 
 }// namespace spla
@@ -33,6 +33,11 @@
 
 #include <profiling/time_profiler.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
 namespace spla {
 
     /**
@@ -40,6 +45,15 @@ namespace spla {
      * @{
      */
 
+    /**
+     * @class ScheduleTaskScratch
+     * @brief Base class for algorithm data kept with a task between executions
+     */
+    class ScheduleTaskScratch {
+    public:
+        virtual ~ScheduleTaskScratch() = default;
+    };
+
     /**
      * @class ScheduleTaskBase
      * @brief Base schedule task class with common public properties
@@ -52,9 +66,57 @@ namespace spla {
         const std::string&  get_label() const override;
         ref_ptr<Descriptor> get_desc() override;
         ref_ptr<Descriptor> get_desc_or_default() override;
+        int                 get_n_outputs() override;
 
         std::string         label;
         ref_ptr<Descriptor> desc;
+
+        /**
+         * @brief Scratch data of algorithm executing this task
+         *
+         * Created on first access, and recreated if previous scratch
+         * was created by other algorithm (for instance, for other type).
+         */
+        template<typename S>
+        S& get_scratch() {
+            auto* p_scratch = dynamic_cast<S*>(scratch.get());
+            if (!p_scratch) {
+                p_scratch = new S();
+                scratch.reset(p_scratch);
+            }
+            return *p_scratch;
+        }
+
+        /** Dispatch result cached on first execution, see Dispatcher */
+        std::atomic<std::uint64_t>           dispatch_cache{0};
+        std::unique_ptr<ScheduleTaskScratch> scratch;
+
+        /** Incremented on each rebind of argument, so schedules know when to plan again */
+        std::atomic<std::uint32_t> args_version{0};
+
+    protected:
+        template<typename T>
+        Status bind_arg(ref_ptr<T>& slot, ref_ptr<Object> arg) {
+            if (arg.is_null() || !arg.template is<T>()) {
+                return Status::InvalidArgument;
+            }
+            ref_ptr<T> new_slot = arg.template cast<T>();
+
+            // algorithm must be selected again if key of task may change
+            bool same_key = false;
+            if constexpr (std::is_same_v<T, Matrix> || std::is_same_v<T, Vector> || std::is_same_v<T, Scalar>) {
+                same_key = slot.is_not_null() && slot->get_type() == new_slot->get_type();
+            } else {
+                same_key = slot == new_slot;
+            }
+            if (!same_key) {
+                dispatch_cache.store(0);
+            }
+
+            slot = std::move(new_slot);
+            args_version.fetch_add(1);
+            return Status::Ok;
+        }
     };
 
     /**
@@ -69,6 +131,8 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
+        int                          get_n_outputs() override;
 
         ScheduleCallback callback;
     };
@@ -85,6 +149,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Matrix>   R;
         ref_ptr<Matrix>   A;
@@ -106,6 +171,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Matrix>   R;
         ref_ptr<Matrix>   mask;
@@ -117,6 +183,30 @@ namespace spla {
         ref_ptr<Scalar>   init;
     };
 
+    /**
+     * @class ScheduleTask_mxmT_masked_reduce
+     * @brief Masked matrix matrix-transposed product reduced to scalar
+     */
+    class ScheduleTask_mxmT_masked_reduce final : public ScheduleTaskBase {
+    public:
+        ~ScheduleTask_mxmT_masked_reduce() override = default;
+
+        std::string                  get_name() override;
+        std::string                  get_key() override;
+        std::string                  get_key_full() override;
+        std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
+
+        ref_ptr<Scalar>   r;
+        ref_ptr<Scalar>   s;
+        ref_ptr<Matrix>   mask;
+        ref_ptr<Matrix>   A;
+        ref_ptr<Matrix>   B;
+        ref_ptr<OpBinary> op_multiply;
+        ref_ptr<OpBinary> op_add;
+        ref_ptr<OpSelect> op_select;
+    };
+
     /**
      * @class ScheduleTask_kron
      * @brief Sparse matrix kronecker product
@@ -129,6 +219,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Matrix>   R;
         ref_ptr<Matrix>   A;
@@ -148,6 +239,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>   r;
         ref_ptr<Vector>   mask;
@@ -171,6 +263,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>   r;
         ref_ptr<Vector>   mask;
@@ -194,6 +287,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Matrix>   R;
         ref_ptr<Matrix>   A;
@@ -213,6 +307,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Matrix>   R;
         ref_ptr<Matrix>   A;
@@ -232,6 +327,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>   r;
         ref_ptr<Matrix>   M;
@@ -251,6 +347,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>   r;
         ref_ptr<Matrix>   M;
@@ -270,6 +367,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Scalar>   r;
         ref_ptr<Scalar>   s;
@@ -289,6 +387,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Matrix>  R;
         ref_ptr<Matrix>  M;
@@ -307,6 +406,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>  r;
         ref_ptr<Matrix>  M;
@@ -326,6 +426,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>  r;
         ref_ptr<Matrix>  M;
@@ -345,6 +446,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>   r;
         ref_ptr<Vector>   u;
@@ -364,6 +466,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>   r;
         ref_ptr<Vector>   u;
@@ -383,6 +486,8 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
+        int                          get_n_outputs() override;
 
         ref_ptr<Vector>   r;
         ref_ptr<Vector>   v;
@@ -402,6 +507,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>   r;
         ref_ptr<Vector>   mask;
@@ -422,6 +528,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Vector>  r;
         ref_ptr<Vector>  v;
@@ -440,6 +547,7 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Scalar>   r;
         ref_ptr<Scalar>   s;
@@ -459,11 +567,34 @@ namespace spla {
         std::string                  get_key() override;
         std::string                  get_key_full() override;
         std::vector<ref_ptr<Object>> get_args() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
 
         ref_ptr<Scalar> r;
         ref_ptr<Vector> v;
     };
 
+    /**
+     * @class ScheduleTask_v_fused
+     * @brief Chain of element-wise vector tasks executed as a single pass
+     *
+     * Made by schedule fusion pass, see `schedule_find_fusions`. Arguments are
+     * arguments of all chained tasks, written objects first.
+     */
+    class ScheduleTask_v_fused final : public ScheduleTaskBase {
+    public:
+        ~ScheduleTask_v_fused() override = default;
+
+        std::string                  get_name() override;
+        std::string                  get_key() override;
+        std::string                  get_key_full() override;
+        std::vector<ref_ptr<Object>> get_args() override;
+        int                          get_n_outputs() override;
+        Status                       set_arg(int index, ref_ptr<Object> arg) override;
+
+        std::vector<ref_ptr<ScheduleTask>> tasks;   // chained tasks in execution order
+        std::vector<Status>                statuses;// status of each chained task after execution
+    };
+
     /**
      * @}
      */
@@ -0,0 +1,200 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "schedule_tp.hpp"
+
+#include <core/dispatcher.hpp>
+
+#include <algorithm>
+
+namespace spla {
+
+    ScheduleThreadPool::ScheduleThreadPool(uint workers_count) {
+        m_workers_count = workers_count > 0 ? workers_count : std::max(1u, uint(std::thread::hardware_concurrency()));
+    }
+
+    ScheduleThreadPool::~ScheduleThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv_work.notify_all();
+
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    Status ScheduleThreadPool::step_task(ref_ptr<ScheduleTask> task) {
+        m_steps.emplace_back().push_back(std::move(task));
+        return Status::Ok;
+    }
+
+    Status ScheduleThreadPool::step_tasks(std::vector<ref_ptr<ScheduleTask>> tasks) {
+        auto& step = m_steps.emplace_back();
+        step.reserve(tasks.size());
+        for (auto& task : tasks) step.push_back(std::move(task));
+        return Status::Ok;
+    }
+
+    Status ScheduleThreadPool::submit() {
+        m_statuses.resize(m_steps.size());
+        for (std::size_t step_id = 0; step_id < m_steps.size(); step_id++) {
+            m_statuses[step_id].assign(m_steps[step_id].size(), Status::NoValue);
+        }
+
+        for (int step_id = 0; step_id < static_cast<int>(m_steps.size()); step_id++) {
+            run_step(step_id);
+
+            for (Status status : m_statuses[step_id]) {
+                if (status != Status::Ok) {
+                    return status;
+                }
+            }
+        }
+
+        return Status::Ok;
+    }
+
+    ref_ptr<ScheduleFuture> ScheduleThreadPool::submit_async() {
+        return schedule_submit_async(ref_ptr<Schedule>(this), m_last_future);
+    }
+
+    Status ScheduleThreadPool::get_task_status(int step_id, int task_id) {
+        if (step_id < 0 || step_id >= int(m_statuses.size()) ||
+            task_id < 0 || task_id >= int(m_statuses[step_id].size())) {
+            return Status::NoValue;
+        }
+        return m_statuses[step_id][task_id];
+    }
+
+    void ScheduleThreadPool::set_label(std::string label) {
+        m_label = std::move(label);
+    }
+
+    const std::string& ScheduleThreadPool::get_label() const {
+        return m_label;
+    }
+
+    void ScheduleThreadPool::start_workers() {
+        m_workers.reserve(m_workers_count - 1);
+        for (uint thread_id = 1; thread_id < m_workers_count; thread_id++) {
+            m_workers.emplace_back([this, thread_id]() { worker_main(thread_id); });
+        }
+    }
+
+    void ScheduleThreadPool::run_step(int step_id) {
+        const int n_tasks = static_cast<int>(m_steps[step_id].size());
+
+        // single task step is not worth waking up workers
+        if (n_tasks <= 1 || m_workers_count <= 1) {
+            for (int task_id = 0; task_id < n_tasks; task_id++) {
+                run_task(0, step_id, task_id);
+            }
+            return;
+        }
+
+        if (m_workers.empty()) {
+            start_workers();
+        }
+
+        std::uint32_t generation;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            generation   = ++m_generation;
+            m_step_id    = step_id;
+            m_step_tasks = n_tasks;
+            m_pending    = n_tasks;
+            m_next_task.store(std::uint64_t(generation) << 32u);
+        }
+        m_cv_work.notify_all();
+
+        run_tasks(0, step_id, n_tasks, generation);
+
+        // barrier: all tasks of the step must finish before the next one starts
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_done.wait(lock, [&]() { return m_pending == 0; });
+    }
+
+    void ScheduleThreadPool::run_tasks(uint thread_id, int step_id, int n_tasks, std::uint32_t generation) {
+        while (true) {
+            // task counter is tagged by step generation, so a late worker can not take task of a next step
+            std::uint64_t next = m_next_task.load();
+            int           task_id;
+            do {
+                task_id = int(next & 0xffffffffu);
+                if (std::uint32_t(next >> 32u) != generation || task_id >= n_tasks) {
+                    return;
+                }
+            } while (!m_next_task.compare_exchange_weak(next, next + 1));
+
+            run_task(thread_id, step_id, task_id);
+
+            bool is_last;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                is_last = --m_pending == 0;
+            }
+            if (is_last) {
+                m_cv_done.notify_all();
+            }
+        }
+    }
+
+    void ScheduleThreadPool::run_task(uint thread_id, int step_id, int task_id) {
+        DispatchContext ctx{};
+        ctx.schedule  = ref_ptr<Schedule>(this);
+        ctx.task      = m_steps[step_id][task_id];
+        ctx.thread_id = int(thread_id);
+        ctx.step_id   = step_id;
+        ctx.task_id   = task_id;
+
+        m_statuses[step_id][task_id] = Library::get()->get_dispatcher()->dispatch(ctx);
+    }
+
+    void ScheduleThreadPool::worker_main(uint thread_id) {
+        std::uint32_t seen = 0;
+
+        while (true) {
+            int step_id;
+            int n_tasks;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv_work.wait(lock, [&]() { return m_stop || m_generation != seen; });
+                if (m_stop) {
+                    return;
+                }
+                seen    = m_generation;
+                step_id = m_step_id;
+                n_tasks = m_step_tasks;
+            }
+
+            run_tasks(thread_id, step_id, n_tasks, seen);
+        }
+    }
+
+}// namespace spla
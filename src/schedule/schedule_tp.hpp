@@ -0,0 +1,107 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_SCHEDULE_TP_HPP
+#define SPLA_SCHEDULE_TP_HPP
+
+#include <spla/schedule.hpp>
+
+#include <schedule/schedule_future.hpp>
+
+#include <svector.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class ScheduleThreadPool
+     * @brief Schedule executing tasks of each step concurrently on a pool of threads
+     *
+     * Worker threads are started on first submit and live until schedule is released.
+     * Calling thread participates in execution of tasks, so pool starts `workers - 1` threads.
+     * Steps are separated by a barrier: next step starts only when all tasks of current one finished.
+     */
+    class ScheduleThreadPool final : public Schedule {
+    public:
+        explicit ScheduleThreadPool(uint workers_count);
+        ~ScheduleThreadPool() override;
+        Status                  step_task(ref_ptr<ScheduleTask> task) override;
+        Status                  step_tasks(std::vector<ref_ptr<ScheduleTask>> tasks) override;
+        Status                  submit() override;
+        ref_ptr<ScheduleFuture> submit_async() override;
+        Status                  get_task_status(int step_id, int task_id) override;
+        void                    set_label(std::string label) override;
+        const std::string&      get_label() const override;
+
+    private:
+        void start_workers();
+        void run_step(int step_id);
+        void run_tasks(uint thread_id, int step_id, int n_tasks, std::uint32_t generation);
+        void run_task(uint thread_id, int step_id, int task_id);
+        void worker_main(uint thread_id);
+
+    private:
+        using vector_step  = ankerl::svector<ref_ptr<ScheduleTask>, 4>;
+        using vector_steps = ankerl::svector<vector_step, 4>;
+
+        vector_steps                     m_steps;
+        std::vector<std::vector<Status>> m_statuses;
+        std::string                      m_label;
+        ref_ptr<ScheduleFutureImpl>      m_last_future;
+        uint                             m_workers_count;
+
+        std::vector<std::thread>   m_workers;
+        std::mutex                 m_mutex;
+        std::condition_variable    m_cv_work;
+        std::condition_variable    m_cv_done;
+        std::uint32_t              m_generation = 0;
+        bool                       m_stop       = false;
+        int                        m_step_id    = 0;
+        int                        m_step_tasks = 0;
+        int                        m_pending    = 0;
+        std::atomic<std::uint64_t> m_next_task{0};
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_SCHEDULE_TP_HPP
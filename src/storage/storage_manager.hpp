@@ -29,12 +29,20 @@
 #define SPLA_STORAGE_MANAGER_HPP
 
 #include <spla/config.hpp>
+#include <spla/library.hpp>
 
+#include <core/logger.hpp>
 #include <core/tdecoration.hpp>
+#include <storage/storage_residency.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <mutex>
 #include <queue>
+#include <sstream>
 #include <utility>
 #include <vector>
 
@@ -45,6 +53,25 @@ namespace spla {
      * @{
      */
 
+    /**
+     * @class StorageConvertCost
+     * @brief Estimated cost of a format conversion, measured in bytes of memory traffic
+     *
+     * Extra cost per value accounts for work which is slower than plain copy,
+     * such as hash table inserts or transfer to device. Fixed cost makes paths
+     * with fewer hops preferable for empty or tiny storages.
+     */
+    struct StorageConvertCost {
+        float per_value       = 0.0f;
+        float extra_per_value = 0.0f;
+        float per_row         = 0.0f;
+        float fixed           = 1.0f;
+
+        [[nodiscard]] double get(uint n_values, uint n_rows) const {
+            return double(fixed) + double(n_values) * double(per_value + extra_per_value) + double(n_rows) * double(per_row);
+        }
+    };
+
     /**
      * @class StorageManager
      * @brief General format converter for vector or matrix decoration storage
@@ -66,18 +93,27 @@ namespace spla {
         void register_discard(F format, Function function);
         void register_validator_discard(F format, Function function);
         void register_converter(F from, F to, Function function);
+        void register_converter(F from, F to, StorageConvertCost cost, Function function);
 
         void validate_ctor(F format, Storage& storage);
         void validate_rw(F format, Storage& storage);
         void validate_rwd(F format, Storage& storage);
         void validate_wd(F format, Storage& storage);
 
+        static void release_usage(Storage& storage);
+
     private:
+        void convert(F format, Storage& storage);
+        void update_residency(F format, Storage& storage);
+
         std::vector<std::vector<std::pair<int, int>>> m_convert_rules;
         std::vector<Function>                         m_constructors;
         std::vector<Function>                         m_validators;
         std::vector<Function>                         m_discards;
         std::vector<Function>                         m_converters;
+        std::vector<StorageConvertCost>               m_converters_cost;
+        std::vector<std::uint64_t>                    m_logged_paths;
+        std::mutex                                    m_logged_mutex;
     };
 
     template<typename T, typename F, int capacity>
@@ -86,6 +122,7 @@ namespace spla {
         m_constructors.resize(capacity);
         m_validators.resize(capacity);
         m_discards.resize(capacity);
+        m_logged_paths.resize(capacity * capacity, 0);
     }
 
     template<typename T, typename F, int capacity>
@@ -110,15 +147,21 @@ namespace spla {
     }
     template<typename T, typename F, int capacity>
     void StorageManager<T, F, capacity>::register_converter(F from, F to, StorageManager::Function function) {
+        register_converter(from, to, StorageConvertCost(), std::move(function));
+    }
+    template<typename T, typename F, int capacity>
+    void StorageManager<T, F, capacity>::register_converter(F from, F to, StorageConvertCost cost, StorageManager::Function function) {
         const int i  = static_cast<int>(from);
         const int j  = static_cast<int>(to);
         const int id = static_cast<int>(m_converters.size());
         m_convert_rules[i].push_back({j, id});
         m_converters.push_back(std::move(function));
+        m_converters_cost.push_back(cost);
     }
 
     template<typename T, typename F, int capacity>
     void StorageManager<T, F, capacity>::validate_ctor(F format, Storage& storage) {
+        std::lock_guard<std::mutex> lock(storage.get_mutex());
         const int i = static_cast<int>(format);
         if (!storage.get_ptr_i(i)) {
             m_constructors[i](storage);
@@ -126,6 +169,42 @@ namespace spla {
     }
     template<typename T, typename F, int capacity>
     void StorageManager<T, F, capacity>::validate_rw(F format, Storage& storage) {
+        std::lock_guard<std::mutex> lock(storage.get_mutex());
+        convert(format, storage);
+        update_residency(format, storage);
+    }
+    template<typename T, typename F, int capacity>
+    void StorageManager<T, F, capacity>::validate_rwd(F format, Storage& storage) {
+        std::lock_guard<std::mutex> lock(storage.get_mutex());
+        convert(format, storage);
+        storage.invalidate();
+        storage.validate(format);
+        update_residency(format, storage);
+    }
+    template<typename T, typename F, int capacity>
+    void StorageManager<T, F, capacity>::validate_wd(F format, Storage& storage) {
+        std::lock_guard<std::mutex> lock(storage.get_mutex());
+        const int i = static_cast<int>(format);
+        if (!storage.get_ptr_i(i)) {
+            m_constructors[i](storage);
+        }
+        if (m_discards[i]) {
+            m_discards[i](storage);
+        }
+        storage.invalidate();
+        storage.validate(format);
+        update_residency(format, storage);
+    }
+    template<typename T, typename F, int capacity>
+    void StorageManager<T, F, capacity>::release_usage(Storage& storage) {
+        if (storage.get_memory_accounted() > 0) {
+            storage.get_residency()->update_usage(storage.get_memory_accounted(), 0);
+            storage.set_memory_accounted(0);
+        }
+    }
+
+    template<typename T, typename F, int capacity>
+    void StorageManager<T, F, capacity>::convert(F format, Storage& storage) {
         if (storage.is_valid(format)) {
             return;
         }
@@ -146,79 +225,167 @@ namespace spla {
             return;
         }
 
-        const int source   = -1;
-        const int infinity = -2;
-        const int target   = static_cast<int>(format);
-
-        std::array<int, capacity> reached;
-        std::queue<int>           queue;
-        reached.fill(infinity);
+        const int    source   = -1;
+        const int    target   = static_cast<int>(format);
+        const double infinity = std::numeric_limits<double>::infinity();
 
         assert(storage.is_valid_any());
 
+        // all valid formats hold the same data, take the largest reported count of values
+        uint n_values = 0;
         for (int i = 0; i < capacity; ++i) {
             if (storage.is_valid_i(i)) {
-                reached[i] = source;
-                queue.push(i);
+                n_values = std::max(n_values, storage.get_ptr_i(i)->get_n_values());
             }
         }
 
-        while (reached[target] == infinity) {
-            if (queue.empty()) {
-                LOG_MSG(Status::NotImplemented, "no conversion path to target format " << target);
-                assert(false);
-                return;
+        using QueueEntry = std::pair<double, int>;
+
+        std::array<double, capacity>                                             cost;
+        std::array<int, capacity>                                                reached_from;
+        std::array<int, capacity>                                                reached_by;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+
+        cost.fill(infinity);
+        reached_from.fill(source);
+        reached_by.fill(source);
+
+        for (int i = 0; i < capacity; ++i) {
+            if (storage.is_valid_i(i)) {
+                cost[i] = 0.0;
+                queue.push({0.0, i});
             }
+        }
 
-            int u = queue.front();
+        while (!queue.empty()) {
+            const auto [u_cost, u] = queue.top();
             queue.pop();
 
-            for (const auto& target_format : m_convert_rules[u]) {
-                if (reached[target_format.first] == infinity) {
-                    reached[target_format.first] = u;
-                    queue.push(target_format.first);
+            if (u == target) break;
+            if (u_cost > cost[u]) continue;
+
+            for (const auto& rule : m_convert_rules[u]) {
+                const int    v      = rule.first;
+                const double v_cost = u_cost + m_converters_cost[rule.second].get(n_values, storage.get_n_rows());
+
+                if (v_cost < cost[v]) {
+                    cost[v]         = v_cost;
+                    reached_from[v] = u;
+                    reached_by[v]   = rule.second;
+                    queue.push({v_cost, v});
                 }
             }
         }
 
-        std::vector<std::pair<int, int>> path;
-        int                              current = target;
+        if (cost[target] == infinity) {
+            LOG_MSG(Status::NotImplemented, "no conversion path to target format " << target);
+            assert(false);
+            return;
+        }
 
-        while (reached[current] != source) {
-            path.push_back({reached[current], current});
-            current = reached[current];
+        std::vector<int> path;
+        for (int current = target; reached_from[current] != source; current = reached_from[current]) {
+            path.push_back(current);
         }
+        std::reverse(path.begin(), path.end());
 
-        for (auto iter = path.rbegin(); iter != path.rend(); ++iter) {
-            std::pair<int, int> from_to          = *iter;
-            auto                search_predicate = [from_to](const std::pair<int, int>& rule) { return rule.first == from_to.second; };
-            auto                rule             = std::find_if(m_convert_rules[from_to.first].begin(), m_convert_rules[from_to.first].end(), search_predicate);
+#ifndef SPLA_RELEASE
+        // decision is logged once per pair of formats and power of two class of storage size
+        const int from       = reached_from[path.front()];
+        int       size_class = 0;
+        bool      first_time = false;
+        while (size_class < 32 && (n_values >> size_class) != 0) size_class += 1;
+        {
+            std::lock_guard<std::mutex> lock(m_logged_mutex);
+            std::uint64_t&              logged = m_logged_paths[from * capacity + target];
+            first_time                         = !(logged & (std::uint64_t(1) << size_class));
+            logged |= std::uint64_t(1) << size_class;
+        }
+        if (first_time) {
+            std::stringstream path_str;
+            path_str << from;
+            for (const int step : path) {
+                path_str << "->" << step;
+            }
+            LOG_MSG(Status::Ok, "convert path " << path_str.str() << " values " << n_values << " cost " << cost[target]);
+        }
+#endif
 
-            if (storage.get_ref_i(from_to.second).is_null()) {
-                m_constructors[from_to.second](storage);
+        for (const int step : path) {
+            if (storage.get_ref_i(step).is_null()) {
+                m_constructors[step](storage);
             }
 
-            m_converters[rule->second](storage);
-            storage.validate(static_cast<F>(from_to.second));
+            m_converters[reached_by[step]](storage);
+            storage.validate(static_cast<F>(step));
         }
     }
     template<typename T, typename F, int capacity>
-    void StorageManager<T, F, capacity>::validate_rwd(F format, Storage& storage) {
-        validate_rw(format, storage);
-        storage.invalidate();
-        storage.validate(format);
-    }
-    template<typename T, typename F, int capacity>
-    void StorageManager<T, F, capacity>::validate_wd(F format, Storage& storage) {
-        const int i = static_cast<int>(format);
-        if (!storage.get_ptr_i(i)) {
-            m_constructors[i](storage);
+    void StorageManager<T, F, capacity>::update_residency(F format, Storage& storage) {
+        StorageResidency*  residency = Library::get()->get_storage_residency();
+        const FormatPolicy policy    = residency->get_policy();
+
+        // default policy evicts nothing, so no bookkeeping is done on validation of formats
+        if (policy == FormatPolicy::KeepAll) {
+            return;
         }
-        if (m_discards[i]) {
-            m_discards[i](storage);
+
+        const int           target    = static_cast<int>(format);
+        const std::uint64_t epoch     = residency->get_epoch();
+        const uint          in_flight = residency->get_tasks_in_flight();
+
+        storage.touch_i(target, epoch);
+
+        // Kernel of a running task may still hold pointers to formats it has touched,
+        // and with concurrent tasks there is no way to tell, whose formats are in use
+        auto can_evict = [&](int i) {
+            return i != target && storage.get_ptr_i(i) &&
+                   (in_flight == 0 || (in_flight == 1 && storage.get_last_epoch_i(i) != epoch));
+        };
+        auto evict = [&](int i) {
+            storage.invalidate_i(i);
+            storage.get_ptr_i(i)->release();
+        };
+
+        for (int i = 0; i < capacity; ++i) {
+            if (can_evict(i) && (policy == FormatPolicy::KeepOne || !storage.is_valid_i(i))) {
+                evict(i);
+            }
         }
-        storage.invalidate();
-        storage.validate(format);
+
+        std::size_t usage = storage.get_memory_usage();
+
+        if (policy == FormatPolicy::Budgeted) {
+            const std::size_t object_budget = storage.get_memory_budget();
+            const std::size_t global_budget = residency->get_budget();
+            const std::size_t global_usage  = residency->get_usage();
+            const std::size_t others_usage  = global_usage - std::min(global_usage, storage.get_memory_accounted());
+
+            while ((object_budget > 0 && usage > object_budget) ||
+                   (global_budget > 0 && others_usage + usage > global_budget)) {
+                int victim = -1;
+                for (int i = 0; i < capacity; ++i) {
+                    if (can_evict(i) && storage.is_valid_i(i) &&
+                        (victim == -1 || storage.get_last_used_i(i) < storage.get_last_used_i(victim))) {
+                        victim = i;
+                    }
+                }
+                if (victim == -1) {
+                    break;
+                }
+
+                LOG_MSG(Status::Ok, "evict format " << victim << " bytes " << storage.get_ptr_i(victim)->get_memory_usage());
+                evict(victim);
+                usage = storage.get_memory_usage();
+            }
+        }
+
+        if (!storage.get_residency()) {
+            storage.set_residency(residency->shared_from_this());
+        }
+
+        residency->update_usage(storage.get_memory_accounted(), usage);
+        storage.set_memory_accounted(usage);
     }
 
     /**
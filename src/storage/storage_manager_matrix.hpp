@@ -31,6 +31,7 @@
 #include <storage/storage_manager.hpp>
 
 #include <cpu/cpu_format_coo.hpp>
+#include <cpu/cpu_format_csc.hpp>
 #include <cpu/cpu_format_csr.hpp>
 #include <cpu/cpu_format_dok.hpp>
 #include <cpu/cpu_format_lil.hpp>
@@ -51,6 +52,12 @@ namespace spla {
     void register_formats_matrix(StorageManagerMatrix<T>& manager) {
         using Storage = typename StorageManagerMatrix<T>::Storage;
 
+        // costs of conversions in bytes moved, see StorageConvertCost
+        constexpr float I    = sizeof(uint);
+        constexpr float V    = sizeof(T);
+        constexpr float ROW  = sizeof(typename CpuLil<T>::Row);
+        constexpr float HASH = 64.0f;
+
         manager.register_constructor(FormatMatrix::CpuLil, [](Storage& s) {
             s.get_ref(FormatMatrix::CpuLil) = make_ref<CpuLil<T>>();
         });
@@ -63,6 +70,9 @@ namespace spla {
         manager.register_constructor(FormatMatrix::CpuCsr, [](Storage& s) {
             s.get_ref(FormatMatrix::CpuCsr) = make_ref<CpuCsr<T>>();
         });
+        manager.register_constructor(FormatMatrix::CpuCsc, [](Storage& s) {
+            s.get_ref(FormatMatrix::CpuCsc) = make_ref<CpuCsc<T>>();
+        });
 
         manager.register_validator_discard(FormatMatrix::CpuLil, [](Storage& s) {
             auto* lil = s.template get<CpuLil<T>>();
@@ -77,71 +87,106 @@ namespace spla {
             auto* coo = s.template get<CpuCoo<T>>();
             cpu_coo_clear(*coo);
         });
+        manager.register_validator_discard(FormatMatrix::CpuCsr, [](Storage& s) {
+            auto* csr = s.template get<CpuCsr<T>>();
+            cpu_csr_clear(s.get_n_rows(), *csr);
+        });
+        manager.register_validator_discard(FormatMatrix::CpuCsc, [](Storage& s) {
+            auto* csc = s.template get<CpuCsc<T>>();
+            cpu_csc_clear(s.get_n_cols(), *csc);
+        });
 
-        manager.register_converter(FormatMatrix::CpuLil, FormatMatrix::CpuDok, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuLil, FormatMatrix::CpuDok, StorageConvertCost{I + V, HASH, ROW}, [](Storage& s) {
             auto* lil = s.template get<CpuLil<T>>();
             auto* dok = s.template get<CpuDok<T>>();
             cpu_dok_clear(*dok);
             cpu_lil_to_dok(s.get_n_rows(), *lil, *dok);
         });
-        manager.register_converter(FormatMatrix::CpuLil, FormatMatrix::CpuCoo, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuLil, FormatMatrix::CpuCoo, StorageConvertCost{3 * I + 2 * V, 0, ROW}, [](Storage& s) {
             auto* lil = s.template get<CpuLil<T>>();
             auto* coo = s.template get<CpuCoo<T>>();
             cpu_coo_resize(lil->values, *coo);
             cpu_lil_to_coo(s.get_n_rows(), *lil, *coo);
         });
-        manager.register_converter(FormatMatrix::CpuLil, FormatMatrix::CpuCsr, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuLil, FormatMatrix::CpuCsr, StorageConvertCost{2 * I + 2 * V, 0, ROW + I}, [](Storage& s) {
             auto* lil = s.template get<CpuLil<T>>();
             auto* csr = s.template get<CpuCsr<T>>();
             cpu_csr_resize(s.get_n_rows(), lil->values, *csr);
             cpu_lil_to_csr(s.get_n_rows(), *lil, *csr);
         });
+        manager.register_converter(FormatMatrix::CpuLil, FormatMatrix::CpuCsc, StorageConvertCost{3 * I + 2 * V, I, ROW}, [](Storage& s) {
+            auto* lil = s.template get<CpuLil<T>>();
+            auto* csc = s.template get<CpuCsc<T>>();
+            cpu_csc_resize(s.get_n_cols(), lil->values, *csc);
+            cpu_lil_to_csc(s.get_n_rows(), s.get_n_cols(), *lil, *csc);
+        });
 
-        manager.register_converter(FormatMatrix::CpuCoo, FormatMatrix::CpuLil, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuCoo, FormatMatrix::CpuLil, StorageConvertCost{3 * I + 2 * V, I, ROW}, [](Storage& s) {
             auto* coo = s.template get<CpuCoo<T>>();
             auto* lil = s.template get<CpuLil<T>>();
             cpu_lil_clear(*lil);
             cpu_lil_resize(s.get_n_rows(), *lil);
             cpu_coo_to_lil(s.get_n_rows(), *coo, *lil);
         });
-        manager.register_converter(FormatMatrix::CpuCoo, FormatMatrix::CpuDok, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuCoo, FormatMatrix::CpuDok, StorageConvertCost{2 * I + V, HASH, 0}, [](Storage& s) {
             auto* coo = s.template get<CpuCoo<T>>();
             auto* dok = s.template get<CpuDok<T>>();
             cpu_dok_clear(*dok);
             cpu_coo_to_dok(*coo, *dok);
         });
-        manager.register_converter(FormatMatrix::CpuCoo, FormatMatrix::CpuCsr, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuCoo, FormatMatrix::CpuCsr, StorageConvertCost{3 * I + 2 * V, 0, I}, [](Storage& s) {
             auto* coo = s.template get<CpuCoo<T>>();
             auto* csr = s.template get<CpuCsr<T>>();
             cpu_csr_resize(s.get_n_rows(), coo->values, *csr);
             cpu_coo_to_csr(s.get_n_rows(), *coo, *csr);
         });
+        manager.register_converter(FormatMatrix::CpuCoo, FormatMatrix::CpuCsc, StorageConvertCost{4 * I + 2 * V, I, 0}, [](Storage& s) {
+            auto* coo = s.template get<CpuCoo<T>>();
+            auto* csc = s.template get<CpuCsc<T>>();
+            cpu_csc_resize(s.get_n_cols(), coo->values, *csc);
+            cpu_coo_to_csc(s.get_n_cols(), *coo, *csc);
+        });
 
-        manager.register_converter(FormatMatrix::CpuCsr, FormatMatrix::CpuDok, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuCsr, FormatMatrix::CpuDok, StorageConvertCost{I + V, HASH, I}, [](Storage& s) {
             auto* csr = s.template get<CpuCsr<T>>();
             auto* dok = s.template get<CpuDok<T>>();
             cpu_dok_clear(*dok);
             cpu_csr_to_dok(s.get_n_rows(), *csr, *dok);
         });
-        manager.register_converter(FormatMatrix::CpuCsr, FormatMatrix::CpuCoo, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuCsr, FormatMatrix::CpuCoo, StorageConvertCost{3 * I + 2 * V, 0, I}, [](Storage& s) {
             auto* csr = s.template get<CpuCsr<T>>();
             auto* coo = s.template get<CpuCoo<T>>();
             cpu_coo_resize(csr->values, *coo);
             cpu_csr_to_coo(s.get_n_rows(), *csr, *coo);
         });
+        manager.register_converter(FormatMatrix::CpuCsr, FormatMatrix::CpuCsc, StorageConvertCost{3 * I + 2 * V, I, I}, [](Storage& s) {
+            auto* csr = s.template get<CpuCsr<T>>();
+            auto* csc = s.template get<CpuCsc<T>>();
+            cpu_csc_resize(s.get_n_cols(), csr->values, *csc);
+            cpu_csr_to_csc(s.get_n_rows(), s.get_n_cols(), *csr, *csc);
+        });
+
+        manager.register_converter(FormatMatrix::CpuCsc, FormatMatrix::CpuCsr, StorageConvertCost{3 * I + 2 * V, I, 0}, [](Storage& s) {
+            auto* csc = s.template get<CpuCsc<T>>();
+            auto* csr = s.template get<CpuCsr<T>>();
+            cpu_csr_resize(s.get_n_rows(), csc->values, *csr);
+            cpu_csc_to_csr(s.get_n_rows(), s.get_n_cols(), *csc, *csr);
+        });
 
 #if defined(SPLA_BUILD_OPENCL)
+        constexpr float DEVICE = 32.0f;
+
         manager.register_constructor(FormatMatrix::AccCsr, [](Storage& s) {
             s.get_ref(FormatMatrix::AccCsr) = make_ref<CLCsr<T>>();
         });
 
-        manager.register_converter(FormatMatrix::CpuCsr, FormatMatrix::AccCsr, [](Storage& s) {
+        manager.register_converter(FormatMatrix::CpuCsr, FormatMatrix::AccCsr, StorageConvertCost{I + V, DEVICE, I}, [](Storage& s) {
             auto* cpu_csr = s.template get<CpuCsr<T>>();
             auto* cl_csr  = s.template get<CLCsr<T>>();
             cl_csr_init(s.get_n_rows(), cpu_csr->values, cpu_csr->Ap.data(), cpu_csr->Aj.data(), cpu_csr->Ax.data(), *cl_csr);
         });
 
-        manager.register_converter(FormatMatrix::AccCsr, FormatMatrix::CpuCsr, [](Storage& s) {
+        manager.register_converter(FormatMatrix::AccCsr, FormatMatrix::CpuCsr, StorageConvertCost{I + V, DEVICE, I}, [](Storage& s) {
             auto* cl_acc  = get_acc_cl();
             auto* cl_csr  = s.template get<CLCsr<T>>();
             auto* cpu_csr = s.template get<CpuCsr<T>>();
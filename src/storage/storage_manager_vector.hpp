@@ -51,6 +51,11 @@ namespace spla {
     void register_formats_vector(StorageManagerVector<T>& manager) {
         using Storage = typename StorageManagerVector<T>::Storage;
 
+        // costs of conversions in bytes moved, see StorageConvertCost
+        constexpr float I    = sizeof(uint);
+        constexpr float V    = sizeof(T);
+        constexpr float HASH = 64.0f;
+
         manager.register_constructor(FormatVector::CpuDok, [](Storage& s) {
             s.get_ref(FormatVector::CpuDok) = make_ref<CpuDokVec<T>>();
         });
@@ -72,33 +77,47 @@ namespace spla {
             cpu_dense_vec_fill(s.get_fill_value(), *s.template get<CpuDenseVec<T>>());
         });
 
-        manager.register_converter(FormatVector::CpuDok, FormatVector::CpuCoo, [](Storage& s) {
+        manager.register_converter(FormatVector::CpuDok, FormatVector::CpuCoo, StorageConvertCost{2 * I + 2 * V, HASH, 0}, [](Storage& s) {
             auto* dok = s.template get<CpuDokVec<T>>();
             auto* coo = s.template get<CpuCooVec<T>>();
             cpu_coo_vec_resize(dok->values, *coo);
             cpu_dok_vec_to_coo(*dok, *coo);
         });
-        manager.register_converter(FormatVector::CpuDok, FormatVector::CpuDense, [](Storage& s) {
+        manager.register_converter(FormatVector::CpuDok, FormatVector::CpuDense, StorageConvertCost{I + 2 * V, HASH, V}, [](Storage& s) {
             auto* dok   = s.template get<CpuDokVec<T>>();
             auto* dense = s.template get<CpuDenseVec<T>>();
             cpu_dense_vec_fill(s.get_fill_value(), *dense);
             cpu_dok_vec_to_dense(s.get_n_rows(), *dok, *dense);
         });
-        manager.register_converter(FormatVector::CpuCoo, FormatVector::CpuDok, [](Storage& s) {
+        manager.register_converter(FormatVector::CpuCoo, FormatVector::CpuDok, StorageConvertCost{I + V, HASH, 0}, [](Storage& s) {
             auto* coo = s.template get<CpuCooVec<T>>();
             auto* dok = s.template get<CpuDokVec<T>>();
             cpu_dok_vec_clear(*dok);
             cpu_coo_vec_to_dok(*coo, *dok);
         });
-        manager.register_converter(FormatVector::CpuDense, FormatVector::CpuDok, [](Storage& s) {
+        manager.register_converter(FormatVector::CpuDense, FormatVector::CpuDok, StorageConvertCost{0, HASH, V}, [](Storage& s) {
             auto* dense = s.template get<CpuDenseVec<T>>();
             auto* dok   = s.template get<CpuDokVec<T>>();
             cpu_dok_vec_clear(*dok);
             cpu_dense_vec_to_dok(s.get_n_rows(), s.get_fill_value(), *dense, *dok);
         });
+        manager.register_converter(FormatVector::CpuCoo, FormatVector::CpuDense, StorageConvertCost{I + 2 * V, 0, V}, [](Storage& s) {
+            auto* coo   = s.template get<CpuCooVec<T>>();
+            auto* dense = s.template get<CpuDenseVec<T>>();
+            cpu_dense_vec_fill(s.get_fill_value(), *dense);
+            cpu_coo_vec_to_dense(*coo, *dense);
+        });
+        manager.register_converter(FormatVector::CpuDense, FormatVector::CpuCoo, StorageConvertCost{I + V, 0, V}, [](Storage& s) {
+            auto* dense = s.template get<CpuDenseVec<T>>();
+            auto* coo   = s.template get<CpuCooVec<T>>();
+            cpu_coo_vec_clear(*coo);
+            cpu_dense_vec_to_coo(s.get_n_rows(), s.get_fill_value(), *dense, *coo);
+        });
 
 
 #if defined(SPLA_BUILD_OPENCL)
+        constexpr float DEVICE = 32.0f;
+
         manager.register_constructor(FormatVector::AccCoo, [](Storage& s) {
             s.get_ref(FormatVector::AccCoo) = make_ref<CLCooVec<T>>();
         });
@@ -117,12 +136,12 @@ namespace spla {
             cl_dense_vec_fill_value(s.get_n_rows(), s.get_fill_value(), *cl_dense);
         });
 
-        manager.register_converter(FormatVector::CpuDense, FormatVector::AccDense, [](Storage& s) {
+        manager.register_converter(FormatVector::CpuDense, FormatVector::AccDense, StorageConvertCost{0, 0, V + DEVICE}, [](Storage& s) {
             auto* cpu_dense = s.template get<CpuDenseVec<T>>();
             auto* cl_dense  = s.template get<CLDenseVec<T>>();
             cl_dense_vec_init(s.get_n_rows(), cpu_dense->Ax.data(), *cl_dense);
         });
-        manager.register_converter(FormatVector::AccDense, FormatVector::CpuDense, [](Storage& s) {
+        manager.register_converter(FormatVector::AccDense, FormatVector::CpuDense, StorageConvertCost{0, 0, V + DEVICE}, [](Storage& s) {
             auto* cl_acc    = get_acc_cl();
             auto* cl_dense  = s.template get<CLDenseVec<T>>();
             auto* cpu_dense = s.template get<CpuDenseVec<T>>();
@@ -136,12 +155,12 @@ namespace spla {
                                   CL_MEM_HOST_READ_ONLY | CL_MEM_ALLOC_HOST_PTR);
             }
         });
-        manager.register_converter(FormatVector::CpuCoo, FormatVector::AccCoo, [](Storage& s) {
+        manager.register_converter(FormatVector::CpuCoo, FormatVector::AccCoo, StorageConvertCost{I + V, DEVICE, 0}, [](Storage& s) {
             auto* cpu_coo = s.template get<CpuCooVec<T>>();
             auto* cl_coo  = s.template get<CLCooVec<T>>();
             cl_coo_vec_init(cpu_coo->values, cpu_coo->Ai.data(), cpu_coo->Ax.data(), *cl_coo);
         });
-        manager.register_converter(FormatVector::AccCoo, FormatVector::CpuCoo, [](Storage& s) {
+        manager.register_converter(FormatVector::AccCoo, FormatVector::CpuCoo, StorageConvertCost{I + V, DEVICE, 0}, [](Storage& s) {
             auto* cl_acc  = get_acc_cl();
             auto* cl_coo  = s.template get<CLCooVec<T>>();
             auto* cpu_coo = s.template get<CpuCooVec<T>>();
@@ -156,13 +175,13 @@ namespace spla {
                                 CL_MEM_HOST_READ_ONLY | CL_MEM_ALLOC_HOST_PTR);
             }
         });
-        manager.register_converter(FormatVector::AccCoo, FormatVector::AccDense, [](Storage& s) {
+        manager.register_converter(FormatVector::AccCoo, FormatVector::AccDense, StorageConvertCost{I + V, 0, V}, [](Storage& s) {
             auto* cl_acc   = get_acc_cl();
             auto* cl_coo   = s.template get<CLCooVec<T>>();
             auto* cl_dense = s.template get<CLDenseVec<T>>();
             cl_coo_vec_to_dense(s.get_n_rows(), s.get_fill_value(), *cl_coo, *cl_dense, cl_acc->get_queue_default());
         });
-        manager.register_converter(FormatVector::AccDense, FormatVector::AccCoo, [](Storage& s) {
+        manager.register_converter(FormatVector::AccDense, FormatVector::AccCoo, StorageConvertCost{I + V, 0, V}, [](Storage& s) {
             auto* cl_acc   = get_acc_cl();
             auto* cl_dense = s.template get<CLDenseVec<T>>();
             auto* cl_coo   = s.template get<CLCooVec<T>>();
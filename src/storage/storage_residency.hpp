@@ -0,0 +1,110 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_STORAGE_RESIDENCY_HPP
+#define SPLA_STORAGE_RESIDENCY_HPP
+
+#include <spla/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class StorageResidency
+     * @brief Global state of storage formats residency in memory
+     *
+     * Tracks selected format policy, memory budget and total memory held by formats
+     * of all objects. Also counts dispatched tasks, so storage of an object knows,
+     * which of its formats may be in use by a running kernel and can not be evicted.
+     * Storages with accounted memory share ownership of residency, so objects released
+     * after the library still return their usage without access to the library.
+     */
+    class StorageResidency : public std::enable_shared_from_this<StorageResidency> {
+    public:
+        void         set_policy(FormatPolicy policy) { m_policy.store(policy); }
+        FormatPolicy get_policy() const { return m_policy.load(); }
+
+        void        set_budget(std::size_t bytes) { m_budget.store(bytes); }
+        std::size_t get_budget() const { return m_budget.load(); }
+
+        void update_usage(std::size_t old_bytes, std::size_t new_bytes) {
+            if (new_bytes > old_bytes) m_usage.fetch_add(new_bytes - old_bytes);
+            if (new_bytes < old_bytes) m_usage.fetch_sub(old_bytes - new_bytes);
+        }
+        std::size_t get_usage() const { return m_usage.load(); }
+
+        void begin_task() {
+            m_epoch.fetch_add(1);
+            m_tasks_in_flight.fetch_add(1);
+        }
+        void end_task() { m_tasks_in_flight.fetch_sub(1); }
+
+        /** @return Id of the most recently started task */
+        std::uint64_t get_epoch() const { return m_epoch.load(); }
+        /** @return Number of currently executed tasks */
+        uint get_tasks_in_flight() const { return m_tasks_in_flight.load(); }
+
+    private:
+        std::atomic<FormatPolicy>  m_policy{FormatPolicy::KeepAll};
+        std::atomic<std::size_t>   m_budget{0};
+        std::atomic<std::size_t>   m_usage{0};
+        std::atomic<std::uint64_t> m_epoch{0};
+        std::atomic<uint>          m_tasks_in_flight{0};
+    };
+
+    /**
+     * @class StorageResidencyTaskScope
+     * @brief Marks scope of a task execution for residency tracking
+     */
+    class StorageResidencyTaskScope {
+    public:
+        explicit StorageResidencyTaskScope(StorageResidency* residency) : m_residency(residency) { m_residency->begin_task(); }
+        ~StorageResidencyTaskScope() { m_residency->end_task(); }
+
+        StorageResidencyTaskScope(const StorageResidencyTaskScope&) = delete;
+        StorageResidencyTaskScope& operator=(const StorageResidencyTaskScope&) = delete;
+
+    private:
+        StorageResidency* m_residency;
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_STORAGE_RESIDENCY_HPP
@@ -0,0 +1,140 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "mapped_file.hpp"
+
+#include <fstream>
+
+#if defined(SPLA_TARGET_WINDOWS)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace spla {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    bool MappedFile::open(const std::filesystem::path& file_path) {
+        close();
+
+#if defined(SPLA_TARGET_WINDOWS)
+        HANDLE file = CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file != INVALID_HANDLE_VALUE) {
+            LARGE_INTEGER file_size;
+            if (GetFileSizeEx(file, &file_size) && file_size.QuadPart == 0) {
+                CloseHandle(file);
+                m_is_open = true;
+                return true;
+            }
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void*  view    = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (view) {
+                m_file    = file;
+                m_mapping = mapping;
+                m_data    = static_cast<const char*>(view);
+                m_size    = std::size_t(file_size.QuadPart);
+                m_mapped  = true;
+                m_is_open = true;
+                return true;
+            }
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+        }
+#else
+        const int fd = ::open(file_path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat file_stat {};
+            const bool        has_size  = fstat(fd, &file_stat) == 0;
+            const std::size_t file_size = has_size ? std::size_t(file_stat.st_size) : 0;
+            void*             view      = has_size && file_size > 0 ? mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+            ::close(fd);
+
+            if (has_size && file_size == 0) {
+                m_is_open = true;
+                return true;
+            }
+            if (view != MAP_FAILED) {
+    #if defined(MADV_SEQUENTIAL)
+                madvise(view, file_size, MADV_SEQUENTIAL);
+    #endif
+                m_data    = static_cast<const char*>(view);
+                m_size    = file_size;
+                m_mapped  = true;
+                m_is_open = true;
+                return true;
+            }
+        }
+#endif
+
+        // mapping is not supported for the file, read it as usual
+        std::ifstream file(file_path, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        file.seekg(0, std::ios::end);
+        m_buffer.resize(std::size_t(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(m_buffer.data(), std::streamsize(m_buffer.size()));
+
+        m_data    = m_buffer.data();
+        m_size    = m_buffer.size();
+        m_is_open = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (m_mapped) {
+#if defined(SPLA_TARGET_WINDOWS)
+            UnmapViewOfFile(m_data);
+            CloseHandle(static_cast<HANDLE>(m_mapping));
+            CloseHandle(static_cast<HANDLE>(m_file));
+            m_file    = nullptr;
+            m_mapping = nullptr;
+#else
+            munmap(const_cast<char*>(m_data), m_size);
+#endif
+        }
+
+        m_buffer.clear();
+        m_buffer.shrink_to_fit();
+        m_data    = nullptr;
+        m_size    = 0;
+        m_is_open = false;
+        m_mapped  = false;
+    }
+
+}// namespace spla
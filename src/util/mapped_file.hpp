@@ -0,0 +1,85 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_MAPPED_FILE_HPP
+#define SPLA_MAPPED_FILE_HPP
+
+#include <spla/config.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class MappedFile
+     * @brief Read-only view of whole file content mapped into memory
+     *
+     * Uses memory mapping provided by the OS, so pages are loaded lazily
+     * and may be read concurrently by many threads. If mapping is not
+     * possible, falls back to reading of file into memory buffer.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::filesystem::path& file_path);
+        void close();
+
+        [[nodiscard]] const char* data() const { return m_data; }
+        [[nodiscard]] std::size_t size() const { return m_size; }
+        [[nodiscard]] bool        is_open() const { return m_is_open; }
+
+    private:
+        const char*       m_data    = nullptr;
+        std::size_t       m_size    = 0;
+        bool              m_is_open = false;
+        bool              m_mapped  = false;
+        std::vector<char> m_buffer;
+#if defined(SPLA_TARGET_WINDOWS)
+        void* m_file    = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_MAPPED_FILE_HPP
@@ -0,0 +1,121 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+
+#include "test_common.hpp"
+
+#include <spla.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+static std::string write_test_mtx(const std::string& name, const std::string& text) {
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream(path) << text;
+    return path;
+}
+
+static const char* TEST_MTX =
+        "%%MatrixMarket matrix coordinate pattern general\n"
+        "% comment\n"
+        "4 4 10\n"
+        "1 2\n"
+        "2 3\n"
+        "2 3\n"
+        "3 3\n"
+        "4 1\n"
+        "abc 2\n"
+        "0 1\n"
+        "5 1\n"
+        "18446744073709551617 1\n"
+        "1 99999999999999999999999\n";
+
+TEST(io, offset_remove_loops) {
+    const auto path = write_test_mtx("spla_test_io_0.mtx", TEST_MTX);
+
+    spla::MtxLoader loader;
+    EXPECT_TRUE(loader.load(path, true, false, true));
+
+    const std::vector<spla::uint> Ai = {0, 1, 3};
+    const std::vector<spla::uint> Aj = {1, 2, 0};
+
+    EXPECT_EQ(loader.get_n_rows(), 4);
+    EXPECT_EQ(loader.get_n_cols(), 4);
+    EXPECT_EQ(loader.get_n_values(), Ai.size());
+    EXPECT_EQ(loader.get_Ai(), Ai);
+    EXPECT_EQ(loader.get_Aj(), Aj);
+
+    std::filesystem::remove(path);
+}
+
+TEST(io, offset_undirected) {
+    const auto path = write_test_mtx("spla_test_io_1.mtx", TEST_MTX);
+
+    spla::MtxLoader loader;
+    EXPECT_TRUE(loader.load(path, true, true, false));
+
+    const std::vector<spla::uint> Ai = {0, 0, 1, 1, 2, 2, 3};
+    const std::vector<spla::uint> Aj = {1, 3, 0, 2, 1, 2, 0};
+
+    EXPECT_EQ(loader.get_n_values(), Ai.size());
+    EXPECT_EQ(loader.get_Ai(), Ai);
+    EXPECT_EQ(loader.get_Aj(), Aj);
+
+    std::filesystem::remove(path);
+}
+
+TEST(io, no_offset) {
+    const auto path = write_test_mtx("spla_test_io_2.mtx", TEST_MTX);
+
+    spla::MtxLoader loader;
+    EXPECT_TRUE(loader.load(path, false, false, false));
+
+    const std::vector<spla::uint> Ai = {1, 2, 3, 4};
+    const std::vector<spla::uint> Aj = {2, 3, 3, 1};
+
+    EXPECT_EQ(loader.get_n_values(), Ai.size());
+    EXPECT_EQ(loader.get_Ai(), Ai);
+    EXPECT_EQ(loader.get_Aj(), Aj);
+
+    std::filesystem::remove(path);
+}
+
+TEST(io, bad_header) {
+    const auto path = write_test_mtx("spla_test_io_3.mtx",
+                                     "%%MatrixMarket matrix coordinate pattern general\n"
+                                     "4294967296 4 1\n"
+                                     "1 1\n");
+
+    spla::MtxLoader loader;
+    EXPECT_FALSE(loader.load(path));
+
+    std::filesystem::remove(path);
+}
+
+SPLA_GTEST_MAIN_WITH_FINALIZE
@@ -66,4 +66,18 @@ TEST(library, default_accelerator_info) {
     std::cout << "Info: " << acc_info << std::endl;
 }
 
+TEST(library, cpu_threads) {
+    EXPECT_EQ(spla::Library::get()->set_cpu_threads(-1), spla::Status::InvalidArgument);
+    EXPECT_EQ(spla::Library::get()->set_cpu_threads(3), spla::Status::Ok);
+    EXPECT_EQ(spla::Library::get()->get_cpu_threads(), 3);
+
+    EXPECT_EQ(spla::Library::get()->set_cpu_pinning(true), spla::Status::Ok);
+    EXPECT_TRUE(spla::Library::get()->is_set_cpu_pinning());
+    EXPECT_EQ(spla::Library::get()->get_cpu_threads(), 3);
+
+    EXPECT_EQ(spla::Library::get()->set_cpu_pinning(false), spla::Status::Ok);
+    EXPECT_EQ(spla::Library::get()->set_cpu_threads(0), spla::Status::Ok);
+    EXPECT_GE(spla::Library::get()->get_cpu_threads(), 1);
+}
+
 SPLA_GTEST_MAIN
\ No newline at end of file
@@ -29,6 +29,12 @@
 
 #include <spla.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
 TEST(matrix, get_set_naive) {
     const spla::uint M = 10, N = 10, K = 8;
     const spla::uint Ai[K] = {0, 0, 1, 2, 4, 7, 8, 8};
@@ -169,6 +175,311 @@ TEST(matrix, reduce_by_column) {
 }
 
 
+TEST(matrix, csc) {
+    const spla::uint M = 300, N = 500;
+
+    auto value = [](spla::uint i, spla::uint j) { return int(i * N + j + 1); };
+    auto exist = [](spla::uint i, spla::uint j) { return (i * 7 + j * 3) % 5 == 0; };
+
+    auto check = [&](const spla::ref_ptr<spla::Matrix>& mat) {
+        auto ivec  = spla::Vector::make(M, spla::INT);
+        auto isum  = spla::Vector::make(N, spla::INT);
+        auto iinit = spla::Scalar::make_int(0);
+
+        for (spla::uint j = 0; j < N; j += 7) {
+            spla::exec_m_extract_column(ivec, mat, j, spla::IDENTITY_INT);
+
+            for (spla::uint i = 0; i < M; i++) {
+                int actual;
+                ivec->get_int(i, actual);
+                EXPECT_EQ(actual, exist(i, j) ? value(i, j) : 0);
+            }
+        }
+
+        spla::exec_m_reduce_by_column(isum, mat, spla::PLUS_INT, iinit);
+
+        for (spla::uint j = 0; j < N; j++) {
+            int expected = 0, actual;
+            for (spla::uint i = 0; i < M; i++) {
+                if (exist(i, j)) expected += value(i, j);
+            }
+            isum->get_int(j, actual);
+            EXPECT_EQ(actual, expected);
+        }
+    };
+
+    // lil to csc
+    auto imat = spla::Matrix::make(M, N, spla::INT);
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint j = 0; j < N; j++) {
+            if (exist(i, j)) imat->set_int(i, j, value(i, j));
+        }
+    }
+    imat->set_format(spla::FormatMatrix::CpuCsc);
+    check(imat);
+
+    // coo to csc
+    spla::ref_ptr<spla::MemView> keys1, keys2, values;
+    imat->read(keys1, keys2, values);
+
+    auto icoo = spla::Matrix::make(M, N, spla::INT);
+    icoo->build(keys1, keys2, values);
+    icoo->set_format(spla::FormatMatrix::CpuCsc);
+    check(icoo);
+
+    // csr to csc and back: transpose of csr matrix has only csr data
+    auto itr  = spla::Matrix::make(N, M, spla::INT);
+    auto icsr = spla::Matrix::make(M, N, spla::INT);
+    imat->set_format(spla::FormatMatrix::CpuCsr);
+    spla::exec_m_transpose(itr, imat, spla::IDENTITY_INT);
+    itr->set_format(spla::FormatMatrix::CpuCsr);
+    spla::exec_m_transpose(icsr, itr, spla::IDENTITY_INT);
+    icsr->set_format(spla::FormatMatrix::CpuCsc);
+    check(icsr);
+}
+
+
+TEST(matrix, csc_resident) {
+    const spla::uint M = 300, N = 500;
+
+    auto value = [](spla::uint i, spla::uint j) { return int(i * N + j + 1); };
+    auto exist = [](spla::uint i, spla::uint j) { return (i * 7 + j * 3) % 5 == 0; };
+
+    spla::Library* library = spla::Library::get();
+    library->set_format_policy(spla::FormatPolicy::KeepOne);
+
+    auto imat = spla::Matrix::make(M, N, spla::INT);
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint j = 0; j < N; j++) {
+            if (exist(i, j)) imat->set_int(i, j, value(i, j));
+        }
+    }
+
+    // only csc is kept, so columns are reduced over csc and csr is converted from it
+    imat->set_format(spla::FormatMatrix::CpuCsc);
+
+    auto icols = spla::Vector::make(N, spla::INT);
+    auto irows = spla::Vector::make(M, spla::INT);
+    auto iinit = spla::Scalar::make_int(0);
+
+    spla::exec_m_reduce_by_column(icols, imat, spla::PLUS_INT, iinit);
+
+    imat->set_format(spla::FormatMatrix::CpuCsr);
+    spla::exec_m_reduce_by_row(irows, imat, spla::PLUS_INT, iinit);
+
+    for (spla::uint j = 0; j < N; j++) {
+        int expected = 0, actual;
+        for (spla::uint i = 0; i < M; i++) {
+            if (exist(i, j)) expected += value(i, j);
+        }
+        icols->get_int(j, actual);
+        EXPECT_EQ(actual, expected);
+    }
+    for (spla::uint i = 0; i < M; i++) {
+        int expected = 0, actual;
+        for (spla::uint j = 0; j < N; j++) {
+            if (exist(i, j)) expected += value(i, j);
+        }
+        irows->get_int(i, actual);
+        EXPECT_EQ(actual, expected);
+    }
+
+    library->set_format_policy(spla::FormatPolicy::KeepAll);
+}
+
+TEST(matrix, build_unsorted) {
+    const spla::uint M = 1000, N = 700, K = 200000;
+
+    std::vector<spla::uint> keys1(K), keys2(K);
+    std::vector<int>        values(K);
+    std::vector<int>        expected(std::size_t(M) * N, 0);
+
+    for (spla::uint k = 0; k < K; k++) {
+        keys1[k]  = (k * 7919u) % M;
+        keys2[k]  = (k * 104729u) % N;
+        values[k] = int(k % 13) + 1;
+        expected[std::size_t(keys1[k]) * N + keys2[k]] += values[k];
+    }
+
+    auto imat = spla::Matrix::make(M, N, spla::INT);
+    imat->set_reduce(spla::PLUS_INT);
+    imat->build(spla::MemView::make(keys1.data(), K * sizeof(spla::uint)),
+                spla::MemView::make(keys2.data(), K * sizeof(spla::uint)),
+                spla::MemView::make(values.data(), K * sizeof(int)));
+    imat->set_format(spla::FormatMatrix::CpuCsr);
+
+    for (spla::uint i = 0; i < M; i += 3) {
+        for (spla::uint j = 0; j < N; j++) {
+            int actual;
+            imat->get_int(i, j, actual);
+            EXPECT_EQ(actual, expected[std::size_t(i) * N + j]);
+        }
+    }
+}
+
+TEST(matrix, build_unsorted_reduce_released) {
+    const spla::uint N = 100;
+
+    std::vector<spla::uint> keys1  = {5, 1, 5, 1, 7};
+    std::vector<spla::uint> keys2  = {3, 2, 3, 2, 0};
+    std::vector<int>        values = {1, 2, 3, 4, 5};
+
+    spla::Library* library = spla::Library::get();
+    library->set_format_policy(spla::FormatPolicy::KeepOne);
+
+    // lil with reduce op is released once other format is in use, op must survive it
+    auto imat = spla::Matrix::make(N, N, spla::INT);
+    imat->set_reduce(spla::PLUS_INT);
+    imat->set_int(0, 0, 1);
+    imat->set_format(spla::FormatMatrix::CpuCsr);
+    imat->build(spla::MemView::make(keys1.data(), keys1.size() * sizeof(spla::uint)),
+                spla::MemView::make(keys2.data(), keys2.size() * sizeof(spla::uint)),
+                spla::MemView::make(values.data(), values.size() * sizeof(int)));
+
+    int actual;
+    imat->get_int(5, 3, actual);
+    EXPECT_EQ(actual, 4);
+    imat->get_int(1, 2, actual);
+    EXPECT_EQ(actual, 6);
+    imat->get_int(7, 0, actual);
+    EXPECT_EQ(actual, 5);
+
+    library->set_format_policy(spla::FormatPolicy::KeepAll);
+}
+
+TEST(matrix, format_policy) {
+    const spla::uint N = 400;
+
+    auto value = [](spla::uint i, spla::uint j) { return int(i * N + j + 1); };
+    auto exist = [](spla::uint i, spla::uint j) { return (i * 5 + j * 3) % 7 == 0; };
+
+    auto make = [&]() {
+        auto mat = spla::Matrix::make(N, N, spla::INT);
+        for (spla::uint i = 0; i < N; i++) {
+            for (spla::uint j = 0; j < N; j++) {
+                if (exist(i, j)) mat->set_int(i, j, value(i, j));
+            }
+        }
+        return mat;
+    };
+    auto check = [&](const spla::ref_ptr<spla::Matrix>& mat) {
+        for (spla::uint i = 0; i < N; i += 3) {
+            for (spla::uint j = 0; j < N; j++) {
+                int actual;
+                mat->get_int(i, j, actual);
+                EXPECT_EQ(actual, exist(i, j) ? value(i, j) : 0);
+            }
+        }
+    };
+    auto convert = [&](const spla::ref_ptr<spla::Matrix>& mat) {
+        mat->set_format(spla::FormatMatrix::CpuCoo);
+        mat->set_format(spla::FormatMatrix::CpuCsr);
+        mat->set_format(spla::FormatMatrix::CpuCsc);
+    };
+
+    spla::Library* library = spla::Library::get();
+
+    auto imat_all = make();
+    convert(imat_all);
+    const std::size_t usage_all = imat_all->get_memory_usage();
+
+    library->set_format_policy(spla::FormatPolicy::KeepOne);
+    auto imat_one = make();
+    convert(imat_one);
+    const std::size_t usage_one = imat_one->get_memory_usage();
+    EXPECT_GT(usage_one, 0);
+    EXPECT_LT(usage_one, usage_all);
+    EXPECT_GE(library->get_memory_usage(), usage_one);
+    check(imat_one);
+
+    library->set_format_policy(spla::FormatPolicy::Budgeted);
+    auto imat_budget = make();
+    imat_budget->set_memory_budget(usage_one * 3 / 2);
+    convert(imat_budget);
+    EXPECT_LE(imat_budget->get_memory_usage(), usage_one * 3 / 2);
+    check(imat_budget);
+
+    library->set_format_policy(spla::FormatPolicy::KeepAll);
+}
+
+TEST(matrix, snapshot) {
+    const spla::uint M = 200, N = 300;
+    const auto       path = (std::filesystem::temp_directory_path() / "spla_test_matrix.snapshot").string();
+
+    auto imat = spla::Matrix::make(M, N, spla::FLOAT);
+    imat->set_fill_value(spla::Scalar::make_float(-1.0f));
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint j = i % 3; j < N; j += 7) {
+            imat->set_float(i, j, float(i * N + j));
+        }
+    }
+
+    EXPECT_EQ(imat->save_snapshot(path), spla::Status::Ok);
+
+    auto loaded = spla::Matrix::load_snapshot(path);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->get_n_rows(), M);
+    EXPECT_EQ(loaded->get_n_cols(), N);
+    EXPECT_EQ(loaded->get_type(), spla::FLOAT);
+
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint j = 0; j < N; j++) {
+            float expected, actual;
+            imat->get_float(i, j, expected);
+            loaded->get_float(i, j, actual);
+            EXPECT_EQ(actual, expected);
+        }
+    }
+
+    EXPECT_FALSE(spla::Vector::load_snapshot(path));
+
+    std::filesystem::remove(path);
+}
+
+TEST(matrix, snapshot_corrupted) {
+    const spla::uint M = 20, N = 30;
+    const auto       path = (std::filesystem::temp_directory_path() / "spla_test_matrix_corrupted.snapshot").string();
+
+    auto imat = spla::Matrix::make(M, N, spla::INT);
+    for (spla::uint i = 0; i < M; i++) {
+        imat->set_int(i, (i * 7) % N, int(i));
+    }
+    EXPECT_EQ(imat->save_snapshot(path), spla::Status::Ok);
+
+    std::vector<char> bytes(std::filesystem::file_size(path));
+    std::ifstream(path, std::ios::binary).read(bytes.data(), std::streamsize(bytes.size()));
+
+    auto check_fails = [&](const std::vector<char>& data) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(), std::streamsize(data.size()));
+        EXPECT_FALSE(spla::Matrix::load_snapshot(path));
+    };
+
+    // layout: 128 bytes header with n_rows at 40, then Ap and Aj arrays aligned by 64
+    const std::size_t ap_offset = 128;
+    const std::size_t aj_offset = (ap_offset + (M + 1) * sizeof(spla::uint) + 63) / 64 * 64;
+
+    auto truncated = bytes;
+    truncated.resize(bytes.size() - sizeof(int));
+    check_fails(truncated);
+
+    auto huge_rows = bytes;
+    const std::uint64_t n_rows = std::uint64_t(1) << 40;
+    std::memcpy(huge_rows.data() + 40, &n_rows, sizeof(n_rows));
+    check_fails(huge_rows);
+
+    auto bad_offsets = bytes;
+    const spla::uint offset = M;
+    std::memcpy(bad_offsets.data() + ap_offset + sizeof(spla::uint), &offset, sizeof(offset));
+    check_fails(bad_offsets);
+
+    auto bad_column = bytes;
+    const spla::uint column = N;
+    std::memcpy(bad_column.data() + aj_offset, &column, sizeof(column));
+    check_fails(bad_column);
+
+    std::filesystem::remove(path);
+}
+
 TEST(matrix, reduce) {
     const spla::uint M = 10000, N = 20000, K = 8;
 
@@ -27,8 +27,10 @@
 
 #include "test_common.hpp"
 
+#include <cstring>
 #include <iostream>
 #include <spla.hpp>
+#include <vector>
 
 TEST(mxm, naive) {
     spla::uint M = 3, N = 4, K = 2;
@@ -129,4 +131,174 @@ TEST(mxm, perf_zero) {
     }
 }
 
+TEST(mxm, threads) {
+    spla::uint M = 400, N = 300, K = 500;
+
+    auto R1   = spla::Matrix::make(M, K, spla::INT);
+    auto R4   = spla::Matrix::make(M, K, spla::INT);
+    auto A    = spla::Matrix::make(M, N, spla::INT);
+    auto B    = spla::Matrix::make(N, K, spla::INT);
+    auto init = spla::Scalar::make_int(0);
+
+    for (spla::uint i = 0; i < M; i++) {
+        // skewed rows: few rows are very dense
+        const spla::uint step = i % 50 == 0 ? 1 : 17;
+        for (spla::uint j = i % step; j < N; j += step) {
+            A->set_int(i, j, int(i + j) % 7 + 1);
+        }
+    }
+    for (spla::uint i = 0; i < N; i++) {
+        for (spla::uint j = i % 5; j < K; j += 5) {
+            B->set_int(i, j, int(i * j) % 3 + 1);
+        }
+    }
+
+    auto desc1 = spla::Descriptor::make();
+    desc1->set_threads_count(1);
+    auto desc4 = spla::Descriptor::make();
+    desc4->set_threads_count(4);
+
+    EXPECT_EQ(spla::exec_mxm(R1, A, B, spla::MULT_INT, spla::PLUS_INT, init, desc1), spla::Status::Ok);
+    EXPECT_EQ(spla::exec_mxm(R4, A, B, spla::MULT_INT, spla::PLUS_INT, init, desc4), spla::Status::Ok);
+
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint j = 0; j < K; j++) {
+            int v1, v4;
+            R1->get_int(i, j, v1);
+            R4->get_int(i, j, v4);
+            EXPECT_EQ(v1, v4);
+        }
+    }
+}
+
+TEST(mxm, csr) {
+    spla::uint M = 200, N = 150, K = 300;
+
+    auto R_lil = spla::Matrix::make(M, K, spla::INT);
+    auto R_csr = spla::Matrix::make(M, K, spla::INT);
+    auto A     = spla::Matrix::make(M, N, spla::INT);
+    auto B     = spla::Matrix::make(N, K, spla::INT);
+    auto init  = spla::Scalar::make_int(0);
+
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint j = i % 7; j < N; j += 7) {
+            // alternating signs make some products cancel out to zero
+            A->set_int(i, j, j % 2 ? 1 : -1);
+        }
+    }
+    for (spla::uint i = 0; i < N; i++) {
+        for (spla::uint j = i % 3; j < K; j += 3) {
+            B->set_int(i, j, int(j % 4) + 1);
+        }
+    }
+
+    EXPECT_EQ(spla::exec_mxm(R_lil, A, B, spla::MULT_INT, spla::PLUS_INT, init), spla::Status::Ok);
+
+    A->set_format(spla::FormatMatrix::CpuCsr);
+    B->set_format(spla::FormatMatrix::CpuCsr);
+
+    EXPECT_EQ(spla::exec_mxm(R_csr, A, B, spla::MULT_INT, spla::PLUS_INT, init), spla::Status::Ok);
+
+    spla::ref_ptr<spla::MemView> keys1_lil, keys2_lil, values_lil;
+    spla::ref_ptr<spla::MemView> keys1_csr, keys2_csr, values_csr;
+
+    R_lil->read(keys1_lil, keys2_lil, values_lil);
+    R_csr->read(keys1_csr, keys2_csr, values_csr);
+
+    ASSERT_EQ(keys1_lil->get_size(), keys1_csr->get_size());
+
+    const auto n_values = keys1_lil->get_size() / sizeof(spla::uint);
+    const auto Ri_lil   = static_cast<const spla::uint*>(keys1_lil->get_buffer());
+    const auto Rj_lil   = static_cast<const spla::uint*>(keys2_lil->get_buffer());
+    const auto Rx_lil   = static_cast<const int*>(values_lil->get_buffer());
+    const auto Ri_csr   = static_cast<const spla::uint*>(keys1_csr->get_buffer());
+    const auto Rj_csr   = static_cast<const spla::uint*>(keys2_csr->get_buffer());
+    const auto Rx_csr   = static_cast<const int*>(values_csr->get_buffer());
+
+    for (std::size_t k = 0; k < n_values; k++) {
+        EXPECT_EQ(Ri_lil[k], Ri_csr[k]);
+        EXPECT_EQ(Rj_lil[k], Rj_csr[k]);
+        EXPECT_EQ(Rx_lil[k], Rx_csr[k]);
+        EXPECT_NE(Rx_csr[k], 0);
+    }
+}
+
+TEST(mxm, accumulators) {
+    using Accumulator = spla::Descriptor::Accumulator;
+
+    spla::uint M = 120, N = 200, K = 5000;
+
+    auto A    = spla::Matrix::make(M, N, spla::INT);
+    auto B    = spla::Matrix::make(N, K, spla::INT);
+    auto init = spla::Scalar::make_int(0);
+
+    for (spla::uint i = 0; i < M; i++) {
+        // rows of different length so auto mode selects every accumulator
+        const spla::uint step = i % 3 == 0 ? 67 : (i % 3 == 1 ? 11 : 2);
+        for (spla::uint j = i % step; j < N; j += step) {
+            A->set_int(i, j, j % 2 ? 1 : -1);
+        }
+    }
+    for (spla::uint i = 0; i < N; i++) {
+        for (spla::uint j = (i * 13) % 17; j < K; j += 17 + i % 5) {
+            B->set_int(i, j, int(j % 4) + 1);
+        }
+    }
+
+    // naive dense product, missing entries are compared as zeros
+    std::vector<int> A_dense(M * N, 0), B_dense(N * K, 0), R_dense(M * K, 0);
+
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint j = 0; j < N; j++) {
+            A->get_int(i, j, A_dense[i * N + j]);
+        }
+    }
+    for (spla::uint i = 0; i < N; i++) {
+        for (spla::uint j = 0; j < K; j++) {
+            B->get_int(i, j, B_dense[i * K + j]);
+        }
+    }
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint k = 0; k < N; k++) {
+            if (A_dense[i * N + k] == 0) continue;
+            for (spla::uint j = 0; j < K; j++) {
+                R_dense[i * K + j] += A_dense[i * N + k] * B_dense[k * K + j];
+            }
+        }
+    }
+
+    auto check = [&](Accumulator accumulator) {
+        auto desc = spla::Descriptor::make();
+        desc->set_accumulator(accumulator);
+
+        auto R = spla::Matrix::make(M, K, spla::INT);
+        EXPECT_EQ(spla::exec_mxm(R, A, B, spla::MULT_INT, spla::PLUS_INT, init, desc), spla::Status::Ok);
+
+        spla::ref_ptr<spla::MemView> keys1, keys2, values;
+        R->read(keys1, keys2, values);
+
+        auto* rows = reinterpret_cast<const spla::uint*>(keys1->get_buffer());
+        auto* cols = reinterpret_cast<const spla::uint*>(keys2->get_buffer());
+        auto* vals = reinterpret_cast<const int*>(values->get_buffer());
+
+        std::vector<int> R_actual(M * K, 0);
+        for (std::size_t k = 0; k < values->get_size() / sizeof(int); k++) {
+            R_actual[rows[k] * K + cols[k]] = vals[k];
+        }
+
+        EXPECT_TRUE(R_actual == R_dense);
+    };
+
+    for (auto accumulator : {Accumulator::Auto, Accumulator::Dense, Accumulator::Hash, Accumulator::Heap}) {
+        check(accumulator);
+    }
+
+    A->set_format(spla::FormatMatrix::CpuCsr);
+    B->set_format(spla::FormatMatrix::CpuCsr);
+
+    for (auto accumulator : {Accumulator::Auto, Accumulator::Dense, Accumulator::Hash, Accumulator::Heap}) {
+        check(accumulator);
+    }
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE_PLATFORM(1)
@@ -28,6 +28,8 @@
 #include "test_common.hpp"
 
 #include <iostream>
+#include <limits>
+#include <random>
 #include <spla.hpp>
 
 TEST(mxmT_masked, naive) {
@@ -139,5 +141,137 @@ TEST(mxmT_masked, perf_zero) {
     }
 }
 
+TEST(mxmT_masked, skewed) {
+    spla::uint M = 300, N = 1000, K = 400;
+
+    // a few dense rows of A are intersected with many short rows of B, other rows are short too
+    std::vector<std::vector<int>> A_dense(M, std::vector<int>(N, 0));
+    std::vector<std::vector<int>> B_dense(K, std::vector<int>(N, 0));
+
+    auto R    = spla::Matrix::make(M, K, spla::INT);
+    auto mask = spla::Matrix::make(M, K, spla::INT);
+    auto A    = spla::Matrix::make(M, N, spla::INT);
+    auto B    = spla::Matrix::make(K, N, spla::INT);
+    auto init = spla::Scalar::make_int(0);
+    auto desc = spla::Descriptor::make();
+
+    std::default_random_engine                engine(7);
+    std::uniform_int_distribution<spla::uint> dist(0, N - 1);
+
+    for (spla::uint i = 0; i < M; i++) {
+        const spla::uint len = i % 50 == 0 ? N / 2 : 10;
+        for (spla::uint k = 0; k < len; k++) {
+            const spla::uint j = dist(engine);
+            A_dense[i][j]      = int(j % 3 + 1);
+            A->set_int(i, j, A_dense[i][j]);
+        }
+    }
+    for (spla::uint i = 0; i < K; i++) {
+        const spla::uint len = i % 40 == 0 ? N / 2 : 20;
+        for (spla::uint k = 0; k < len; k++) {
+            const spla::uint j = dist(engine);
+            B_dense[i][j]      = int(j % 5 + 1);
+            B->set_int(i, j, B_dense[i][j]);
+        }
+    }
+    for (spla::uint i = 0; i < M; i++) {
+        for (spla::uint j = 0; j < K; j++) {
+            if ((i + j) % 5 != 0) mask->set_int(i, j, 1);
+        }
+    }
+
+    for (int threads : {1, 4}) {
+        desc->set_threads_count(threads);
+        spla::exec_mxmT_masked(R, mask, A, B, spla::MULT_INT, spla::PLUS_INT, spla::GTZERO_INT, init, desc);
+
+        for (spla::uint i = 0; i < M; i++) {
+            for (spla::uint j = 0; j < K; j++) {
+                int expected = 0;
+                if ((i + j) % 5 != 0) {
+                    for (spla::uint k = 0; k < N; k++) expected += A_dense[i][k] * B_dense[j][k];
+                }
+
+                int v;
+                R->get_int(i, j, v);
+                EXPECT_EQ(v, expected);
+            }
+        }
+    }
+}
+
+TEST(mxmT_masked_reduce, naive) {
+    spla::uint M = 3, N = 4, K = 2;
+
+    // same as mxmT_masked.naive, sum of masked product is 23 + 83
+
+    auto mask = spla::Matrix::make(M, K, spla::FLOAT);
+    auto A    = spla::Matrix::make(M, N, spla::FLOAT);
+    auto B    = spla::Matrix::make(K, N, spla::FLOAT);
+    auto r    = spla::Scalar::make(spla::FLOAT);
+    auto init = spla::Scalar::make_float(1.0);
+
+    mask->set_float(0, 0, 1.0f);
+    mask->set_float(0, 1, 1.0f);
+    mask->set_float(2, 0, 1.0f);
+    mask->set_float(2, 1, 1.0f);
+
+    A->set_float(0, 0, 1.0f);
+    A->set_float(0, 2, 2.0f);
+    A->set_float(1, 1, 3.0f);
+    A->set_float(1, 3, 4.0f);
+    A->set_float(2, 0, 5.0f);
+    A->set_float(2, 2, 6.0f);
+
+    B->set_float(0, 0, 7.0f);
+    B->set_float(0, 2, 8.0f);
+    B->set_float(1, 1, 9.0f);
+    B->set_float(1, 3, 10.0f);
+
+    spla::exec_mxmT_masked_reduce(r, init, mask, A, B, spla::MULT_FLOAT, spla::PLUS_FLOAT, spla::GTZERO_FLOAT);
+
+    EXPECT_EQ(r->as_float(), 107);
+}
+
+TEST(mxmT_masked_reduce, count) {
+    spla::uint N = 2000;
+
+    // lower triangle of random graph with a few hubs, so skewed rows are intersected too
+    auto L = spla::Matrix::make(N, N, spla::INT);
+
+    std::default_random_engine              engine(42);
+    std::uniform_int_distribution<spla::uint> dist(0, N - 1);
+
+    for (spla::uint k = 0; k < 16 * N; k++) {
+        spla::uint i = dist(engine);
+        spla::uint j = k % 7 == 0 ? k % 5 : dist(engine);
+        if (i > j) L->set_int(i, j, 1);
+        if (j > i) L->set_int(j, i, 1);
+    }
+
+    auto R    = spla::Matrix::make(N, N, spla::INT);
+    auto zero = spla::Scalar::make_int(0);
+    auto sum  = spla::Scalar::make(spla::INT);
+    auto cnt  = spla::Scalar::make(spla::INT);
+    auto desc = spla::Descriptor::make();
+
+    spla::exec_mxmT_masked(R, L, L, L, spla::MULT_INT, spla::PLUS_INT, spla::GTZERO_INT, zero);
+    spla::exec_m_reduce(sum, zero, R, spla::PLUS_INT);
+
+    for (int threads : {1, 4}) {
+        desc->set_struct_only(true);
+        desc->set_threads_count(threads);
+        spla::exec_mxmT_masked_reduce(cnt, zero, L, L, L, spla::MULT_INT, spla::PLUS_INT, spla::GTZERO_INT, desc);
+        EXPECT_EQ(cnt->as_int(), sum->as_int());
+
+        desc->set_struct_only(false);
+        spla::exec_mxmT_masked_reduce(cnt, zero, L, L, L, spla::MULT_INT, spla::PLUS_INT, spla::GTZERO_INT, desc);
+        EXPECT_EQ(cnt->as_int(), sum->as_int());
+    }
+
+    // count which does not fit into int is an error, not a truncated value
+    auto near_max = spla::Scalar::make_int(std::numeric_limits<int>::max() - 1);
+    desc->set_struct_only(true);
+    EXPECT_EQ(spla::exec_mxmT_masked_reduce(cnt, near_max, L, L, L, spla::MULT_INT, spla::PLUS_INT, spla::GTZERO_INT, desc), spla::Status::Error);
+}
 
 SPLA_GTEST_MAIN_WITH_FINALIZE_PLATFORM(1)
\ No newline at end of file
@@ -27,7 +27,9 @@
 
 #include "test_common.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 #include <spla.hpp>
 
 TEST(mxv_masked, naive) {
@@ -129,4 +131,156 @@ TEST(mxv_masked, perf) {
     std::cout << std::endl;
 }
 
+TEST(mxv_masked, semirings) {
+    const spla::uint N = 2000;
+
+    auto fM    = spla::Matrix::make(N, N, spla::FLOAT);
+    auto fv    = spla::Vector::make(N, spla::FLOAT);
+    auto iM    = spla::Matrix::make(N, N, spla::INT);
+    auto iv    = spla::Vector::make(N, spla::INT);
+    auto mask  = spla::Vector::make(N, spla::FLOAT);
+    auto imask = spla::Vector::make(N, spla::INT);
+
+    std::vector<std::vector<std::pair<spla::uint, float>>> rows(N);
+
+    for (spla::uint i = 0; i < N; i++) {
+        // skewed row lengths, including empty rows and rows shorter than simd lanes
+        const spla::uint len = (i * 7919) % (i % 10 == 0 ? 400 : 13);
+        for (spla::uint k = 0; k < len; k++) {
+            const spla::uint j = (i * 31 + k * 97) % N;
+            if (rows[i].empty() || rows[i].back().first < j) {
+                rows[i].emplace_back(j, float((i + j) % 5) + 0.5f);
+            }
+        }
+        for (const auto& e : rows[i]) {
+            fM->set_float(i, e.first, e.second);
+            iM->set_int(i, e.first, int(e.second) % 3);
+        }
+        fv->set_float(i, float(i % 7) + 1.0f);
+        iv->set_int(i, int(i % 4));
+        // both masks select rows with i % 3 != 0
+        mask->set_float(i, float(i % 3 != 0));
+        imask->set_int(i, int(i % 3 == 0));
+    }
+
+    for (int threads : {1, 4}) {
+        auto desc = spla::Descriptor::make();
+        desc->set_threads_count(threads);
+
+        auto r_pm = spla::Vector::make(N, spla::FLOAT);
+        auto r_mp = spla::Vector::make(N, spla::FLOAT);
+        auto r_bb = spla::Vector::make(N, spla::INT);
+        auto r_ee = spla::Vector::make(N, spla::INT);
+
+        EXPECT_EQ(spla::exec_mxv_masked(r_pm, mask, fM, fv, spla::MULT_FLOAT, spla::PLUS_FLOAT, spla::NQZERO_FLOAT, spla::Scalar::make_float(1.0f), desc), spla::Status::Ok);
+        EXPECT_EQ(spla::exec_mxv_masked(r_mp, mask, fM, fv, spla::PLUS_FLOAT, spla::MIN_FLOAT, spla::NQZERO_FLOAT, spla::Scalar::make_float(100.0f), desc), spla::Status::Ok);
+        EXPECT_EQ(spla::exec_mxv_masked(r_bb, imask, iM, iv, spla::BAND_INT, spla::BOR_INT, spla::EQZERO_INT, spla::Scalar::make_int(0), desc), spla::Status::Ok);
+
+        desc->set_early_exit(true);
+        EXPECT_EQ(spla::exec_mxv_masked(r_ee, imask, iM, iv, spla::BAND_INT, spla::BOR_INT, spla::EQZERO_INT, spla::Scalar::make_int(0), desc), spla::Status::Ok);
+
+        for (spla::uint i = 0; i < N; i++) {
+            float pm = 1.0f, mp = 100.0f;
+            int   bb = 0, ee = 0;
+
+            if (i % 3 != 0) {
+                for (const auto& e : rows[i]) {
+                    pm += e.second * (float(e.first % 7) + 1.0f);
+                    mp = std::min(mp, e.second + (float(e.first % 7) + 1.0f));
+                    bb |= (int(e.second) % 3) & int(e.first % 4);
+                    if (ee == 0) ee = (int(e.second) % 3) & int(e.first % 4);
+                }
+            }
+
+            float f;
+            int   x;
+
+            r_pm->get_float(i, f);
+            EXPECT_NEAR(f, pm, 1e-3f * pm);
+            r_mp->get_float(i, f);
+            EXPECT_EQ(f, mp);
+            r_bb->get_int(i, x);
+            EXPECT_EQ(x, bb);
+            r_ee->get_int(i, x);
+            EXPECT_EQ(x, ee);
+        }
+    }
+}
+
+TEST(mxv_masked, pull_degree) {
+    const spla::uint N = 20000;
+
+    auto iM      = spla::Matrix::make(N, N, spla::INT);
+    auto v_dense = spla::Vector::make(N, spla::INT);
+    auto v_coo   = spla::Vector::make(N, spla::INT);
+    auto imask   = spla::Vector::make(N, spla::INT);
+
+    // same ops as built-in ones, but not recognized by cpu kernel, so generic path is taken
+    auto custom_band   = spla::OpBinary::make_int("custom_band", "(int a, int b) { return a & b; }", [](int a, int b) { return a & b; });
+    auto custom_bor    = spla::OpBinary::make_int("custom_bor", "(int a, int b) { return a | b; }", [](int a, int b) { return a | b; });
+    auto custom_bone   = spla::OpBinary::make_int("custom_bone", "(int a, int b) { return 1; }", [](int, int) { return 1; });
+    auto custom_plus   = spla::OpBinary::make_int("custom_plus", "(int a, int b) { return a + b; }", [](int a, int b) { return a + b; });
+    auto custom_eqzero = spla::OpSelect::make_int("custom_eqzero", "(int a) { return a == 0; }", [](int a) { return a == 0; });
+
+    for (spla::uint i = 0; i < N; i++) {
+        // skewed row lengths with empty rows, enough entries in total to run on several threads
+        const spla::uint len = (i * 7919) % (i % 10 == 0 ? 64 : 9);
+        for (spla::uint k = 0; k < len; k++) {
+            iM->set_int(i, (i * 31 + k * 97) % N, 1);
+        }
+        if (i % 5 == 0) v_dense->set_int(i, 1);
+        if (i % 97 == 0) v_coo->set_int(i, 1);
+        imask->set_int(i, int(i % 3 == 0));
+    }
+
+    v_dense->set_format(spla::FormatVector::CpuDense);
+    v_coo->set_format(spla::FormatVector::CpuCoo);
+
+    auto expect_same = [N](const spla::ref_ptr<spla::Vector>& a, const spla::ref_ptr<spla::Vector>& b) {
+        for (spla::uint i = 0; i < N; i++) {
+            int x, y;
+            a->get_int(i, x);
+            b->get_int(i, y);
+            EXPECT_EQ(x, y);
+        }
+    };
+
+    for (int threads : {1, 4}) {
+        auto desc = spla::Descriptor::make();
+        desc->set_threads_count(threads);
+
+        auto desc_pull = spla::Descriptor::make();
+        desc_pull->set_threads_count(threads);
+        desc_pull->set_early_exit(true);
+        desc_pull->set_struct_only(true);
+
+        for (const auto& v : {v_dense, v_coo}) {
+            for (int init_value : {0, 2}) {
+                auto r_generic = spla::Vector::make(N, spla::INT);
+                auto r_pull    = spla::Vector::make(N, spla::INT);
+                auto r_select  = spla::Vector::make(N, spla::INT);
+                auto init      = spla::Scalar::make_int(init_value);
+
+                EXPECT_EQ(spla::exec_mxv_masked(r_generic, imask, iM, v, custom_band, custom_bor, spla::EQZERO_INT, init, desc), spla::Status::Ok);
+                EXPECT_EQ(spla::exec_mxv_masked(r_pull, imask, iM, v, spla::BAND_INT, spla::BOR_INT, spla::EQZERO_INT, init, desc_pull), spla::Status::Ok);
+                EXPECT_EQ(spla::exec_mxv_masked(r_select, imask, iM, v, spla::BAND_INT, spla::BOR_INT, custom_eqzero, init, desc_pull), spla::Status::Ok);
+
+                expect_same(r_generic, r_pull);
+                expect_same(r_generic, r_select);
+            }
+        }
+
+        for (const auto& select : {spla::ALWAYS_INT, spla::EQZERO_INT}) {
+            auto r_generic = spla::Vector::make(N, spla::INT);
+            auto r_degree  = spla::Vector::make(N, spla::INT);
+            auto init      = spla::Scalar::make_int(3);
+
+            EXPECT_EQ(spla::exec_mxv_masked(r_generic, imask, iM, v_dense, custom_bone, custom_plus, select, init, desc), spla::Status::Ok);
+            EXPECT_EQ(spla::exec_mxv_masked(r_degree, imask, iM, v_dense, spla::BONE_INT, spla::PLUS_INT, select, init, desc), spla::Status::Ok);
+
+            expect_same(r_generic, r_degree);
+        }
+    }
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE_PLATFORM(1)
\ No newline at end of file
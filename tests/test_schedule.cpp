@@ -29,6 +29,10 @@
 
 #include <spla.hpp>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 TEST(schedule, task_callback) {
     spla::ref_ptr<spla::Schedule>     schedule = spla::make_schedule();
     spla::ref_ptr<spla::ScheduleTask> task;
@@ -37,4 +41,378 @@ TEST(schedule, task_callback) {
     schedule->submit();
 }
 
+TEST(schedule, thread_pool_step) {
+    const spla::uint N = 2000, K = 16;
+
+    // shared matrix is converted by concurrent tasks on first access
+    auto imat = spla::Matrix::make(N, N, spla::INT);
+    for (spla::uint i = 0; i < N; i++) {
+        for (spla::uint j = i % 5; j < N; j += 11) {
+            imat->set_int(i, j, int(i + j));
+        }
+    }
+
+    auto mask = spla::Vector::make(N, spla::INT);
+    auto init = spla::Scalar::make_int(0);
+
+    std::vector<spla::ref_ptr<spla::Vector>>       results;
+    std::vector<spla::ref_ptr<spla::ScheduleTask>> tasks;
+
+    for (spla::uint k = 0; k < K; k++) {
+        auto v = spla::Vector::make(N, spla::INT);
+        auto r = spla::Vector::make(N, spla::INT);
+        v->set_int(k * 7, 1);
+
+        spla::ref_ptr<spla::ScheduleTask> task;
+        spla::exec_vxm_masked(r, mask, v, imat, spla::MULT_INT, spla::PLUS_INT, spla::EQZERO_INT, init, spla::ref_ptr<spla::Descriptor>(), &task);
+        results.push_back(r);
+        tasks.push_back(task);
+    }
+
+    auto schedule = spla::make_schedule(spla::ScheduleType::ThreadPool, 4);
+    schedule->step_tasks(tasks);
+    EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+
+    for (spla::uint k = 0; k < K; k++) {
+        EXPECT_EQ(schedule->get_task_status(0, int(k)), spla::Status::Ok);
+
+        for (spla::uint j = 0; j < N; j++) {
+            int expected, actual;
+            imat->get_int(k * 7, j, expected);
+            results[k]->get_int(j, actual);
+            EXPECT_EQ(actual, expected);
+        }
+    }
+
+    EXPECT_EQ(schedule->get_task_status(0, int(K)), spla::Status::NoValue);
+    EXPECT_EQ(schedule->get_task_status(1, 0), spla::Status::NoValue);
+}
+
+TEST(schedule, thread_pool_steps) {
+    std::atomic_int counter{0};
+    std::atomic_int early{0};
+
+    auto schedule = spla::make_schedule(spla::ScheduleType::ThreadPool, 3);
+
+    for (int step = 0; step < 3; step++) {
+        std::vector<spla::ref_ptr<spla::ScheduleTask>> tasks;
+        for (int t = 0; t < 8; t++) {
+            spla::ref_ptr<spla::ScheduleTask> task;
+            spla::exec_callback([&, step]() { early += counter++ < 8 * step; }, spla::ref_ptr<spla::Descriptor>(), &task);
+            tasks.push_back(task);
+        }
+        schedule->step_tasks(tasks);
+    }
+
+    EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+    EXPECT_EQ(counter.load(), 24);
+    EXPECT_EQ(early.load(), 0);
+}
+
+TEST(schedule, graph_hazards) {
+    const spla::uint N = 1000, K = 8;
+
+    std::vector<spla::ref_ptr<spla::Vector>> xs, as, cs;
+    for (spla::uint k = 0; k < K; k++) {
+        auto x = spla::Vector::make(N, spla::INT);
+        for (spla::uint i = 0; i < N; i++) x->set_int(i, int(i + k));
+        xs.push_back(x);
+        as.push_back(spla::Vector::make(N, spla::INT));
+        cs.push_back(spla::Vector::make(N, spla::INT));
+    }
+
+    auto schedule = spla::make_schedule(spla::ScheduleType::Graph, 4);
+
+    // chains are interleaved in program order, hazards inside a chain must be kept
+    auto step = [&](spla::ref_ptr<spla::Vector> r, spla::ref_ptr<spla::Vector> u, spla::ref_ptr<spla::Vector> v) {
+        spla::ref_ptr<spla::ScheduleTask> task;
+        spla::exec_v_eadd(r, u, v, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task);
+        schedule->step_task(task);
+    };
+    for (spla::uint k = 0; k < K; k++) step(as[k], xs[k], xs[k]);// a = 2x
+    for (spla::uint k = 0; k < K; k++) step(cs[k], as[k], xs[k]);// c = 3x, read after write of a
+    for (spla::uint k = 0; k < K; k++) step(as[k], cs[k], cs[k]);// a = 6x, write after read of a
+    for (spla::uint k = 0; k < K; k++) step(cs[k], xs[k], xs[k]);// c = 2x, write after read and write of c
+
+    std::atomic_int finished{0};
+    spla::ref_ptr<spla::ScheduleTask> barrier;
+    spla::exec_callback([&]() { finished = 1; }, spla::ref_ptr<spla::Descriptor>(), &barrier);
+    schedule->step_task(barrier);
+
+    EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+    EXPECT_EQ(finished.load(), 1);
+
+    for (spla::uint k = 0; k < K; k++) {
+        for (int s = 0; s < 4; s++) {
+            EXPECT_EQ(schedule->get_task_status(s * int(K) + int(k), 0), spla::Status::Ok);
+        }
+        for (spla::uint i = 0; i < N; i++) {
+            int a, c;
+            as[k]->get_int(i, a);
+            cs[k]->get_int(i, c);
+            EXPECT_EQ(a, 6 * int(i + k));
+            EXPECT_EQ(c, 2 * int(i + k));
+        }
+    }
+}
+
+TEST(schedule, graph_failure) {
+    const spla::uint N = 100;
+
+    auto x = spla::Vector::make(N, spla::INT);
+    auto y = spla::Vector::make(N, spla::INT);
+    auto z = spla::Vector::make(N, spla::INT);
+    auto a = spla::Vector::make(N, spla::INT);
+    auto b = spla::Vector::make(N, spla::INT);
+    for (spla::uint i = 0; i < N; i++) x->set_int(i, int(i));
+
+    // single worker takes the most recently queued task first, so the failing
+    // task runs before the one independent of it is released
+    auto schedule = spla::make_schedule(spla::ScheduleType::Graph, 1);
+
+    spla::ref_ptr<spla::ScheduleTask> task;
+    spla::exec_v_eadd(y, x, x, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task);
+    schedule->step_task(task);
+    spla::exec_v_eadd(a, x, x, spla::PLUS_FLOAT, spla::ref_ptr<spla::Descriptor>(), &task);
+    schedule->step_task(task);
+    spla::exec_v_eadd(z, y, y, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task);
+    schedule->step_task(task);
+    spla::exec_v_eadd(b, x, x, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task);
+    schedule->step_task(task);
+
+    EXPECT_NE(schedule->submit(), spla::Status::Ok);
+    EXPECT_NE(schedule->get_task_status(1, 0), spla::Status::Ok);
+    EXPECT_NE(schedule->get_task_status(1, 0), spla::Status::NoValue);
+    EXPECT_EQ(schedule->get_task_status(2, 0), spla::Status::NoValue);
+
+    // tasks after failed one in program order are not executed even if independent of it
+    int value;
+    z->get_int(10, value);
+    EXPECT_EQ(value, 0);
+}
+
+TEST(schedule, submit_async) {
+    const spla::uint N = 1000;
+
+    auto x = spla::Vector::make(N, spla::INT);
+    auto a = spla::Vector::make(N, spla::INT);
+    for (spla::uint i = 0; i < N; i++) x->set_int(i, int(i));
+
+    std::atomic_bool release{false};
+
+    auto schedule = spla::make_schedule();
+
+    // first task blocks execution until released by the test
+    spla::ref_ptr<spla::ScheduleTask> gate;
+    spla::exec_callback([&]() { while (!release.load()) std::this_thread::yield(); }, spla::ref_ptr<spla::Descriptor>(), &gate);
+    schedule->step_task(gate);
+
+    spla::ref_ptr<spla::ScheduleTask> task;
+    spla::exec_v_eadd(a, x, x, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task);
+    schedule->step_task(task);
+
+    std::atomic_int completed{0};
+
+    auto future = schedule->submit_async();
+    EXPECT_EQ(future->on_complete([&](spla::Status status) { completed += status == spla::Status::Ok; }), spla::Status::Ok);
+    EXPECT_FALSE(future->wait_for(10));
+    EXPECT_FALSE(future->is_done());
+    EXPECT_EQ(future->get_status(), spla::Status::InvalidState);
+
+    release = true;
+    EXPECT_EQ(future->wait(), spla::Status::Ok);
+    EXPECT_TRUE(future->is_done());
+    EXPECT_EQ(future->get_status(), spla::Status::Ok);
+    EXPECT_EQ(completed.load(), 1);
+
+    // callback registered after completion is called immediately
+    EXPECT_EQ(future->on_complete([&](spla::Status status) { completed += status == spla::Status::Ok; }), spla::Status::Ok);
+    EXPECT_EQ(completed.load(), 2);
+
+    for (spla::uint i = 0; i < N; i++) {
+        int value;
+        a->get_int(i, value);
+        EXPECT_EQ(value, 2 * int(i));
+    }
+}
+
+TEST(schedule, submit_async_many) {
+    const int K = 64;
+
+    std::atomic_int counter{0};
+
+    std::vector<spla::ref_ptr<spla::Schedule>>       schedules;
+    std::vector<spla::ref_ptr<spla::ScheduleFuture>> futures;
+
+    // more pending submits than executor threads: extra ones wait in the queue
+    for (int k = 0; k < K; k++) {
+        auto                              schedule = spla::make_schedule();
+        spla::ref_ptr<spla::ScheduleTask> task;
+        spla::exec_callback([&]() { counter++; }, spla::ref_ptr<spla::Descriptor>(), &task);
+        schedule->step_task(task);
+        schedules.push_back(schedule);
+        futures.push_back(schedule->submit_async());
+        futures.push_back(schedule->submit_async());
+    }
+
+    for (auto& future : futures) {
+        EXPECT_EQ(future->wait(), spla::Status::Ok);
+    }
+    EXPECT_EQ(counter.load(), 2 * K);
+}
+
+TEST(schedule, resubmit) {
+    const spla::uint N = 100;
+
+    auto x = spla::Vector::make(N, spla::INT);
+    auto a = spla::Vector::make(N, spla::INT);
+    for (spla::uint i = 0; i < N; i++) x->set_int(i, int(i));
+
+    // x = x + x on each submit, second and next dispatches of the task take algo from task cache
+    spla::ref_ptr<spla::ScheduleTask> task;
+    spla::exec_v_eadd(a, x, x, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task);
+    spla::ref_ptr<spla::ScheduleTask> copy;
+    spla::exec_v_eadd(x, a, spla::Vector::make(N, spla::INT), spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &copy);
+
+    auto schedule = spla::make_schedule();
+    schedule->step_task(task);
+    schedule->step_task(copy);
+
+    for (int k = 0; k < 4; k++) {
+        EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+    }
+
+    for (spla::uint i = 0; i < N; i++) {
+        int value;
+        x->get_int(i, value);
+        EXPECT_EQ(value, 16 * int(i));
+    }
+}
+
+TEST(schedule, prepared_task) {
+    const spla::uint N = 100;
+
+    auto x = spla::Vector::make(N, spla::INT);
+    auto y = spla::Vector::make(N, spla::INT);
+    auto z = spla::Vector::make(N, spla::INT);
+    auto a = spla::Vector::make(N, spla::INT);
+    for (spla::uint i = 0; i < N; i++) {
+        x->set_int(i, int(i));
+        y->set_int(i, 1);
+        z->set_int(i, 2);
+    }
+
+    spla::ref_ptr<spla::ScheduleTask> task;
+    spla::exec_v_eadd(a, x, y, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task);
+
+    EXPECT_EQ(spla::exec_task(task), spla::Status::Ok);
+    for (spla::uint i = 0; i < N; i++) {
+        int value;
+        a->get_int(i, value);
+        EXPECT_EQ(value, int(i) + 1);
+    }
+
+    EXPECT_EQ(task->set_arg(2, z.as<spla::Object>()), spla::Status::Ok);
+    EXPECT_EQ(spla::exec_task(task), spla::Status::Ok);
+    for (spla::uint i = 0; i < N; i++) {
+        int value;
+        a->get_int(i, value);
+        EXPECT_EQ(value, int(i) + 2);
+    }
+
+    EXPECT_EQ(task->set_arg(2, spla::Scalar::make_int(1).as<spla::Object>()), spla::Status::InvalidArgument);
+    EXPECT_EQ(task->set_arg(4, z.as<spla::Object>()), spla::Status::InvalidArgument);
+}
+
+TEST(schedule, fusion) {
+    const spla::uint N = 10000;
+
+    auto x = spla::Vector::make(N, spla::INT);
+    auto y = spla::Vector::make(N, spla::INT);
+    auto z = spla::Vector::make(N, spla::INT);
+    auto a = spla::Vector::make(N, spla::INT);
+    auto b = spla::Vector::make(N, spla::INT);
+    auto c = spla::Vector::make(N, spla::INT);
+    auto r = spla::Scalar::make_int(0);
+    x->fill_with(spla::Scalar::make_int(3));
+    y->fill_with(spla::Scalar::make_int(1));
+    z->fill_with(spla::Scalar::make_int(2));
+
+    spla::ref_ptr<spla::ScheduleTask> task_add, task_mult, task_map, task_reduce;
+    spla::exec_v_eadd(a, x, y, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task_add);
+    spla::exec_v_eadd(b, a, a, spla::MULT_INT, spla::ref_ptr<spla::Descriptor>(), &task_mult);
+    spla::exec_v_map(c, b, spla::AINV_INT, spla::ref_ptr<spla::Descriptor>(), &task_map);
+    spla::exec_v_reduce(r, spla::Scalar::make_int(0), c, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task_reduce);
+
+    auto schedule = spla::make_schedule();
+    schedule->step_task(task_add);
+    schedule->step_task(task_mult);
+    schedule->step_task(task_map);
+    schedule->step_task(task_reduce);
+
+    EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+    for (int step_id = 0; step_id < 4; step_id++) {
+        EXPECT_EQ(schedule->get_task_status(step_id, 0), spla::Status::Ok);
+    }
+    EXPECT_EQ(r->as_int(), -16 * int(N));
+    for (spla::uint i = 0; i < N; i += 97) {
+        int value_a, value_c;
+        a->get_int(i, value_a);
+        c->get_int(i, value_c);
+        EXPECT_EQ(value_a, 4);
+        EXPECT_EQ(value_c, -16);
+    }
+
+    EXPECT_EQ(task_add->set_arg(2, z.as<spla::Object>()), spla::Status::Ok);
+    EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+    EXPECT_EQ(r->as_int(), -25 * int(N));
+}
+
+TEST(schedule, fusion_runs_fused) {
+    const spla::uint N = 10000;
+
+    auto x = spla::Vector::make(N, spla::INT);
+    auto y = spla::Vector::make(N, spla::INT);
+    auto a = spla::Vector::make(N, spla::INT);
+    auto b = spla::Vector::make(N, spla::INT);
+    x->fill_with(spla::Scalar::make_int(3));
+    y->fill_with(spla::Scalar::make_int(1));
+
+    // unfused chain runs map only after add is done for all elements, fused one goes block by block
+    std::atomic_int n_added{0};
+    std::atomic_int n_added_before_map{-1};
+
+    auto count_plus = spla::OpBinary::make_int(
+            "count_plus", "(int a, int b) { return a + b; }",
+            [&](int u, int v) { n_added.fetch_add(1); return u + v; });
+    auto first_ainv = spla::OpUnary::make_int(
+            "first_ainv", "(int a) { return -a; }",
+            [&](int u) { int expected = -1; n_added_before_map.compare_exchange_strong(expected, n_added.load()); return -u; });
+
+    spla::ref_ptr<spla::ScheduleTask> task_add, task_map;
+    spla::exec_v_eadd(a, x, y, count_plus, spla::ref_ptr<spla::Descriptor>(), &task_add);
+    spla::exec_v_map(b, a, first_ainv, spla::ref_ptr<spla::Descriptor>(), &task_map);
+
+    auto schedule = spla::make_schedule();
+    schedule->step_task(task_add);
+    schedule->step_task(task_map);
+
+    EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+    EXPECT_EQ(n_added.load(), int(N));
+    EXPECT_GE(n_added_before_map.load(), 0);
+    EXPECT_LT(n_added_before_map.load(), int(N));
+
+    for (spla::uint i = 0; i < N; i += 97) {
+        int value;
+        b->get_int(i, value);
+        EXPECT_EQ(value, -4);
+    }
+
+    // plan is kept between submits of unchanged schedule
+    n_added.store(0);
+    n_added_before_map.store(-1);
+    EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+    EXPECT_LT(n_added_before_map.load(), int(N));
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE
\ No newline at end of file
@@ -30,6 +30,10 @@
 #include <spla.hpp>
 
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
 
 TEST(vector, get_set_naive) {
     const spla::uint N    = 10;
@@ -497,4 +501,123 @@ TEST(vector, map) {
     }
 }
 
+TEST(vector, coo_dense_conversions) {
+    const spla::uint N = 1000;
+
+    std::vector<spla::uint> keys;
+    std::vector<int>        values;
+
+    for (spla::uint i = 0; i < N; i += 3) {
+        keys.push_back(i);
+        values.push_back(int(i) + 1);
+    }
+
+    auto v = spla::Vector::make(N, spla::INT);
+    v->build(spla::MemView::make(keys.data(), keys.size() * sizeof(spla::uint)),
+             spla::MemView::make(values.data(), values.size() * sizeof(int)));
+    v->set_format(spla::FormatVector::CpuDense);
+
+    for (spla::uint i = 0; i < N; i++) {
+        int actual;
+        v->get_int(i, actual);
+        EXPECT_EQ(actual, i % 3 ? 0 : int(i) + 1);
+    }
+
+    auto u = spla::Vector::make(N, spla::INT);
+    u->fill_with(spla::Scalar::make_int(5));
+
+    spla::ref_ptr<spla::MemView> u_keys, u_values;
+    u->read(u_keys, u_values);
+
+    ASSERT_EQ(u_keys->get_size(), N * sizeof(spla::uint));
+    for (spla::uint i = 0; i < N; i++) {
+        EXPECT_EQ(static_cast<const spla::uint*>(u_keys->get_buffer())[i], i);
+        EXPECT_EQ(static_cast<const int*>(u_values->get_buffer())[i], 5);
+    }
+}
+
+TEST(vector, build_unsorted) {
+    const spla::uint N = 5000, K = 100000;
+
+    std::vector<spla::uint> keys(K);
+    std::vector<int>        values(K);
+    std::vector<int>        expected(N, 0);
+
+    for (spla::uint k = 0; k < K; k++) {
+        keys[k]           = (k * 7919u) % N;
+        values[k]         = int(k);
+        expected[keys[k]] = values[k];
+    }
+
+    // default reduce keeps the last of duplicated entries
+    auto v = spla::Vector::make(N, spla::INT);
+    v->build(spla::MemView::make(keys.data(), K * sizeof(spla::uint)),
+             spla::MemView::make(values.data(), K * sizeof(int)));
+    v->set_format(spla::FormatVector::CpuDense);
+
+    for (spla::uint i = 0; i < N; i++) {
+        int actual;
+        v->get_int(i, actual);
+        EXPECT_EQ(actual, expected[i]);
+    }
+}
+
+TEST(vector, snapshot) {
+    const spla::uint N    = 1000;
+    const auto       path = (std::filesystem::temp_directory_path() / "spla_test_vector.snapshot").string();
+
+    auto ivec = spla::Vector::make(N, spla::INT);
+    for (spla::uint i = 0; i < N; i += 3) {
+        ivec->set_int(i, int(i) - 500);
+    }
+
+    EXPECT_EQ(ivec->save_snapshot(path), spla::Status::Ok);
+
+    auto loaded = spla::Vector::load_snapshot(path);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->get_n_rows(), N);
+    EXPECT_EQ(loaded->get_type(), spla::INT);
+
+    for (spla::uint i = 0; i < N; i++) {
+        int actual;
+        loaded->get_int(i, actual);
+        EXPECT_EQ(actual, i % 3 == 0 ? int(i) - 500 : 0);
+    }
+
+    EXPECT_FALSE(spla::Matrix::load_snapshot(path));
+
+    std::filesystem::remove(path);
+}
+
+TEST(vector, snapshot_corrupted) {
+    const spla::uint N    = 100;
+    const auto       path = (std::filesystem::temp_directory_path() / "spla_test_vector_corrupted.snapshot").string();
+
+    auto ivec = spla::Vector::make(N, spla::INT);
+    for (spla::uint i = 0; i < N; i += 3) {
+        ivec->set_int(i, int(i));
+    }
+    EXPECT_EQ(ivec->save_snapshot(path), spla::Status::Ok);
+
+    std::vector<char> bytes(std::filesystem::file_size(path));
+    std::ifstream(path, std::ios::binary).read(bytes.data(), std::streamsize(bytes.size()));
+
+    auto check_fails = [&](const std::vector<char>& data) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(), std::streamsize(data.size()));
+        EXPECT_FALSE(spla::Vector::load_snapshot(path));
+    };
+
+    // layout: 128 bytes header, then Ai array
+    auto truncated = bytes;
+    truncated.resize(bytes.size() - sizeof(int));
+    check_fails(truncated);
+
+    auto bad_index = bytes;
+    const spla::uint index = N;
+    std::memcpy(bad_index.data() + 128, &index, sizeof(index));
+    check_fails(bad_index);
+
+    std::filesystem::remove(path);
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE_PLATFORM(1)
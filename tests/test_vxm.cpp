@@ -28,6 +28,7 @@
 #include "test_common.hpp"
 
 #include <iostream>
+#include <vector>
 #include <spla.hpp>
 
 TEST(vxm_masked, naive) {
@@ -186,4 +187,70 @@ TEST(vxm_masked, perf_and_or) {
     std::cout << std::endl;
 }
 
+TEST(vxm_masked, frontier_sizes) {
+    const spla::uint N = 10000;
+    const spla::uint K = 60;
+
+    auto iM    = spla::Matrix::make(N, N, spla::INT);
+    auto imask = spla::Vector::make(N, spla::INT);
+    auto iinit = spla::Scalar::make_int(0);
+
+    auto value = [](spla::uint i, spla::uint j) { return int((i + 2 * j) % 9) + 1; };
+    auto col   = [](spla::uint i, spla::uint k) { return (i * 7 + k * 53) % N; };
+
+    for (spla::uint i = 0; i < N; i++) {
+        for (spla::uint k = 0; k < K; k++) {
+            iM->set_int(i, col(i, k), value(i, col(i, k)));
+        }
+        imask->set_int(i, int(i % 4 == 0));
+    }
+
+    // small frontier goes through sparse path, large one through bitmap path
+    for (spla::uint frontier : {2u, N / 2}) {
+        auto iv = spla::Vector::make(N, spla::INT);
+
+        std::vector<spla::uint> v_i;
+        for (spla::uint i = 0; i < N && v_i.size() < frontier; i += 2) {
+            v_i.push_back(i);
+            iv->set_int(i, int(i % 5) + 1);
+        }
+
+        std::vector<int>  expected_sum(N, 0);
+        std::vector<int>  expected_first(N, 0);
+        std::vector<bool> touched(N, false);
+
+        for (spla::uint i : v_i) {
+            for (spla::uint k = 0; k < K; k++) {
+                const spla::uint j = col(i, k);
+                const int        x = (int(i % 5) + 1) * value(i, j);
+
+                if (j % 4 != 0) {
+                    expected_sum[j] += x;
+                    if (!touched[j]) expected_first[j] = x;
+                    touched[j] = true;
+                }
+            }
+        }
+
+        for (int threads : {1, 4}) {
+            auto desc = spla::Descriptor::make();
+            desc->set_threads_count(threads);
+
+            auto r_sum   = spla::Vector::make(N, spla::INT);
+            auto r_first = spla::Vector::make(N, spla::INT);
+
+            EXPECT_EQ(spla::exec_vxm_masked(r_sum, imask, iv, iM, spla::MULT_INT, spla::PLUS_INT, spla::EQZERO_INT, iinit, desc), spla::Status::Ok);
+            EXPECT_EQ(spla::exec_vxm_masked(r_first, imask, iv, iM, spla::MULT_INT, spla::FIRST_INT, spla::EQZERO_INT, iinit, desc), spla::Status::Ok);
+
+            for (spla::uint j = 0; j < N; j++) {
+                int x;
+                r_sum->get_int(j, x);
+                EXPECT_EQ(x, expected_sum[j]);
+                r_first->get_int(j, x);
+                EXPECT_EQ(x, expected_first[j]);
+            }
+        }
+    }
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE_PLATFORM(1)
\ No newline at end of file